@@ -89,4 +89,15 @@ Eps_OcpState Power_get_ocp_state_for_op_mode(
  */
 bool Power_low_power_status_check(void);
 
+/**
+ * @brief Handle the firing of the task timer by requesting new EPS HK data.
+ * 
+ * Subscribed to DP.POWER.TASK_TIMER_EVENT once the timer is started, and
+ * called by EventManager_dispatch_events().
+ * 
+ * @param event_in The task timer event.
+ * @return bool Always true.
+ */
+bool Power_task_timer_handler(Event event_in);
+
 #endif /* H_POWER_PRIVATE_H */
\ No newline at end of file
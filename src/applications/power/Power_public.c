@@ -62,8 +62,10 @@ bool Power_step(void) {
      * intended that a CFU will trigger a reset of the OBC, so there's no need
      * to do this any more */
 
-    /* Start the task timer if it hasn't already been started. */
-    if (DP.POWER.TASK_TIMER_EVENT != EVT_NONE) {
+    /* Start the task timer if it hasn't already been started. Its event is
+     * handled by Power_task_timer_handler(), which EventManager calls when
+     * the timer fires, so it isn't polled here. */
+    if (DP.POWER.TASK_TIMER_EVENT == EVT_NONE) {
         error = Timer_start_periodic(
             (double)CFG.POWER_TASK_TIMER_DURATION_S,
             &DP.POWER.TASK_TIMER_EVENT
@@ -76,14 +78,20 @@ bool Power_step(void) {
             DP.POWER.TIMER_ERROR.p_cause = NULL;
             return false;
         }
-    }
 
-    /* Check for firing of the task timer event. */
-    if (EventManager_poll_event(DP.POWER.TASK_TIMER_EVENT)) {
-        /* Raise a new update EPS request. This will mean that if something
-         * else has also requested an EPS update we won't get two requests
-         * coming through in quick succession. */
-        Power_request_eps_hk();
+        /* If the subscription fails stop the timer again, so that both are
+         * retried next step */
+        if (!EventManager_subscribe(
+            DP.POWER.TASK_TIMER_EVENT,
+            Power_task_timer_handler
+        )) {
+            DEBUG_ERR("Couldn't subscribe to Power task timer");
+            DP.POWER.ERROR.code = POWER_ERROR_EVENTMANAGER_ERROR;
+            DP.POWER.ERROR.p_cause = &DP.EVENTMANAGER.ERROR;
+            (void)Timer_disable(DP.POWER.TASK_TIMER_EVENT);
+            DP.POWER.TASK_TIMER_EVENT = EVT_NONE;
+            return false;
+        }
     }
 
     /* Check for the event that signals the EPS has finished a command. This
@@ -414,6 +422,24 @@ bool Power_step(void) {
     return true;
 }
 
+bool Power_is_step_required(void) {
+    /* Must match the events polled in Power_step(). The task timer is
+     * dispatched to Power_task_timer_handler() instead, and the HK request it
+     * makes is sent on the next periodic step. */
+    return EventManager_is_event_raised(EVT_EPS_COMMAND_COMPLETE);
+}
+
+bool Power_task_timer_handler(Event event_in) {
+    (void)event_in;
+
+    /* Raise a new update EPS request. This will mean that if something else
+     * has also requested an EPS update we won't get two requests coming
+     * through in quick succession. */
+    Power_request_eps_hk();
+
+    return true;
+}
+
 void Power_request_eps_hk(void) {
     /* If there's already a request waiting we will issue a warning, but won't
      * do anything */
@@ -103,6 +103,18 @@ bool Power_init(void);
  */
 bool Power_step(void);
 
+/**
+ * @brief Check whether any event the Power app waits on has been raised, in
+ * which case it must be stepped this cycle.
+ * 
+ * This lets the Power app be stepped at a reduced rate without missing its
+ * events. Work which isn't driven by an event, such as sending a command
+ * that is waiting for the EPS to be free, is done on the periodic steps.
+ * 
+ * @return bool True if the Power app must be stepped, false otherwise.
+ */
+bool Power_is_step_required(void);
+
 /**
  * @brief Requests that the Power app update the EPS housekeeping packet
  * outside of the standard task execution.
@@ -75,6 +75,30 @@ static int Power_test_get_ocp_state_for_op_mode(void **state) {
     return 0;
 }
 
+/**
+ * @brief Test that the task timer event is dispatched to the Power app, which
+ * requests new EPS HK data.
+ * 
+ * @param state cmocka state
+ */
+static void Power_test_task_timer_handler(void **state) {
+    (void) state;
+    Event timer_event = (Event)1;
+
+    DP.POWER.UPDATE_EPS_HK = false;
+    assert_true(EventManager_subscribe(timer_event, Power_task_timer_handler));
+
+    /* Nothing happens until the timer fires */
+    EventManager_dispatch_events();
+    assert_false(DP.POWER.UPDATE_EPS_HK);
+
+    /* Firing the timer requests HK and consumes the event */
+    assert_true(EventManager_raise_event(timer_event));
+    EventManager_dispatch_events();
+    assert_true(DP.POWER.UPDATE_EPS_HK);
+    assert_false(EventManager_is_event_raised(timer_event));
+}
+
 /**
  * @brief Setup function for Power tests, which inits Power and required 
  * modules.
@@ -129,5 +153,10 @@ const struct CMUnitTest power_tests[] = {
         Power_test_get_ocp_state_for_op_mode, 
         Power_test_setup,
         Power_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        Power_test_task_timer_handler,
+        Power_test_setup,
+        Power_test_teardown
     )
 };
\ No newline at end of file
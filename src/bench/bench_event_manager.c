@@ -0,0 +1,580 @@
+/**
+ * @ingroup bench
+ *
+ * @file bench_event_manager.c
+ * @author agent (agent@local)
+ * @brief Host benchmark comparing the EventManager against the previous
+ * linear list implementation.
+ *
+ * The previous implementation stored raised events in an unordered list which
+ * was scanned linearly by is_event_raised and poll_event. A copy of that
+ * algorithm is kept here so the two can be timed against each other at
+ * different numbers of raised events.
+ *
+ * A second table times a module polling a set of events every cycle, either
+ * one event at a time or with a single EventManager_poll_set() call, for both
+ * implementations. For the linear list polling one at a time costs one scan
+ * of the list per event, while polling the set costs one scan in total.
+ *
+ * This benchmark should be built without DEBUG_MODE, as otherwise the trace
+ * logging in the EventManager dominates the timings.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) UoS3 2020
+ *
+ * @defgroup bench Bench
+ * @{
+ */
+
+/* -------------------------------------------------------------------------   
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "drivers/board/Board_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+#include "system/event_manager/EventManager_public.h"
+
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of times each workload is repeated.
+ */
+#define BENCH_NUM_REPEATS (200)
+
+/**
+ * @brief Number of workloads.
+ */
+#define BENCH_NUM_WORKLOADS (3)
+
+/**
+ * @brief Minimum size of the legacy lists.
+ */
+#define BENCH_LEGACY_MIN_LIST_SIZE (8)
+
+/**
+ * @brief Maximum size of the legacy lists.
+ */
+#define BENCH_LEGACY_MAX_LIST_SIZE (1024)
+
+/**
+ * @brief Offset added to the index of an event to get an event which is never
+ * raised, used to time failed lookups.
+ */
+#define BENCH_MISS_INDEX_OFFSET (0x200)
+
+/**
+ * @brief Number of cycles timed for each poll set workload.
+ */
+#define BENCH_POLL_SET_NUM_CYCLES (20000)
+
+/**
+ * @brief Number of events polled by the module each cycle in the poll set
+ * workloads.
+ */
+#define BENCH_POLL_SET_SIZE (4)
+
+/**
+ * @brief Number of poll set workloads.
+ */
+#define BENCH_POLL_SET_NUM_WORKLOADS (3)
+
+/* -------------------------------------------------------------------------   
+ * STRUCTS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Copy of the previous linear list EventManager, used as the baseline.
+ */
+typedef struct _BenchLegacyEventManager {
+    Event *p_raised_events;
+    uint8_t *p_num_cycles_events_raised;
+    size_t num_raised_events;
+    size_t list_size;
+} BenchLegacyEventManager;
+
+/**
+ * @brief Accumulated time in ns spent in each operation.
+ */
+typedef struct _BenchTimes {
+    uint64_t raise;
+    uint64_t check_hit;
+    uint64_t check_miss;
+    uint64_t poll;
+} BenchTimes;
+
+/* -------------------------------------------------------------------------   
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of raised events in each workload. The largest workload raises
+ * as many events as the EventManager can hold.
+ */
+static const size_t BENCH_WORKLOADS[BENCH_NUM_WORKLOADS] = {
+    8,
+    64,
+    EVENTMANAGER_MAX_RAISED_EVENTS
+};
+
+/**
+ * @brief Number of other raised events in each poll set workload, which are
+ * never polled by the module and so have to be scanned past.
+ */
+static const size_t BENCH_POLL_SET_WORKLOADS[BENCH_POLL_SET_NUM_WORKLOADS] = {
+    0,
+    8,
+    64
+};
+
+static BenchLegacyEventManager LEGACY;
+
+/* -------------------------------------------------------------------------   
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Get the current monotonic time in ns.
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Get the i-th event of a workload. Events are spread across all
+ * modules the same way real events are, i.e. a few events per module ID.
+ *
+ * @param i The index of the event in the workload.
+ * @param miss_in If true return an event which is never raised.
+ */
+static Event bench_event(size_t i, bool miss_in) {
+    size_t mod_id = (i % 63) + 1;
+    size_t idx = (i / 63) + (miss_in ? BENCH_MISS_INDEX_OFFSET : 0);
+
+    return (Event)((mod_id << KERNEL_MOD_ID_SHIFT) | idx);
+}
+
+static bool legacy_init(void) {
+    LEGACY.p_raised_events = (Event *)malloc(
+        BENCH_LEGACY_MIN_LIST_SIZE * sizeof(Event)
+    );
+    LEGACY.p_num_cycles_events_raised = (uint8_t *)malloc(
+        BENCH_LEGACY_MIN_LIST_SIZE * sizeof(uint8_t)
+    );
+    LEGACY.num_raised_events = 0;
+    LEGACY.list_size = BENCH_LEGACY_MIN_LIST_SIZE;
+
+    return LEGACY.p_raised_events != NULL
+        && LEGACY.p_num_cycles_events_raised != NULL;
+}
+
+static void legacy_destroy(void) {
+    free(LEGACY.p_raised_events);
+    free(LEGACY.p_num_cycles_events_raised);
+}
+
+static bool legacy_resize(size_t new_list_size_in) {
+    Event *p_temp_raised_events = (Event *)realloc(
+        (void *)LEGACY.p_raised_events,
+        new_list_size_in * sizeof(Event)
+    );
+    uint8_t *p_temp_num_cycles_raised = (uint8_t *)realloc(
+        (void *)LEGACY.p_num_cycles_events_raised,
+        new_list_size_in * sizeof(uint8_t)
+    );
+
+    if (p_temp_raised_events == NULL || p_temp_num_cycles_raised == NULL) {
+        return false;
+    }
+
+    LEGACY.p_raised_events = p_temp_raised_events;
+    LEGACY.p_num_cycles_events_raised = p_temp_num_cycles_raised;
+    LEGACY.list_size = new_list_size_in;
+
+    return true;
+}
+
+static bool legacy_raise_event(Event event_in) {
+    if (LEGACY.num_raised_events >= LEGACY.list_size - 1) {
+        size_t new_list_size
+            = LEGACY.list_size * 2;
+
+        if (new_list_size > BENCH_LEGACY_MAX_LIST_SIZE) {
+            return false;
+        }
+        if (!legacy_resize(new_list_size)) {
+            return false;
+        }
+    }
+
+    LEGACY.p_raised_events[LEGACY.num_raised_events] = event_in;
+    LEGACY.p_num_cycles_events_raised[LEGACY.num_raised_events] = 0;
+    LEGACY.num_raised_events++;
+
+    return true;
+}
+
+static bool legacy_is_event_raised(Event event_in) {
+    for (size_t i = 0; i < LEGACY.num_raised_events; ++i) {
+        if (LEGACY.p_raised_events[i] == event_in) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool legacy_poll_event(Event event_in) {
+    size_t event_idx = 0;
+
+    if (!legacy_is_event_raised(event_in)) {
+        return false;
+    }
+
+    /* The original used a uint8_t index here, which can't address more than
+     * 256 events, so a size_t is used to allow larger workloads to run. */
+    for (size_t i = 0; i < LEGACY.num_raised_events; ++i) {
+        if (LEGACY.p_raised_events[i] == event_in) {
+            event_idx = i;
+            break;
+        }
+    }
+
+    for (size_t i = event_idx; i < LEGACY.num_raised_events; ++i) {
+        LEGACY.p_raised_events[i] = LEGACY.p_raised_events[i + 1];
+        LEGACY.p_num_cycles_events_raised[i]
+            = LEGACY.p_num_cycles_events_raised[i + 1];
+    }
+    LEGACY.num_raised_events--;
+
+    /* Shrink the lists */
+    if (LEGACY.num_raised_events * 4 <= LEGACY.list_size) {
+        size_t new_list_size = LEGACY.list_size / 2;
+        if (new_list_size < BENCH_LEGACY_MIN_LIST_SIZE) {
+            new_list_size = BENCH_LEGACY_MIN_LIST_SIZE;
+        }
+        if (new_list_size != LEGACY.list_size) {
+            (void)legacy_resize(new_list_size);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Single pass equivalent of legacy_poll_event() for a set of events,
+ * i.e. what EventManager_poll_set() would have been in the linear list.
+ *
+ * The list is compacted in place as it is scanned, so each set costs one scan
+ * however many events are in it.
+ */
+static uint32_t legacy_poll_set(
+    const Event *p_events_in,
+    size_t num_events_in
+) {
+    uint32_t raised_mask = 0;
+    size_t write_idx = 0;
+    bool matched;
+
+    for (size_t i = 0; i < LEGACY.num_raised_events; ++i) {
+        matched = false;
+
+        /* Each entry of the set only clears one raise, as poll_event does */
+        for (size_t j = 0; j < num_events_in; ++j) {
+            if (LEGACY.p_raised_events[i] == p_events_in[j]
+                &&
+                (raised_mask & ((uint32_t)1 << j)) == 0
+            ) {
+                raised_mask |= ((uint32_t)1 << j);
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched) {
+            LEGACY.p_raised_events[write_idx]
+                = LEGACY.p_raised_events[i];
+            LEGACY.p_num_cycles_events_raised[write_idx]
+                = LEGACY.p_num_cycles_events_raised[i];
+            write_idx++;
+        }
+    }
+    LEGACY.num_raised_events = write_idx;
+
+    return raised_mask;
+}
+
+/**
+ * @brief Run one repeat of a workload against either implementation,
+ * accumulating the time spent in each operation.
+ *
+ * Events are raised in order, checked, and then polled in reverse order,
+ * which is the worst case for the linear list as each polled event is at the
+ * end of the list.
+ *
+ * @param num_events_in Number of events to raise.
+ * @param legacy_in If true time the legacy list, otherwise the EventManager.
+ * @param p_times_inout Times to accumulate into.
+ * @return bool False if any operation gave the wrong result.
+ */
+static bool bench_run_workload(
+    size_t num_events_in,
+    bool legacy_in,
+    BenchTimes *p_times_inout
+) {
+    uint64_t start;
+    bool ok = true;
+
+    /* Raise */
+    start = bench_now_ns();
+    for (size_t i = 0; i < num_events_in; ++i) {
+        ok &= legacy_in
+            ? legacy_raise_event(bench_event(i, false))
+            : EventManager_raise_event(bench_event(i, false));
+    }
+    p_times_inout->raise += bench_now_ns() - start;
+
+    /* Check raised events */
+    start = bench_now_ns();
+    for (size_t i = 0; i < num_events_in; ++i) {
+        ok &= legacy_in
+            ? legacy_is_event_raised(bench_event(i, false))
+            : EventManager_is_event_raised(bench_event(i, false));
+    }
+    p_times_inout->check_hit += bench_now_ns() - start;
+
+    /* Check events which aren't raised */
+    start = bench_now_ns();
+    for (size_t i = 0; i < num_events_in; ++i) {
+        ok &= legacy_in
+            ? !legacy_is_event_raised(bench_event(i, true))
+            : !EventManager_is_event_raised(bench_event(i, true));
+    }
+    p_times_inout->check_miss += bench_now_ns() - start;
+
+    /* Poll all events */
+    start = bench_now_ns();
+    for (size_t i = num_events_in; i > 0; --i) {
+        ok &= legacy_in
+            ? legacy_poll_event(bench_event(i - 1, false))
+            : EventManager_poll_event(bench_event(i - 1, false));
+    }
+    p_times_inout->poll += bench_now_ns() - start;
+
+    return ok;
+}
+
+/**
+ * @brief Time a module polling BENCH_POLL_SET_SIZE events every cycle, while
+ * other events are raised.
+ *
+ * Each cycle the first half of the set is raised and then the whole set is
+ * polled, so that both raised and unraised events are looked up.
+ *
+ * @param num_other_events_in Number of other events to keep raised.
+ * @param legacy_in If true time the legacy list, otherwise the EventManager.
+ * @param use_set_in If true poll the set in one call, otherwise poll the
+ * events one at a time.
+ * @param p_time_ns_out Total time spent polling.
+ * @return bool False if any poll gave the wrong result.
+ */
+static bool bench_run_poll_set_workload(
+    size_t num_other_events_in,
+    bool legacy_in,
+    bool use_set_in,
+    uint64_t *p_time_ns_out
+) {
+    Event set[BENCH_POLL_SET_SIZE];
+    uint32_t expected_mask = 0;
+    uint32_t raised_mask;
+    uint64_t start;
+    bool ok = true;
+
+    /* The set uses events which are never raised as other events */
+    for (size_t i = 0; i < BENCH_POLL_SET_SIZE; ++i) {
+        set[i] = bench_event(i, true);
+        if (i < (BENCH_POLL_SET_SIZE / 2)) {
+            expected_mask |= ((uint32_t)1 << i);
+        }
+    }
+
+    for (size_t i = 0; i < num_other_events_in; ++i) {
+        ok &= legacy_in
+            ? legacy_raise_event(bench_event(i, false))
+            : EventManager_raise_event(bench_event(i, false));
+    }
+
+    *p_time_ns_out = 0;
+    for (size_t c = 0; c < BENCH_POLL_SET_NUM_CYCLES; ++c) {
+        for (size_t i = 0; i < (BENCH_POLL_SET_SIZE / 2); ++i) {
+            ok &= legacy_in
+                ? legacy_raise_event(set[i])
+                : EventManager_raise_event(set[i]);
+        }
+
+        start = bench_now_ns();
+        if (use_set_in) {
+            raised_mask = legacy_in
+                ? legacy_poll_set(set, BENCH_POLL_SET_SIZE)
+                : EventManager_poll_set(set, BENCH_POLL_SET_SIZE);
+        }
+        else {
+            raised_mask = 0;
+            for (size_t i = 0; i < BENCH_POLL_SET_SIZE; ++i) {
+                if (legacy_in
+                    ? legacy_poll_event(set[i])
+                    : EventManager_poll_event(set[i])
+                ) {
+                    raised_mask |= ((uint32_t)1 << i);
+                }
+            }
+        }
+        *p_time_ns_out += bench_now_ns() - start;
+
+        ok &= (raised_mask == expected_mask);
+    }
+
+    /* Clear the other events for the next workload */
+    for (size_t i = num_other_events_in; i > 0; --i) {
+        ok &= legacy_in
+            ? legacy_poll_event(bench_event(i - 1, false))
+            : EventManager_poll_event(bench_event(i - 1, false));
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Print the per-operation time of one implementation for a workload.
+ */
+static void bench_print_times(
+    const char *p_name_in,
+    size_t num_events_in,
+    const BenchTimes *p_times_in
+) {
+    double num_ops = (double)num_events_in * (double)BENCH_NUM_REPEATS;
+
+    printf(
+        "%-14s %8lu %12.1f %12.1f %12.1f %12.1f\n",
+        p_name_in,
+        (unsigned long)num_events_in,
+        (double)p_times_in->raise / num_ops,
+        (double)p_times_in->check_hit / num_ops,
+        (double)p_times_in->check_miss / num_ops,
+        (double)p_times_in->poll / num_ops
+    );
+}
+
+/* -------------------------------------------------------------------------   
+ * MAIN
+ * ------------------------------------------------------------------------- */
+
+int main(void) {
+
+    /* Init system */
+    DataPool_init();
+    Board_init();
+    if (!Debug_init()) {
+        Debug_exit(1);
+    }
+    if (!EventManager_init()) {
+        Debug_exit(1);
+    }
+    if (!legacy_init()) {
+        Debug_exit(1);
+    }
+
+    printf(
+        "%-14s %8s %12s %12s %12s %12s\n",
+        "impl",
+        "events",
+        "raise_ns",
+        "check_hit_ns",
+        "check_miss_ns",
+        "poll_ns"
+    );
+
+    for (size_t w = 0; w < BENCH_NUM_WORKLOADS; ++w) {
+        BenchTimes legacy_times = {0};
+        BenchTimes em_times = {0};
+
+        for (size_t r = 0; r < BENCH_NUM_REPEATS; ++r) {
+            if (!bench_run_workload(BENCH_WORKLOADS[w], true, &legacy_times)
+                ||
+                !bench_run_workload(BENCH_WORKLOADS[w], false, &em_times)
+            ) {
+                DEBUG_ERR(
+                    "Workload of %lu events gave an incorrect result",
+                    (unsigned long)BENCH_WORKLOADS[w]
+                );
+                Debug_exit(1);
+            }
+        }
+
+        bench_print_times("legacy_list", BENCH_WORKLOADS[w], &legacy_times);
+        bench_print_times("event_manager", BENCH_WORKLOADS[w], &em_times);
+    }
+
+    printf(
+        "\n%-14s %8s %8s %12s %12s\n",
+        "impl",
+        "raised",
+        "set_size",
+        "polls_ns",
+        "poll_set_ns"
+    );
+
+    for (size_t w = 0; w < BENCH_POLL_SET_NUM_WORKLOADS; ++w) {
+        for (int legacy = 1; legacy >= 0; --legacy) {
+            uint64_t polls_ns = 0;
+            uint64_t poll_set_ns = 0;
+
+            if (!bench_run_poll_set_workload(
+                    BENCH_POLL_SET_WORKLOADS[w], legacy, false, &polls_ns
+                )
+                ||
+                !bench_run_poll_set_workload(
+                    BENCH_POLL_SET_WORKLOADS[w], legacy, true, &poll_set_ns
+                )
+            ) {
+                DEBUG_ERR(
+                    "Poll set workload of %lu events gave an incorrect result",
+                    (unsigned long)BENCH_POLL_SET_WORKLOADS[w]
+                );
+                Debug_exit(1);
+            }
+
+            /* Times are per cycle, i.e. per poll of the whole set */
+            printf(
+                "%-14s %8lu %8d %12.1f %12.1f\n",
+                legacy ? "legacy_list" : "event_manager",
+                (unsigned long)BENCH_POLL_SET_WORKLOADS[w],
+                BENCH_POLL_SET_SIZE,
+                (double)polls_ns / (double)BENCH_POLL_SET_NUM_CYCLES,
+                (double)poll_set_ns / (double)BENCH_POLL_SET_NUM_CYCLES
+            );
+        }
+    }
+
+    legacy_destroy();
+    EventManager_destroy();
+
+    return 0;
+}
+
+/** @} */ /* End of bench */
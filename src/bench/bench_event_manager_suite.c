@@ -0,0 +1,610 @@
+/**
+ * @ingroup bench
+ *
+ * @file bench_event_manager_suite.c
+ * @author agent (agent@local)
+ * @brief Host microbenchmark suite for the EventManager, with machine
+ * readable output so that results can be compared between commits.
+ *
+ * The suite measures:
+ *  - Throughput of raise, poll, and cleanup at different numbers of raised
+ *    events.
+ *  - The distribution of single raise times while the lists are filled from
+ *    empty to EVENTMANAGER_MAX_RAISED_EVENTS, where the worst case is
+ *    reached as the probe sequences get longer.
+ *  - Complete software cycles replaying a mix of the event traffic of the
+ *    main loop: interrupt events, subscribed events, events polled in the
+ *    same and in the next cycle, events that are never polled, and delayed
+ *    events.
+ *  - The static memory used by the EventManager per event it can hold, and
+ *    per event actually raised by each cycle mix.
+ *
+ * Each result is printed to stdout as a single line JSON object (JSON lines)
+ * of the form:
+ * ```
+ * {"bench": "event_manager", "workload": "raise_fill", "metric": "max_ns", "value": 104.0}
+ * ```
+ * so that two runs can be compared with tool_bench_compare.py.
+ *
+ * Times include the ~20 ns overhead of clock_gettime() for the single
+ * operation measurements. This benchmark should be built without DEBUG_MODE,
+ * as otherwise the trace logging in the EventManager dominates the timings.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) UoS3 2020
+ *
+ * @{
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "drivers/board/Board_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+#include "system/event_manager/EventManager_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Name of the benchmark, printed in every result.
+ */
+#define BENCH_NAME "event_manager"
+
+/**
+ * @brief Number of times each throughput and fill workload is repeated.
+ */
+#define BENCH_NUM_REPEATS (200)
+
+/**
+ * @brief Number of throughput workloads.
+ */
+#define BENCH_NUM_THROUGHPUT_WORKLOADS (3)
+
+/**
+ * @brief Number of cycles run for each cycle mix, after the warm up cycles.
+ */
+#define BENCH_NUM_CYCLES (20000)
+
+/**
+ * @brief Number of cycles run before timing each cycle mix starts, so that
+ * events raised for the next cycle are in the lists.
+ */
+#define BENCH_NUM_WARM_UP_CYCLES (4)
+
+/**
+ * @brief Number of cycle mixes.
+ */
+#define BENCH_NUM_CYCLE_MIXES (3)
+
+/**
+ * @brief Number of distinct events raised from interrupts in the cycle mixes.
+ * The interrupt events are coalesced, like the timer events.
+ */
+#define BENCH_NUM_ISR_EVENTS (4)
+
+/**
+ * @brief Number of events in each group of the cycle mixes. Each group of a
+ * mix uses a distinct range of this many events.
+ */
+#define BENCH_GROUP_SIZE (64)
+
+/**
+ * @brief Percentile reported for the distributions of single operation
+ * times, as well as the maximum.
+ */
+#define BENCH_PERCENTILE (99)
+
+/* -------------------------------------------------------------------------
+ * STRUCTS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The number of events of each type of traffic in one cycle.
+ */
+typedef struct _BenchCycleMix {
+    /**
+     * @brief Name of the mix, printed as the workload.
+     */
+    const char *p_name;
+
+    /**
+     * @brief Number of events raised from interrupt context, spread over
+     * BENCH_NUM_ISR_EVENTS coalesced events which are dispatched to a
+     * subscriber.
+     */
+    size_t num_isr;
+
+    /**
+     * @brief Number of events raised by modules and dispatched to a
+     * subscriber in the next cycle.
+     */
+    size_t num_dispatched;
+
+    /**
+     * @brief Number of events raised and polled in the same cycle, i.e. by a
+     * module stepped after the one that raised them.
+     */
+    size_t num_polled;
+
+    /**
+     * @brief Number of events raised and polled in the next cycle, i.e. by a
+     * module stepped before the one that raised them.
+     */
+    size_t num_polled_next;
+
+    /**
+     * @brief Number of events raised and never polled, which are removed by
+     * cleanup.
+     */
+    size_t num_unpolled;
+
+    /**
+     * @brief Number of events raised with a delay of one cycle and polled
+     * once they are raised.
+     */
+    size_t num_delayed;
+} BenchCycleMix;
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of raised events in each throughput workload. The largest
+ * workload raises as many events as the EventManager can hold.
+ */
+static const size_t BENCH_THROUGHPUT_WORKLOADS[BENCH_NUM_THROUGHPUT_WORKLOADS]
+= {
+    8,
+    64,
+    EVENTMANAGER_MAX_RAISED_EVENTS
+};
+
+/**
+ * @brief The cycle mixes. Nominal is the traffic of a typical cycle, idle a
+ * cycle woken by a single timer interrupt, and burst a cycle in which every
+ * module is busy.
+ */
+static const BenchCycleMix BENCH_CYCLE_MIXES[BENCH_NUM_CYCLE_MIXES] = {
+    {"cycle_idle", 1, 0, 0, 0, 0, 0},
+    {"cycle_nominal", 2, 4, 8, 4, 1, 1},
+    {"cycle_burst", 16, 16, 32, 32, 8, 8}
+};
+
+/**
+ * @brief Time of each single raise in the fill workload, or of each cycle in
+ * the cycle mixes.
+ */
+static uint32_t BENCH_SAMPLES_NS[
+    (BENCH_NUM_REPEATS * EVENTMANAGER_MAX_RAISED_EVENTS) > BENCH_NUM_CYCLES
+    ? (BENCH_NUM_REPEATS * EVENTMANAGER_MAX_RAISED_EVENTS)
+    : BENCH_NUM_CYCLES
+];
+
+/**
+ * @brief Number of calls to bench_handler().
+ */
+static uint32_t BENCH_NUM_HANDLER_CALLS;
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Get the current monotonic time in ns.
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Get the i-th event of a workload. Events are spread across all
+ * modules the same way real events are, i.e. a few events per module ID.
+ *
+ * @param i The index of the event in the workload.
+ */
+static Event bench_event(size_t i) {
+    size_t mod_id = (i % 63) + 1;
+    size_t idx = i / 63;
+
+    return (Event)((mod_id << KERNEL_MOD_ID_SHIFT) | idx);
+}
+
+/**
+ * @brief Get the i-th event of a group of a cycle mix, see BENCH_GROUP_SIZE.
+ */
+static Event bench_group_event(size_t group_in, size_t i) {
+    return bench_event((group_in * BENCH_GROUP_SIZE) + i);
+}
+
+/**
+ * @brief Print a single result as a JSON line.
+ */
+static void bench_report(
+    const char *p_workload_in,
+    const char *p_metric_in,
+    double value_in
+) {
+    printf(
+        "{\"bench\": \"%s\", \"workload\": \"%s\", \"metric\": \"%s\", "
+        "\"value\": %.1f}\n",
+        BENCH_NAME,
+        p_workload_in,
+        p_metric_in,
+        value_in
+    );
+}
+
+/**
+ * @brief Compare function for sorting samples with qsort().
+ */
+static int bench_compare_samples(const void *p_a_in, const void *p_b_in) {
+    uint32_t a = *(const uint32_t *)p_a_in;
+    uint32_t b = *(const uint32_t *)p_b_in;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Sort the first num_samples_in samples and report their mean,
+ * median, BENCH_PERCENTILE percentile, and maximum.
+ */
+static void bench_report_samples(
+    const char *p_workload_in,
+    size_t num_samples_in
+) {
+    uint64_t total = 0;
+
+    qsort(
+        BENCH_SAMPLES_NS,
+        num_samples_in,
+        sizeof(BENCH_SAMPLES_NS[0]),
+        bench_compare_samples
+    );
+
+    for (size_t i = 0; i < num_samples_in; ++i) {
+        total += BENCH_SAMPLES_NS[i];
+    }
+
+    bench_report(
+        p_workload_in,
+        "mean_ns",
+        (double)total / (double)num_samples_in
+    );
+    bench_report(
+        p_workload_in,
+        "p50_ns",
+        (double)BENCH_SAMPLES_NS[num_samples_in / 2]
+    );
+    bench_report(
+        p_workload_in,
+        "p99_ns",
+        (double)BENCH_SAMPLES_NS[
+            (num_samples_in * BENCH_PERCENTILE) / 100
+        ]
+    );
+    bench_report(
+        p_workload_in,
+        "max_ns",
+        (double)BENCH_SAMPLES_NS[num_samples_in - 1]
+    );
+}
+
+/**
+ * @brief Handler subscribed to the interrupt and dispatched events of the
+ * cycle mixes.
+ */
+static bool bench_handler(Event event_in) {
+    (void) event_in;
+    BENCH_NUM_HANDLER_CALLS++;
+    return true;
+}
+
+/**
+ * @brief Measure the throughput of raise, poll, and cleanup with the given
+ * number of raised events.
+ *
+ * @param num_events_in Number of events to raise.
+ * @return bool False if any operation gave the wrong result.
+ */
+static bool bench_run_throughput(size_t num_events_in) {
+    uint64_t raise_ns = 0;
+    uint64_t poll_ns = 0;
+    uint64_t cleanup_ns = 0;
+    uint64_t start;
+    double num_ops = (double)num_events_in * (double)BENCH_NUM_REPEATS;
+    char workload[32];
+    bool ok = true;
+
+    for (size_t r = 0; r < BENCH_NUM_REPEATS; ++r) {
+        /* Raise */
+        start = bench_now_ns();
+        for (size_t i = 0; i < num_events_in; ++i) {
+            ok &= EventManager_raise_event(bench_event(i));
+        }
+        raise_ns += bench_now_ns() - start;
+
+        /* Poll */
+        start = bench_now_ns();
+        for (size_t i = 0; i < num_events_in; ++i) {
+            ok &= EventManager_poll_event(bench_event(i));
+        }
+        poll_ns += bench_now_ns() - start;
+
+        /* Cleanup runs over the whole table once per cycle, so time a single
+         * call with the events raised */
+        for (size_t i = 0; i < num_events_in; ++i) {
+            ok &= EventManager_raise_event(bench_event(i));
+        }
+        start = bench_now_ns();
+        EventManager_cleanup_events();
+        cleanup_ns += bench_now_ns() - start;
+        ok &= EventManager_clear_all_events();
+    }
+
+    snprintf(
+        workload,
+        sizeof(workload),
+        "throughput_%lu",
+        (unsigned long)num_events_in
+    );
+    bench_report(workload, "raise_ns_per_op", (double)raise_ns / num_ops);
+    bench_report(workload, "poll_ns_per_op", (double)poll_ns / num_ops);
+    bench_report(
+        workload,
+        "cleanup_ns_per_call",
+        (double)cleanup_ns / (double)BENCH_NUM_REPEATS
+    );
+
+    return ok;
+}
+
+/**
+ * @brief Measure the time of every single raise while the lists are filled
+ * from empty to EVENTMANAGER_MAX_RAISED_EVENTS.
+ *
+ * The lists are statically allocated so never grow, instead the worst case
+ * raise is when the lists are nearly full and the probe sequences are
+ * longest.
+ *
+ * @return bool False if any raise failed.
+ */
+static bool bench_run_raise_fill(void) {
+    size_t num_samples = 0;
+    uint64_t start;
+    bool ok = true;
+
+    for (size_t r = 0; r < BENCH_NUM_REPEATS; ++r) {
+        for (size_t i = 0; i < EVENTMANAGER_MAX_RAISED_EVENTS; ++i) {
+            start = bench_now_ns();
+            ok &= EventManager_raise_event(bench_event(i));
+            BENCH_SAMPLES_NS[num_samples++]
+                = (uint32_t)(bench_now_ns() - start);
+        }
+        ok &= EventManager_clear_all_events();
+    }
+
+    bench_report_samples("raise_fill", num_samples);
+
+    return ok;
+}
+
+/**
+ * @brief Run one cycle of a cycle mix, in the same order as the main loop.
+ *
+ * @param p_mix_in The mix to run.
+ */
+static void bench_run_cycle(const BenchCycleMix *p_mix_in) {
+    /* Interrupts that fired during the previous cycle */
+    for (size_t i = 0; i < p_mix_in->num_isr; ++i) {
+        (void)EventManager_raise_event_from_isr(
+            EVENTMANAGER_ISR_SOURCE_TIMER,
+            bench_group_event(0, i % BENCH_NUM_ISR_EVENTS)
+        );
+    }
+
+    /* Start of the cycle */
+    EventManager_process_isr_events();
+    EventManager_dispatch_events();
+
+    /* Modules stepped before the producers of their events poll the events
+     * raised last cycle, including the delayed ones */
+    for (size_t i = 0; i < p_mix_in->num_polled_next; ++i) {
+        (void)EventManager_poll_event(bench_group_event(2, i));
+    }
+    for (size_t i = 0; i < p_mix_in->num_delayed; ++i) {
+        (void)EventManager_poll_event(bench_group_event(4, i));
+    }
+
+    /* Producers raise their events */
+    for (size_t i = 0; i < p_mix_in->num_dispatched; ++i) {
+        (void)EventManager_raise_event(bench_group_event(1, i));
+    }
+    for (size_t i = 0; i < p_mix_in->num_polled; ++i) {
+        (void)EventManager_raise_event(bench_group_event(3, i));
+    }
+    for (size_t i = 0; i < p_mix_in->num_polled_next; ++i) {
+        (void)EventManager_raise_event(bench_group_event(2, i));
+    }
+    for (size_t i = 0; i < p_mix_in->num_unpolled; ++i) {
+        (void)EventManager_raise_event(bench_group_event(5, i));
+    }
+    for (size_t i = 0; i < p_mix_in->num_delayed; ++i) {
+        (void)EventManager_raise_event_after_cycles(bench_group_event(4, i), 1);
+    }
+
+    /* Modules stepped after the producers poll this cycle's events */
+    for (size_t i = 0; i < p_mix_in->num_polled; ++i) {
+        (void)EventManager_poll_event(bench_group_event(3, i));
+    }
+
+    /* End of the cycle */
+    EventManager_cleanup_events();
+}
+
+/**
+ * @brief Time the cycles of a cycle mix, and report the memory used per
+ * event raised.
+ *
+ * @param p_mix_in The mix to run.
+ * @return bool False if any error occured in the EventManager.
+ */
+static bool bench_run_cycle_mix(const BenchCycleMix *p_mix_in) {
+    uint64_t start;
+    uint16_t high_water;
+    uint32_t expected_handler_calls;
+
+    /* Start from a fresh EventManager so the high water mark is for this mix
+     * only */
+    EventManager_destroy();
+    if (!EventManager_init()) {
+        return false;
+    }
+    for (size_t i = 0; i < BENCH_NUM_ISR_EVENTS; ++i) {
+        if (!EventManager_enable_coalescing(bench_group_event(0, i))
+            ||
+            !EventManager_subscribe(bench_group_event(0, i), bench_handler)
+        ) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < p_mix_in->num_dispatched; ++i) {
+        if (!EventManager_subscribe(bench_group_event(1, i), bench_handler)) {
+            return false;
+        }
+    }
+
+    BENCH_NUM_HANDLER_CALLS = 0;
+    for (size_t c = 0; c < BENCH_NUM_WARM_UP_CYCLES; ++c) {
+        bench_run_cycle(p_mix_in);
+    }
+
+    for (size_t c = 0; c < BENCH_NUM_CYCLES; ++c) {
+        start = bench_now_ns();
+        bench_run_cycle(p_mix_in);
+        BENCH_SAMPLES_NS[c] = (uint32_t)(bench_now_ns() - start);
+    }
+
+    bench_report_samples(p_mix_in->p_name, BENCH_NUM_CYCLES);
+
+    high_water = DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER;
+    bench_report(p_mix_in->p_name, "raised_high_water", (double)high_water);
+    if (high_water > 0) {
+        bench_report(
+            p_mix_in->p_name,
+            "bytes_per_raised_event",
+            (double)sizeof(EventManager) / (double)high_water
+        );
+    }
+
+    /* Every cycle at least one interrupt event and all of the dispatched
+     * events must have been handled */
+    expected_handler_calls = (uint32_t)(
+        (p_mix_in->num_isr > 0 ? 1 : 0) + p_mix_in->num_dispatched
+    ) * BENCH_NUM_CYCLES;
+
+    return BENCH_NUM_HANDLER_CALLS >= expected_handler_calls
+        && DP.EVENTMANAGER.ERROR.code == ERROR_NONE
+        && DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED == 0;
+}
+
+/**
+ * @brief Report the static memory used by the EventManager.
+ */
+static void bench_report_memory(void) {
+    bench_report("memory", "event_manager_bytes", (double)sizeof(EventManager));
+    bench_report(
+        "memory",
+        "datapool_bytes",
+        (double)sizeof(DP.EVENTMANAGER)
+    );
+    bench_report("memory", "list_size", (double)EVENTMANAGER_LIST_SIZE);
+    bench_report(
+        "memory",
+        "max_raised_events",
+        (double)EVENTMANAGER_MAX_RAISED_EVENTS
+    );
+    bench_report(
+        "memory",
+        "bytes_per_slot",
+        (double)(
+            sizeof(((EventManager *)NULL)->raised_events)
+            + sizeof(((EventManager *)NULL)->num_cycles_events_raised)
+            + sizeof(((EventManager *)NULL)->raise_counts)
+            + sizeof(((EventManager *)NULL)->raise_timestamps)
+        ) / (double)EVENTMANAGER_LIST_SIZE
+    );
+    bench_report(
+        "memory",
+        "bytes_per_max_event",
+        (double)sizeof(EventManager) / (double)EVENTMANAGER_MAX_RAISED_EVENTS
+    );
+}
+
+/* -------------------------------------------------------------------------
+ * MAIN
+ * ------------------------------------------------------------------------- */
+
+int main(void) {
+
+    /* Init system */
+    DataPool_init();
+    Board_init();
+    if (!Debug_init()) {
+        Debug_exit(1);
+    }
+    if (!EventManager_init()) {
+        Debug_exit(1);
+    }
+
+    bench_report_memory();
+
+    for (size_t w = 0; w < BENCH_NUM_THROUGHPUT_WORKLOADS; ++w) {
+        if (!bench_run_throughput(BENCH_THROUGHPUT_WORKLOADS[w])) {
+            DEBUG_ERR(
+                "Throughput workload of %lu events gave an incorrect result",
+                (unsigned long)BENCH_THROUGHPUT_WORKLOADS[w]
+            );
+            Debug_exit(1);
+        }
+    }
+
+    if (!bench_run_raise_fill()) {
+        DEBUG_ERR("Raise fill workload gave an incorrect result");
+        Debug_exit(1);
+    }
+
+    for (size_t m = 0; m < BENCH_NUM_CYCLE_MIXES; ++m) {
+        if (!bench_run_cycle_mix(&BENCH_CYCLE_MIXES[m])) {
+            DEBUG_ERR(
+                "Cycle mix %s failed, error 0x%04X",
+                BENCH_CYCLE_MIXES[m].p_name,
+                DP.EVENTMANAGER.ERROR.code
+            );
+            Debug_exit(1);
+        }
+    }
+
+    EventManager_destroy();
+
+    return 0;
+}
+
+/** @} */ /* End of bench */
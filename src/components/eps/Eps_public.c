@@ -90,6 +90,8 @@ bool Eps_step(void) {
     #ifdef DEBUG_MODE
     char p_hex_str[512] = "";
     #endif
+    Event wait_reply_events[2];
+    uint32_t wait_reply_raised;
 
     /* If we're not initialised warn the user */
     if (!DP.EPS.INITIALISED) {
@@ -241,11 +243,15 @@ bool Eps_step(void) {
              * In addition we check the timeout event here, that way if we
              * timeout we can handle it at this level */
 
-            if (EventManager_poll_event(EVT_UART_EPS_TX_COMPLETE)) {
+            wait_reply_events[0] = EVT_UART_EPS_TX_COMPLETE;
+            wait_reply_events[1] = DP.EPS.TIMEOUT_EVENT;
+            wait_reply_raised = EventManager_poll_set(wait_reply_events, 2);
+
+            if (wait_reply_raised & (1 << 0)) {
                 DEBUG_DBG("TX complete");
             }
             
-            if (EventManager_poll_event(DP.EPS.TIMEOUT_EVENT)) {
+            if (wait_reply_raised & (1 << 1)) {
                 DEBUG_ERR("EPS command timed out");
                 DP.EPS.COMMAND_STATUS = EPS_COMMAND_FAILURE;
                 DP.EPS.ERROR.code = EPS_ERROR_COMMAND_TIMEOUT;
@@ -298,6 +304,39 @@ bool Eps_step(void) {
     return true;
 }
 
+bool Eps_is_step_required(void) {
+    Event wait_reply_events[2];
+
+    if (!DP.EPS.INITIALISED) {
+        return false;
+    }
+
+    /* A new TM or request can arrive in any state */
+    if (EventManager_is_event_raised(EVT_UART_EPS_RX_COMPLETE)
+        ||
+        EventManager_is_event_raised(EVT_EPS_NEW_REQUEST)
+    ) {
+        return true;
+    }
+
+    switch (DP.EPS.STATE) {
+        case EPS_STATE_IDLE:
+            return false;
+        case EPS_STATE_WAIT_REPLY:
+            /* The timeout event is set by the timer, so these must match the
+             * events polled in the WAIT_REPLY state of Eps_step() */
+            wait_reply_events[0] = EVT_UART_EPS_TX_COMPLETE;
+            wait_reply_events[1] = DP.EPS.TIMEOUT_EVENT;
+            return EventManager_is_any_event_raised(wait_reply_events, 2);
+        case EPS_STATE_REQUEST:
+            /* The pending request is sent by the step */
+            return true;
+        default:
+            /* An invalid state, which the step will report */
+            return true;
+    }
+}
+
 bool Eps_send_config(void) {
     uint8_t request_frame[EPS_MAX_UART_FRAME_LENGTH] = {0};
     size_t length_without_crc 
@@ -780,6 +780,17 @@ bool Eps_init(void);
  */
 bool Eps_step(void);
 
+/**
+ * @brief Check whether the EPS has any work to do this cycle. If not there is
+ * no need to call Eps_step().
+ * 
+ * The EPS must be stepped when one of the events it waits on in its current
+ * state is raised, or when it has a request to send.
+ * 
+ * @return bool True if the EPS must be stepped, false otherwise.
+ */
+bool Eps_is_step_required(void);
+
 /**
  * @brief Send the EPS configuration.
  * 
@@ -92,7 +92,7 @@ int main(void) {
     DEBUG_INF("data_size = %ld\n", data_size);
 
     /* Print out some DP names */
-    char *p_symbol;
+    const char *p_symbol;
     if (!DataPool_get_symbol_str(
         (DataPool_Id)0x0001,
         &p_symbol
@@ -101,8 +101,6 @@ int main(void) {
     }
     DEBUG_INF("%s", p_symbol);
 
-    free(p_symbol);
-
     if (!DataPool_get_symbol_str(
         (DataPool_Id)0x0201,
         &p_symbol
@@ -111,8 +109,6 @@ int main(void) {
     }
     DEBUG_INF("%s", p_symbol);
 
-    free(p_symbol);
-
     /* Access an invalid DP id */
     DEBUG_INF("Trying invalid DP ID");
     DataPool_get((DataPool_Id)0x0000, NULL, NULL, NULL);
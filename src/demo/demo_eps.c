@@ -59,6 +59,9 @@ int main(void) {
     /* Main loop */
     while (!exit_loop) {
 
+        /* Raise events queued by interrupts */
+        EventManager_process_isr_events();
+
         /* If initialised build a test ocp command and print it to the screen */
         if (DP.EPS.INITIALISED) {
             ocp_state.radio_rx_camera = true;
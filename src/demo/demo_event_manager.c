@@ -61,8 +61,10 @@ int main(void) {
     /* Print events */
     DEBUG_INF("Events:");
     printf("   [");
-    for (int i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; ++i) {
-        printf("%d ", EVENTMANAGER.p_raised_events[i]);
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; ++i) {
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+            printf("%d ", EVENTMANAGER.raised_events[i]);
+        }
     }
     printf("]\n");
 
@@ -70,7 +72,7 @@ int main(void) {
     DEBUG_INF("List size: %ld", DP.EVENTMANAGER.EVENT_LIST_SIZE);
 
 
-    /* Poll many off the list to verify that the lists will shrink */
+    /* Poll many off the list */
     DEBUG_INF("Polling 30 events");
     for (int event = 1; event < 30; event++) {
         EventManager_poll_event((Event)event);
@@ -79,8 +81,10 @@ int main(void) {
     /* Print events */
     DEBUG_INF("Events:");
     printf("   [");
-    for (int i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; ++i) {
-        printf("%d ", EVENTMANAGER.p_raised_events[i]);
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; ++i) {
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+            printf("%d ", EVENTMANAGER.raised_events[i]);
+        }
     }
     printf("]\n");
 
@@ -99,8 +103,10 @@ int main(void) {
         /* Print events */
         DEBUG_INF("Events:");
         printf("   [");
-        for (int i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; ++i) {
-            printf("%d ", EVENTMANAGER.p_raised_events[i]);
+        for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; ++i) {
+            if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+                printf("%d ", EVENTMANAGER.raised_events[i]);
+            }
         }
         printf("]\n");
 
@@ -108,6 +114,10 @@ int main(void) {
         DEBUG_INF("List size: %ld", DP.EVENTMANAGER.EVENT_LIST_SIZE);
     }
 
+    /* Dump the trace of everything raised and cleaned up above, which can be
+     * decoded with tool_event_trace.py */
+    EventManager_dump_trace();
+
     /* Destroy event manager */
     EventManager_destroy();
 }
@@ -61,10 +61,10 @@ int main(void) {
     DEBUG_INF(
         "| STATE | SUBSTATE | COMMAND | ERROR | EVENTS"
     );
-    #ifdef DEBUG_MODE
-    char *p_table_format = 
-        "|  0x%02X |     0x%02X |    0x%02X |  0x%02X | %s";
-    #endif
+    /* Format of each row of the table, a macro since tokenized logs need the
+     * format to be a literal */
+    #define DEMO_IMU_TABLE_FORMAT \
+        "|  0x%02X |     0x%02X |    0x%02X |  0x%02X | %s"
 
     /* 
      * Demo step is a counter used to:
@@ -237,10 +237,9 @@ int main(void) {
 
         #ifdef DEBUG_MODE
         if (!sleep) {
-            char *p_events = NULL;
-            EventManager_get_event_list_string(&p_events);
-            DEBUG_INF(p_table_format, DP.IMU.STATE, DP.IMU.SUBSTATE, DP.IMU.COMMAND, DP.IMU.ERROR_CODE, p_events);
-            free(p_events);
+            char events[128];
+            EventManager_get_event_list_string(events, sizeof(events));
+            DEBUG_INF(DEMO_IMU_TABLE_FORMAT, DP.IMU.STATE, DP.IMU.SUBSTATE, DP.IMU.COMMAND, DP.IMU.ERROR_CODE, events);
         }
         #endif
 
@@ -97,6 +97,9 @@ int main(void) {
 
     /* Run main loop */
     while (run_loop) {
+        /* Raise the timer events queued by the interrupts */
+        EventManager_process_isr_events();
+
         /* Increment number of 0.25 s events */
         if (EventManager_poll_event(timer_0_25_done)) {
             num_0_25_timers++;
@@ -128,6 +131,17 @@ int main(void) {
         }
 
         EventManager_cleanup_events();
+
+        /* Wait for the next timer, which in virtual time jumps straight to
+         * it */
+        Kernel_disable_interrupts();
+        if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0
+            &&
+            !EventManager_is_isr_event_pending()
+        ) {
+            Kernel_wait_for_interrupt();
+        }
+        Kernel_enable_interrupts();
     }
 
     DEBUG_INF(
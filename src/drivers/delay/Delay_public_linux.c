@@ -21,6 +21,7 @@
 
 /* Internal includes */
 #include "drivers/delay/Delay_public.h"
+#include "drivers/virtual_time/VirtualTime_public.h"
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
@@ -31,6 +32,10 @@ void Delay_ms(uint32_t milliseconds_in) {
 }
 
 void Delay_us(uint32_t microseconds_in) {
+    #ifdef VIRTUAL_TIME
+    /* In virtual time the delay is instant, but still takes up the time */
+    VirtualTime_advance_ns((uint64_t)microseconds_in * 1000ULL);
+    #else
     clock_t start;
     clock_t end;
 
@@ -40,4 +45,5 @@ void Delay_us(uint32_t microseconds_in) {
     
     /* Wait for the delay to end */
     while (clock() < end) {}
+    #endif
 }
\ No newline at end of file
@@ -33,6 +33,7 @@
 #include "drivers/board/Board_public.h"
 #include "drivers/eeprom/Eeprom_public.h"
 #include "drivers/eeprom/Eeprom_private.h"
+#include "drivers/replay/Replay_public.h"
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
@@ -42,6 +43,43 @@ ErrorCode Eeprom_init(void) {
     /* Use stat to check if the file exists */
     struct stat stat_buff;
     bool file_exists = (bool)(stat(EEPROM_DUMMY_FILE_PATH, &stat_buff) == 0);
+    uint8_t contents[EEPROM_SIZE_BYTES];
+    FILE *fp_contents;
+
+    /* The dummy EEPROM left by previous runs is an input to this run, so
+     * record whether it exists and what it holds. When replaying these are
+     * replaced with the recorded ones, which are then put back in the file
+     * so that later reads see them. */
+    memset((void *)contents, 0xff, sizeof(contents));
+    if (file_exists) {
+        fp_contents = fopen(EEPROM_DUMMY_FILE_PATH, "rb");
+        if (fp_contents != NULL) {
+            (void)fread(contents, 1, sizeof(contents), fp_contents);
+            fclose(fp_contents);
+        }
+    }
+    Replay_input(REPLAY_INPUT_EEPROM_PRESENT, &file_exists, sizeof(file_exists));
+    if (file_exists) {
+        Replay_input(REPLAY_INPUT_EEPROM_CONTENTS, contents, sizeof(contents));
+    }
+    if (Replay_is_replaying()) {
+        if (file_exists) {
+            fp_contents = fopen(EEPROM_DUMMY_FILE_PATH, "wb");
+            if (fp_contents == NULL) {
+                DEBUG_ERR("Could not restore recorded EEPROM contents");
+                return EEPROM_ERROR_INIT_RECOVERY_FAILED;
+            }
+            if (fwrite(contents, sizeof(contents), 1, fp_contents) != 1) {
+                DEBUG_ERR("Could not restore recorded EEPROM contents");
+                fclose(fp_contents);
+                return EEPROM_ERROR_INIT_RECOVERY_FAILED;
+            }
+            fclose(fp_contents);
+        }
+        else {
+            (void)remove(EEPROM_DUMMY_FILE_PATH);
+        }
+    }
 
     /* If the file doesn't exist need to create it with the proper init value
      * of 0xff for all bytes, which is what the mass erase leaves the EEPROM at
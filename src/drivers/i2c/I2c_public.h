@@ -60,6 +60,7 @@
 /* Standard library includes */
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Internal includes */
 #include "drivers/i2c/I2c_errors.h"
@@ -133,6 +134,26 @@ ErrorCode I2c_init(void);
  */
 ErrorCode I2c_step(void);
 
+/**
+ * @brief Check whether any action is in progress.
+ * 
+ * Actions in progress poll the I2C peripheral rather than waiting for an
+ * event, so while the driver is busy it must be stepped every cycle and the
+ * system must not be put to sleep.
+ * 
+ * @return bool True if an action is in progress, false otherwise.
+ */
+bool I2c_is_busy(void);
+
+/**
+ * @brief Check whether the driver has any work to do this cycle, i.e. if it is
+ * busy or a new action has been raised. If not there is no need to call
+ * I2c_step().
+ * 
+ * @return bool True if the driver must be stepped, false otherwise.
+ */
+bool I2c_is_step_required(void);
+
 /**
  * @brief Send the given bytes to the I2C device.
  * 
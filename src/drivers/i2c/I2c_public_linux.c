@@ -31,9 +31,11 @@
 
 /* Internal includes */
 #include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
 #include "system/event_manager/EventManager_public.h"
 #include "drivers/i2c/I2c_public.h"
 #include "drivers/i2c/I2c_private.h"
+#include "drivers/replay/Replay_public.h"
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
@@ -54,15 +56,30 @@ ErrorCode I2c_step(void) {
     return ERROR_NONE;
 }
 
+bool I2c_is_busy(void) {
+    /* All actions complete as soon as they are raised */
+    return false;
+}
+
+bool I2c_is_step_required(void) {
+    return false;
+}
+
 ErrorCode I2c_device_send_bytes(
     I2c_Device *p_device_in, 
     uint8_t *p_data_in, 
     size_t length_in
 ) {
     /* Alloc string to print bytes in hex, 2 chars ber pyte, + spaces, + null */
-    char *p_hex_string = (char *)malloc(sizeof(char) * 3 * length_in);
+    char *p_hex_string = (char *)Kernel_malloc(sizeof(char) * 3 * length_in);
     char buf[4] = {0};
 
+    if (p_hex_string == NULL) {
+        DEBUG_ERR("Could not allocate I2C send debug string");
+        return I2C_ERROR_MEMORY_ALLOC_FOR_SEND_FAILED;
+    }
+    p_hex_string[0] = '\0';
+
     /* Print bytes except last into the string */
     for (int i = 0; i < length_in - 1; ++i) {
         sprintf((char *)buf, "%02X ", p_data_in[i]);
@@ -79,7 +96,7 @@ ErrorCode I2c_device_send_bytes(
         p_hex_string
     );
 
-    free(p_hex_string);
+    Kernel_free(p_hex_string);
 
     /* Raise action finished */
     if (!EventManager_raise_event(EVT_I2C_ACTION_FINISHED)) {
@@ -180,6 +197,14 @@ ErrorCode I2c_get_device_recved_bytes(
             /* Close the file */
             fclose(fp_random);
 
+            /* Record the random bytes, or replace them with the recorded
+             * ones */
+            Replay_input(
+                REPLAY_INPUT_I2C_RECV,
+                p_bytes_out,
+                I2C.u_actions[i].burst_recv.length
+            );
+
             break;
         }
     }
@@ -190,7 +215,11 @@ ErrorCode I2c_get_device_recved_bytes(
     }
 
     #if DEBUG_MODE
-    char *p_bytes_string = (char *)malloc(4 * length);
+    char *p_bytes_string = (char *)Kernel_malloc(4 * length);
+    if (p_bytes_string == NULL) {
+        DEBUG_ERR("Could not allocate I2C recv debug string");
+        return I2C_ERROR_MEMORY_ALLOC_FOR_RECV_FAILED;
+    }
     memset(p_bytes_string, 0, 4 * length);
     char buf[4];
     for (int i = 0; i < length; ++i) {
@@ -203,7 +232,7 @@ ErrorCode I2c_get_device_recved_bytes(
         p_device_in->address,
         p_bytes_string
     );
-    free(p_bytes_string);
+    Kernel_free(p_bytes_string);
     #endif
 
     return ERROR_NONE;
@@ -36,6 +36,7 @@
 
 /* Internal includes */
 #include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
 #include "system/event_manager/EventManager_public.h"
 #include "drivers/i2c/I2c_public.h"
 #include "drivers/i2c/I2c_private.h"
@@ -160,6 +161,13 @@ ErrorCode I2c_init(void) {
         p_module->initialised = true;
     }
 
+    /* EVT_I2C_NEW_ACTION only tells I2c_step() that there's work to do, and
+     * all actions are processed on one poll, so coalesce its raises. Failure
+     * just means each raise takes its own slot, so only warn. */
+    if (!EventManager_enable_coalescing(EVT_I2C_NEW_ACTION)) {
+        DEBUG_WRN("Couldn't enable coalescing of EVT_I2C_NEW_ACTION");
+    }
+
     /* Mark the I2C driver as initialised */
     I2C.initialised = true;
 
@@ -181,10 +189,10 @@ ErrorCode I2c_step(void) {
 
     /* Poll for new action event. We actually don't care if this is raised or
      * not since actions can be waiting for interrupts to happen, so we check
-     * need to step their functions each time. The reason the new action event
-     * is raised at all is that a raised event at the end of the cycle will
-     * trigger the next cycle to be run immediately, rather than putting the
-     * system to sleep. */
+     * need to step their functions each time. The new action event wakes the
+     * system and tells the firmware to step the driver (see
+     * I2c_is_step_required()), after which I2c_is_busy() keeps it stepping
+     * until the action is finished. */
     EventManager_poll_event(EVT_I2C_NEW_ACTION);
 
     /* Loop through all actions and run the ones that are not NONE */
@@ -269,6 +277,47 @@ ErrorCode I2c_step(void) {
     return ERROR_NONE;
 }
 
+bool I2c_is_busy(void) {
+    I2c_ActionStatus status;
+
+    for (size_t i = 0; i < I2C_MAX_NUM_ACTIONS; ++i) {
+        /* The status isn't at the same place in each action, so get it based
+         * on the type */
+        switch (I2C.action_types[i]) {
+            case I2C_ACTION_TYPE_SINGLE_SEND:
+                status = I2C.u_actions[i].single_send.status;
+                break;
+            case I2C_ACTION_TYPE_SINGLE_RECV:
+                status = I2C.u_actions[i].single_recv.status;
+                break;
+            case I2C_ACTION_TYPE_BURST_SEND:
+                status = I2C.u_actions[i].burst_send.status;
+                break;
+            case I2C_ACTION_TYPE_BURST_RECV:
+                status = I2C.u_actions[i].burst_recv.status;
+                break;
+            default:
+                status = I2C_ACTION_STATUS_NO_ACTION;
+                break;
+        }
+
+        /* Finished actions are only waiting for the user to clear them */
+        if (status == I2C_ACTION_STATUS_IN_PROGRESS) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool I2c_is_step_required(void) {
+    if (!I2C.initialised) {
+        return false;
+    }
+
+    return I2c_is_busy() || EventManager_is_event_raised(EVT_I2C_NEW_ACTION);
+}
+
 ErrorCode I2c_device_send_bytes(
     I2c_Device *p_device_in,
     uint8_t *p_data_in,
@@ -325,7 +374,7 @@ ErrorCode I2c_device_send_bytes(
 
                 /* Allocate memory for the bytes */
                 I2C.u_actions[i].burst_send.p_bytes 
-                    = (uint8_t *)malloc(length_in);
+                    = (uint8_t *)Kernel_malloc(length_in);
 
                 /* Check that memory allocation was successful */
                 if (I2C.u_actions[i].burst_send.p_bytes == NULL) {
@@ -353,19 +402,21 @@ ErrorCode I2c_device_send_bytes(
 
     #ifdef DEBUG_MODE
     /* Alloc string to print bytes in hex, 2 chars ber pyte, + spaces, + null */
-    char *p_hex_string = (char *)malloc(sizeof(char) * 3 * length_in);
+    char *p_hex_string = (char *)Kernel_malloc(sizeof(char) * 3 * length_in);
     char buf[4] = {0};
 
-    Debug_hex_string(p_data_in, p_hex_string, length_in);
+    if (p_hex_string != NULL) {
+        Debug_hex_string(p_data_in, p_hex_string, length_in);
 
-    DEBUG_DBG(
-        "I2C send (%02X, %02X): %s", 
-        p_device_in->module, 
-        p_device_in->address,
-        p_hex_string
-    );
+        DEBUG_DBG(
+            "I2C send (%02X, %02X): %s", 
+            p_device_in->module, 
+            p_device_in->address,
+            p_hex_string
+        );
 
-    free(p_hex_string);
+        Kernel_free(p_hex_string);
+    }
     #endif
 
     /* If the action was not queued raise an error */
@@ -442,7 +493,7 @@ ErrorCode I2c_device_recv_bytes(
 
                 /* Allocate memory for the bytes */
                 I2C.u_actions[i].burst_recv.p_bytes 
-                    = (uint8_t *)malloc(length_in);
+                    = (uint8_t *)Kernel_malloc(length_in);
 
                 /* Check that memory allocation was successful */
                 if (I2C.u_actions[i].burst_recv.p_bytes == NULL) {
@@ -805,6 +856,15 @@ ErrorCode I2c_clear_device_action(I2c_Device *p_device_in) {
         /* Check the device code */
         if (I2c_devices_equal(p_action_device, p_device_in)) {
 
+            /* Free the bytes of burst actions, which were allocated when the
+             * action was queued */
+            if (type == I2C_ACTION_TYPE_BURST_SEND) {
+                Kernel_free(I2C.u_actions[i].burst_send.p_bytes);
+            }
+            else if (type == I2C_ACTION_TYPE_BURST_RECV) {
+                Kernel_free(I2C.u_actions[i].burst_recv.p_bytes);
+            }
+
             /* Set the data in the action to zero, effectively clearing it */
             memset(
                 &I2C.u_actions[i],
@@ -0,0 +1,204 @@
+/**
+ * @file Replay_public.h
+ * @author agent (agent@local)
+ * @brief Record and replay of the external inputs of the software on linux.
+ *
+ * Timing dependent failures on linux depend on when the timers fire, what the
+ * dummy drivers happen to read, and what was left in the dummy EEPROM. The
+ * Replay module records all of these inputs to a trace file so that a run can
+ * be replayed bit-for-bit, for instance to bisect a regression or to compare
+ * performance using identical inputs.
+ *
+ * The inputs recorded are:
+ *  - events raised by interrupts, such as timer firings, along with the
+ *    cycle they were processed in and their timestamp,
+ *  - reads of the RTC,
+ *  - data received by the UART and I2C dummy drivers,
+ *  - and the contents of the dummy EEPROM when it is initialised.
+ *
+ * Recording is started by setting the UOS3_RECORD environment variable to the
+ * path of the trace file, and replay by setting UOS3_REPLAY, for example:
+ * ```
+ * UOS3_RECORD=run.trace ./obc_firmware.exe
+ * UOS3_REPLAY=run.trace ./obc_firmware.exe
+ * ```
+ * During replay every input is taken from the trace and interrupts are
+ * ignored, with Kernel_wait_for_interrupt() returning straight away. Once the
+ * trace runs out the process exits with 0, and if the software asks for a
+ * different input to the one recorded it has diverged from the recording and
+ * the process exits with 1.
+ *
+ * Inputs read from interrupts are passed through without being recorded, as
+ * they are only seen by the software through the events recorded above, and
+ * interrupt handlers must be bracketed by Replay_enter_isr() and
+ * Replay_exit_isr() to allow this.
+ *
+ * This module only exists on linux.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+#ifndef H_REPLAY_PUBLIC_H
+#define H_REPLAY_PUBLIC_H
+
+#ifndef TARGET_UNIX
+#error "Replay is only available on linux"
+#endif
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Internal includes */
+#include "system/event_manager/EventManager_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Environment variable giving the path of the trace to record to.
+ */
+#define REPLAY_RECORD_ENV_VAR ("UOS3_RECORD")
+
+/**
+ * @brief Environment variable giving the path of the trace to replay.
+ */
+#define REPLAY_REPLAY_ENV_VAR ("UOS3_REPLAY")
+
+/**
+ * @brief Maximum length of the data of a single input.
+ */
+#define REPLAY_MAX_INPUT_LENGTH (4096)
+
+/* -------------------------------------------------------------------------
+ * ENUMS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The types of input recorded in a trace.
+ */
+typedef enum _Replay_InputType {
+    REPLAY_INPUT_ISR_EVENT = 1,
+    REPLAY_INPUT_RTC = 2,
+    REPLAY_INPUT_UART_RECV = 3,
+    REPLAY_INPUT_I2C_RECV = 4,
+    REPLAY_INPUT_EEPROM_PRESENT = 5,
+    REPLAY_INPUT_EEPROM_CONTENTS = 6
+} Replay_InputType;
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Start recording inputs to the given trace file, replacing it if it
+ * exists.
+ *
+ * Called automatically if UOS3_RECORD is set.
+ *
+ * @param p_path_in Path of the trace file.
+ * @return bool True on success, false if the file couldn't be opened.
+ */
+bool Replay_start_recording(const char *p_path_in);
+
+/**
+ * @brief Start replaying inputs from the given trace file.
+ *
+ * Called automatically if UOS3_REPLAY is set.
+ *
+ * @param p_path_in Path of the trace file.
+ * @return bool True on success, false if the file couldn't be opened or
+ * isn't a trace.
+ */
+bool Replay_start_replaying(const char *p_path_in);
+
+/**
+ * @brief Stop recording or replaying, closing the trace file.
+ */
+void Replay_stop(void);
+
+/**
+ * @brief Check whether inputs are being replayed.
+ *
+ * @return bool True if replaying.
+ */
+bool Replay_is_replaying(void);
+
+/**
+ * @brief Check whether inputs are being recorded.
+ *
+ * @return bool True if recording.
+ */
+bool Replay_is_recording(void);
+
+/**
+ * @brief Mark the start of a main loop cycle.
+ *
+ * Called by EventManager_process_isr_events(). During replay the process
+ * exits if the trace has run out.
+ */
+void Replay_start_cycle(void);
+
+/**
+ * @brief Record an input, or replace it with the recorded one when replaying.
+ *
+ * Called by drivers after reading an input from the host. Does nothing if
+ * neither recording nor replaying, or if called from an interrupt.
+ *
+ * @param type_in The type of the input.
+ * @param p_data_inout The input, which is overwritten during replay.
+ * @param length_in The length of the input in bytes, at most
+ * REPLAY_MAX_INPUT_LENGTH.
+ */
+void Replay_input(
+    Replay_InputType type_in,
+    void *p_data_inout,
+    size_t length_in
+);
+
+/**
+ * @brief Record an event raised by an interrupt, which is processed this
+ * cycle.
+ *
+ * @param event_in The event.
+ * @param timestamp_in The time at which the interrupt raised the event.
+ * @return bool True if the event should be raised, false if it should be
+ * dropped because the recorded events are being replayed instead.
+ */
+bool Replay_isr_event(Event event_in, uint32_t timestamp_in);
+
+/**
+ * @brief Get the next recorded event raised by an interrupt this cycle.
+ *
+ * @param p_event_out The event.
+ * @param p_timestamp_out The time at which the interrupt raised the event.
+ * @return bool True if an event was replayed, false if there are no more this
+ * cycle or not replaying.
+ */
+bool Replay_get_isr_event(Event *p_event_out, uint32_t *p_timestamp_out);
+
+/**
+ * @brief Mark the start of an interrupt handler, inputs read by which aren't
+ * recorded.
+ *
+ * Must be async-signal safe.
+ */
+void Replay_enter_isr(void);
+
+/**
+ * @brief Mark the end of an interrupt handler.
+ *
+ * Must be async-signal safe.
+ */
+void Replay_exit_isr(void);
+
+#endif /* H_REPLAY_PUBLIC_H */
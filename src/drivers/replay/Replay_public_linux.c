@@ -0,0 +1,491 @@
+/**
+ * @file Replay_public_linux.c
+ * @author agent (agent@local)
+ * @brief Linux implementation of input record and replay.
+ *
+ * See Replay_public.h for more information.
+ *
+ * The trace file starts with REPLAY_TRACE_MAGIC, followed by one record per
+ * input. Each record is a Replay_RecordHeader followed by the input data.
+ * Records are written in the byte order of the host, so traces can only be
+ * replayed on the same kind of machine they were recorded on.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "drivers/replay/Replay_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Magic number at the start of every trace file, which includes the
+ * version of the trace format.
+ */
+#define REPLAY_TRACE_MAGIC ("UOS3RPL1")
+
+/**
+ * @brief Length of REPLAY_TRACE_MAGIC, excluding the null terminator.
+ */
+#define REPLAY_TRACE_MAGIC_LENGTH (8)
+
+/**
+ * @brief Length of the data of a REPLAY_INPUT_ISR_EVENT record, which is the
+ * Event followed by its uint32_t timestamp.
+ */
+#define REPLAY_ISR_EVENT_LENGTH (sizeof(Event) + sizeof(uint32_t))
+
+/* -------------------------------------------------------------------------
+ * ENUMS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Modes of the Replay module.
+ */
+typedef enum _Replay_Mode {
+    REPLAY_MODE_UNINITIALISED,
+    REPLAY_MODE_OFF,
+    REPLAY_MODE_RECORDING,
+    REPLAY_MODE_REPLAYING
+} Replay_Mode;
+
+/* -------------------------------------------------------------------------
+ * STRUCTS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Header of each record in a trace file.
+ */
+typedef struct _Replay_RecordHeader {
+    /**
+     * @brief The cycle in which the input was read, where cycle 0 is before
+     * the main loop starts.
+     */
+    uint32_t cycle;
+
+    /**
+     * @brief The Replay_InputType of the input.
+     */
+    uint16_t type;
+
+    /**
+     * @brief The length of the data following the header in bytes.
+     */
+    uint16_t length;
+} Replay_RecordHeader;
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Current mode, which is set from the environment on first use.
+ */
+static Replay_Mode REPLAY_MODE = REPLAY_MODE_UNINITIALISED;
+
+/**
+ * @brief The trace file being recorded or replayed.
+ */
+static FILE *REPLAY_P_FILE = NULL;
+
+/**
+ * @brief The current cycle, incremented by Replay_start_cycle().
+ */
+static uint32_t REPLAY_CYCLE = 0;
+
+/**
+ * @brief Whether records have been written since the trace was last flushed.
+ */
+static bool REPLAY_UNFLUSHED = false;
+
+/**
+ * @brief Depth of nested interrupt handlers, inputs aren't recorded while
+ * this is non-zero.
+ */
+static volatile sig_atomic_t REPLAY_ISR_DEPTH = 0;
+
+/**
+ * @brief Whether REPLAY_NEXT_HEADER and REPLAY_NEXT_DATA hold the next record
+ * of the trace being replayed, false once the trace has run out.
+ */
+static bool REPLAY_NEXT_VALID = false;
+
+/**
+ * @brief Header of the next record of the trace being replayed.
+ */
+static Replay_RecordHeader REPLAY_NEXT_HEADER;
+
+/**
+ * @brief Data of the next record of the trace being replayed.
+ */
+static uint8_t REPLAY_NEXT_DATA[REPLAY_MAX_INPUT_LENGTH];
+
+/* -------------------------------------------------------------------------
+ * FUNCTION PROTOTYPES
+ * ------------------------------------------------------------------------- */
+
+/* Putting these prototypes here avoids a private header for a linux-only
+ * module. */
+
+void Replay_init_from_env(void);
+
+void Replay_read_next(void);
+
+void Replay_write(
+    Replay_InputType type_in,
+    const void *p_data_in,
+    size_t length_in
+);
+
+void Replay_take(
+    Replay_InputType type_in,
+    void *p_data_out,
+    size_t length_in
+);
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+bool Replay_start_recording(const char *p_path_in) {
+    Replay_stop();
+
+    REPLAY_P_FILE = fopen(p_path_in, "wb");
+    if (REPLAY_P_FILE == NULL) {
+        DEBUG_ERR("Couldn't create trace file %s", p_path_in);
+        return false;
+    }
+
+    if (fwrite(REPLAY_TRACE_MAGIC, REPLAY_TRACE_MAGIC_LENGTH, 1, REPLAY_P_FILE)
+        != 1
+    ) {
+        DEBUG_ERR("Couldn't write to trace file %s", p_path_in);
+        Replay_stop();
+        return false;
+    }
+
+    REPLAY_CYCLE = 0;
+    REPLAY_UNFLUSHED = true;
+    REPLAY_MODE = REPLAY_MODE_RECORDING;
+
+    DEBUG_INF("Recording inputs to %s", p_path_in);
+
+    return true;
+}
+
+bool Replay_start_replaying(const char *p_path_in) {
+    char magic[REPLAY_TRACE_MAGIC_LENGTH];
+
+    Replay_stop();
+
+    REPLAY_P_FILE = fopen(p_path_in, "rb");
+    if (REPLAY_P_FILE == NULL) {
+        DEBUG_ERR("Couldn't open trace file %s", p_path_in);
+        return false;
+    }
+
+    if (fread(magic, sizeof(magic), 1, REPLAY_P_FILE) != 1
+        ||
+        memcmp(magic, REPLAY_TRACE_MAGIC, sizeof(magic)) != 0
+    ) {
+        DEBUG_ERR("%s isn't a trace file", p_path_in);
+        Replay_stop();
+        return false;
+    }
+
+    REPLAY_CYCLE = 0;
+    REPLAY_MODE = REPLAY_MODE_REPLAYING;
+    Replay_read_next();
+
+    DEBUG_INF("Replaying inputs from %s", p_path_in);
+
+    return true;
+}
+
+void Replay_stop(void) {
+    if (REPLAY_P_FILE != NULL) {
+        fclose(REPLAY_P_FILE);
+        REPLAY_P_FILE = NULL;
+    }
+
+    REPLAY_NEXT_VALID = false;
+    REPLAY_UNFLUSHED = false;
+    REPLAY_MODE = REPLAY_MODE_OFF;
+}
+
+bool Replay_is_replaying(void) {
+    Replay_init_from_env();
+
+    return REPLAY_MODE == REPLAY_MODE_REPLAYING;
+}
+
+bool Replay_is_recording(void) {
+    Replay_init_from_env();
+
+    return REPLAY_MODE == REPLAY_MODE_RECORDING;
+}
+
+void Replay_start_cycle(void) {
+    Replay_init_from_env();
+
+    switch (REPLAY_MODE) {
+        case REPLAY_MODE_RECORDING:
+            /* Flush once per cycle rather than per record, so that the trace
+             * is complete up to the last cycle if the process is killed */
+            if (REPLAY_UNFLUSHED) {
+                fflush(REPLAY_P_FILE);
+                REPLAY_UNFLUSHED = false;
+            }
+            REPLAY_CYCLE++;
+            break;
+        case REPLAY_MODE_REPLAYING:
+            /* Any input left over from the last cycle wasn't asked for */
+            if (REPLAY_NEXT_VALID && REPLAY_NEXT_HEADER.cycle <= REPLAY_CYCLE) {
+                DEBUG_ERR(
+                    "Replay diverged in cycle %lu, input type %u wasn't read",
+                    (unsigned long)REPLAY_CYCLE,
+                    (unsigned int)REPLAY_NEXT_HEADER.type
+                );
+                Debug_exit(1);
+            }
+
+            REPLAY_CYCLE++;
+
+            if (!REPLAY_NEXT_VALID) {
+                DEBUG_INF(
+                    "Replay complete after %lu cycles",
+                    (unsigned long)(REPLAY_CYCLE - 1)
+                );
+                Replay_stop();
+                Debug_exit(0);
+            }
+            break;
+        case REPLAY_MODE_UNINITIALISED:
+        case REPLAY_MODE_OFF:
+        default:
+            break;
+    }
+}
+
+void Replay_input(
+    Replay_InputType type_in,
+    void *p_data_inout,
+    size_t length_in
+) {
+    Replay_init_from_env();
+
+    /* Inputs read by interrupts are only seen through their events */
+    if (REPLAY_ISR_DEPTH != 0) {
+        return;
+    }
+
+    if (REPLAY_MODE == REPLAY_MODE_RECORDING) {
+        Replay_write(type_in, p_data_inout, length_in);
+    }
+    else if (REPLAY_MODE == REPLAY_MODE_REPLAYING) {
+        Replay_take(type_in, p_data_inout, length_in);
+    }
+}
+
+bool Replay_isr_event(Event event_in, uint32_t timestamp_in) {
+    uint8_t data[REPLAY_ISR_EVENT_LENGTH];
+
+    Replay_init_from_env();
+
+    if (REPLAY_MODE == REPLAY_MODE_REPLAYING) {
+        return false;
+    }
+
+    if (REPLAY_MODE == REPLAY_MODE_RECORDING) {
+        memcpy(&data[0], &event_in, sizeof(Event));
+        memcpy(&data[sizeof(Event)], &timestamp_in, sizeof(uint32_t));
+        Replay_write(REPLAY_INPUT_ISR_EVENT, data, sizeof(data));
+    }
+
+    return true;
+}
+
+bool Replay_get_isr_event(Event *p_event_out, uint32_t *p_timestamp_out) {
+    uint8_t data[REPLAY_ISR_EVENT_LENGTH];
+
+    Replay_init_from_env();
+
+    if (REPLAY_MODE != REPLAY_MODE_REPLAYING
+        ||
+        !REPLAY_NEXT_VALID
+        ||
+        REPLAY_NEXT_HEADER.cycle != REPLAY_CYCLE
+        ||
+        REPLAY_NEXT_HEADER.type != (uint16_t)REPLAY_INPUT_ISR_EVENT
+    ) {
+        return false;
+    }
+
+    Replay_take(REPLAY_INPUT_ISR_EVENT, data, sizeof(data));
+    memcpy(p_event_out, &data[0], sizeof(Event));
+    memcpy(p_timestamp_out, &data[sizeof(Event)], sizeof(uint32_t));
+
+    return true;
+}
+
+void Replay_enter_isr(void) {
+    REPLAY_ISR_DEPTH++;
+}
+
+void Replay_exit_isr(void) {
+    REPLAY_ISR_DEPTH--;
+}
+
+/**
+ * @brief Start recording or replaying if the environment asks for it, the
+ * first time the module is used.
+ */
+void Replay_init_from_env(void) {
+    const char *p_path;
+
+    if (REPLAY_MODE != REPLAY_MODE_UNINITIALISED) {
+        return;
+    }
+
+    REPLAY_MODE = REPLAY_MODE_OFF;
+
+    /* Replaying takes priority, so that a replay can't overwrite the trace
+     * if both are set */
+    p_path = getenv(REPLAY_REPLAY_ENV_VAR);
+    if (p_path != NULL) {
+        if (!Replay_start_replaying(p_path)) {
+            Debug_exit(1);
+        }
+        return;
+    }
+
+    p_path = getenv(REPLAY_RECORD_ENV_VAR);
+    if (p_path != NULL) {
+        if (!Replay_start_recording(p_path)) {
+            Debug_exit(1);
+        }
+    }
+}
+
+/**
+ * @brief Read the next record of the trace being replayed into
+ * REPLAY_NEXT_HEADER and REPLAY_NEXT_DATA.
+ */
+void Replay_read_next(void) {
+    REPLAY_NEXT_VALID = false;
+
+    if (fread(&REPLAY_NEXT_HEADER, sizeof(REPLAY_NEXT_HEADER), 1, REPLAY_P_FILE)
+        != 1
+    ) {
+        return;
+    }
+
+    /* A record cut short by the recording being killed ends the trace */
+    if (REPLAY_NEXT_HEADER.length > REPLAY_MAX_INPUT_LENGTH
+        ||
+        (REPLAY_NEXT_HEADER.length != 0
+            &&
+            fread(REPLAY_NEXT_DATA, REPLAY_NEXT_HEADER.length, 1, REPLAY_P_FILE)
+            != 1
+        )
+    ) {
+        return;
+    }
+
+    REPLAY_NEXT_VALID = true;
+}
+
+/**
+ * @brief Write a record of an input to the trace being recorded.
+ */
+void Replay_write(
+    Replay_InputType type_in,
+    const void *p_data_in,
+    size_t length_in
+) {
+    Replay_RecordHeader header;
+
+    if (length_in > REPLAY_MAX_INPUT_LENGTH) {
+        DEBUG_ERR(
+            "Input type %u of %lu bytes is too long to record",
+            (unsigned int)type_in,
+            (unsigned long)length_in
+        );
+        Debug_exit(1);
+    }
+
+    header.cycle = REPLAY_CYCLE;
+    header.type = (uint16_t)type_in;
+    header.length = (uint16_t)length_in;
+
+    if (fwrite(&header, sizeof(header), 1, REPLAY_P_FILE) != 1
+        ||
+        (length_in != 0 && fwrite(p_data_in, length_in, 1, REPLAY_P_FILE) != 1)
+    ) {
+        DEBUG_ERR("Couldn't write to trace file, stopping recording");
+        Replay_stop();
+        return;
+    }
+
+    REPLAY_UNFLUSHED = true;
+}
+
+/**
+ * @brief Take the next record from the trace being replayed, exiting if it
+ * isn't the input the software asked for.
+ */
+void Replay_take(
+    Replay_InputType type_in,
+    void *p_data_out,
+    size_t length_in
+) {
+    /* The software must ask for exactly the input that was recorded next */
+    if (!REPLAY_NEXT_VALID
+        ||
+        REPLAY_NEXT_HEADER.cycle != REPLAY_CYCLE
+        ||
+        REPLAY_NEXT_HEADER.type != (uint16_t)type_in
+        ||
+        REPLAY_NEXT_HEADER.length != length_in
+    ) {
+        DEBUG_ERR(
+            "Replay diverged in cycle %lu, read input type %u of %lu bytes",
+            (unsigned long)REPLAY_CYCLE,
+            (unsigned int)type_in,
+            (unsigned long)length_in
+        );
+        if (REPLAY_NEXT_VALID) {
+            DEBUG_ERR(
+                "    but the trace has type %u of %u bytes in cycle %lu",
+                (unsigned int)REPLAY_NEXT_HEADER.type,
+                (unsigned int)REPLAY_NEXT_HEADER.length,
+                (unsigned long)REPLAY_NEXT_HEADER.cycle
+            );
+        }
+        else {
+            DEBUG_ERR("    but the trace has run out");
+        }
+        Debug_exit(1);
+    }
+
+    memcpy(p_data_out, REPLAY_NEXT_DATA, length_in);
+    Replay_read_next();
+}
@@ -0,0 +1,249 @@
+/**
+ * @file Replay_test.c
+ * @author agent (agent@local)
+ * @brief Tests for input record and replay.
+ *
+ * Each test records a trace and then replays it, stopping before the trace
+ * runs out as that would exit the process.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+
+/* External library includes */
+#include <cmocka.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "drivers/replay/Replay_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Path of the trace written by the tests.
+ */
+#define REPLAY_TEST_TRACE_PATH ("replay_test.trace")
+
+/**
+ * @brief Cycle time budget used by the overrun test, which the test cycle
+ * always exceeds.
+ */
+#define REPLAY_TEST_CYCLE_BUDGET_US (1)
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Run a main loop cycle which overruns REPLAY_TEST_CYCLE_BUDGET_US.
+ */
+static void Replay_test_overrunning_cycle(void) {
+    uint32_t start;
+
+    Kernel_start_cycle_profile();
+
+    /* Spin until the cycle is well over budget */
+    start = Kernel_start_step_profile();
+    while (Kernel_get_elapsed_ns(start)
+        < (10UL * 1000UL * REPLAY_TEST_CYCLE_BUDGET_US)
+    ) {
+    }
+
+    Kernel_end_cycle_profile();
+}
+
+/* -------------------------------------------------------------------------
+ * TESTS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Test inputs and interrupt events are replayed in the cycle they were
+ * recorded in
+ *
+ * @param state cmocka state
+ */
+static void Replay_test_record_and_replay(void **state) {
+    (void) state;
+    uint64_t rtc;
+    uint8_t uart[4] = {0x01, 0x02, 0x03, 0x04};
+    Event event;
+    uint32_t timestamp;
+
+    /* Record an RTC read and an event in cycle 1, and a UART read in cycle 2 */
+    assert_true(Replay_start_recording(REPLAY_TEST_TRACE_PATH));
+    Replay_start_cycle();
+    rtc = 1234;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_true(Replay_isr_event((Event)0x1001, 5678));
+    Replay_start_cycle();
+    Replay_input(REPLAY_INPUT_UART_RECV, uart, sizeof(uart));
+    Replay_stop();
+    assert_false(Replay_is_replaying());
+
+    assert_true(Replay_start_replaying(REPLAY_TEST_TRACE_PATH));
+    assert_true(Replay_is_replaying());
+
+    /* The recorded inputs replace whatever is read now */
+    Replay_start_cycle();
+    rtc = 0;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_int_equal(rtc, 1234);
+
+    /* Events from interrupts are dropped in favour of the recorded ones */
+    assert_false(Replay_isr_event((Event)0x2002, 1));
+    assert_true(Replay_get_isr_event(&event, &timestamp));
+    assert_int_equal(event, 0x1001);
+    assert_int_equal(timestamp, 5678);
+    assert_false(Replay_get_isr_event(&event, &timestamp));
+
+    Replay_start_cycle();
+    memset(uart, 0, sizeof(uart));
+    Replay_input(REPLAY_INPUT_UART_RECV, uart, sizeof(uart));
+    assert_int_equal(uart[0], 0x01);
+    assert_int_equal(uart[3], 0x04);
+
+    Replay_stop();
+    remove(REPLAY_TEST_TRACE_PATH);
+}
+
+/**
+ * @brief Test inputs read by interrupts aren't recorded
+ *
+ * @param state cmocka state
+ */
+static void Replay_test_isr_inputs(void **state) {
+    (void) state;
+    uint64_t rtc;
+    Event event;
+    uint32_t timestamp;
+
+    assert_true(Replay_start_recording(REPLAY_TEST_TRACE_PATH));
+    Replay_start_cycle();
+    Replay_enter_isr();
+    rtc = 1;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    Replay_exit_isr();
+    rtc = 2;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    Replay_stop();
+
+    /* Only the read made outside the interrupt is in the trace */
+    assert_true(Replay_start_replaying(REPLAY_TEST_TRACE_PATH));
+    Replay_start_cycle();
+    assert_false(Replay_get_isr_event(&event, &timestamp));
+    Replay_enter_isr();
+    rtc = 3;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_int_equal(rtc, 3);
+    Replay_exit_isr();
+    rtc = 0;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_int_equal(rtc, 2);
+
+    Replay_stop();
+    remove(REPLAY_TEST_TRACE_PATH);
+}
+
+/**
+ * @brief Test inputs pass through when not recording or replaying
+ *
+ * @param state cmocka state
+ */
+static void Replay_test_off(void **state) {
+    (void) state;
+    uint64_t rtc = 1234;
+    FILE *fp;
+
+    Replay_stop();
+    Replay_start_cycle();
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_int_equal(rtc, 1234);
+    assert_true(Replay_isr_event((Event)0x1001, 0));
+    assert_false(Replay_is_replaying());
+
+    /* Something which isn't a trace can't be replayed */
+    fp = fopen(REPLAY_TEST_TRACE_PATH, "wb");
+    assert_non_null(fp);
+    fputs("not a trace", fp);
+    fclose(fp);
+    assert_false(Replay_start_replaying(REPLAY_TEST_TRACE_PATH));
+    assert_false(Replay_is_replaying());
+    remove(REPLAY_TEST_TRACE_PATH);
+}
+
+/**
+ * @brief Test a cycle overrunning its budget isn't detected while recording
+ * or replaying, as that would depend on the speed of the host
+ *
+ * @param state cmocka state
+ */
+static void Replay_test_cycle_overrun(void **state) {
+    (void) state;
+    uint32_t budget_us = DP.KERNEL.CYCLE_BUDGET_US;
+    uint32_t num_overruns = DP.KERNEL.NUM_CYCLE_OVERRUNS;
+    uint64_t rtc;
+
+    Kernel_set_cycle_budget(REPLAY_TEST_CYCLE_BUDGET_US);
+
+    /* Record an overrunning cycle followed by an RTC read, which would be out
+     * of step in the replay if the overrun had read the RTC */
+    assert_true(Replay_start_recording(REPLAY_TEST_TRACE_PATH));
+    Replay_start_cycle();
+    Replay_test_overrunning_cycle();
+    rtc = 1234;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    Replay_start_cycle();
+    Replay_stop();
+    assert_int_equal(DP.KERNEL.NUM_CYCLE_OVERRUNS, num_overruns);
+
+    assert_true(Replay_start_replaying(REPLAY_TEST_TRACE_PATH));
+    Replay_start_cycle();
+    Replay_test_overrunning_cycle();
+    rtc = 0;
+    Replay_input(REPLAY_INPUT_RTC, &rtc, sizeof(rtc));
+    assert_int_equal(rtc, 1234);
+    assert_int_equal(DP.KERNEL.NUM_CYCLE_OVERRUNS, num_overruns);
+
+    Replay_stop();
+    remove(REPLAY_TEST_TRACE_PATH);
+    Kernel_set_cycle_budget(budget_us);
+}
+
+/* -------------------------------------------------------------------------
+ * TEST GROUP
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Tests to run for the Replay module.
+ */
+const struct CMUnitTest replay_tests[] = {
+    cmocka_unit_test(
+        Replay_test_record_and_replay
+    ),
+    cmocka_unit_test(
+        Replay_test_isr_inputs
+    ),
+    cmocka_unit_test(
+        Replay_test_off
+    ),
+    cmocka_unit_test(
+        Replay_test_cycle_overrun
+    )
+};
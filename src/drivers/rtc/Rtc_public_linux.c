@@ -25,6 +25,8 @@
 #include "util/debug/Debug_public.h"
 #include "system/data_pool/DataPool_public.h"
 #include "drivers/delay/Delay_public.h"
+#include "drivers/virtual_time/VirtualTime_public.h"
+#include "drivers/replay/Replay_public.h"
 #include "drivers/rtc/Rtc_public.h"
 #include "drivers/rtc/Rtc_private.h"
 
@@ -42,7 +44,7 @@ ErrorCode Rtc_init(void) {
     int res;
 
     /* All we have to do is get the current time and set it in the epoch. */
-    res = clock_gettime(CLOCK_REALTIME, &RTC_EPOCH_TIMESPEC);
+    res = VirtualTime_clock_gettime(CLOCK_REALTIME, &RTC_EPOCH_TIMESPEC);
 
     /* Check for error */
     if (res < 0) {
@@ -64,9 +66,10 @@ Rtc_Timestamp Rtc_get_timestamp(void) {
     int res;
     struct timespec current;
     uint64_t nanosecs;
+    Rtc_Timestamp timestamp;
 
     /* All we have to do is get the current time and set it in the epoch. */
-    res = clock_gettime(CLOCK_REALTIME, &current);
+    res = VirtualTime_clock_gettime(CLOCK_REALTIME, &current);
 
     /* Check for error */
     if (res < 0) {
@@ -84,14 +87,19 @@ Rtc_Timestamp Rtc_get_timestamp(void) {
     );
 
     /* Convert the nanoseconds into a number of subseconds */
-    return nanosecs / (1000000000 / RTC_SEC_TO_SUBSEC);
+    timestamp = nanosecs / (1000000000 / RTC_SEC_TO_SUBSEC);
+
+    /* Record the time, or replace it with the recorded one */
+    Replay_input(REPLAY_INPUT_RTC, &timestamp, sizeof(timestamp));
+
+    return timestamp;
 }
 
 void Rtc_set_seconds(uint32_t seconds_in) {
     int res;
 
     /* All we have to do is get the current time and set it in the epoch. */
-    res = clock_gettime(CLOCK_REALTIME, &RTC_EPOCH_TIMESPEC);
+    res = VirtualTime_clock_gettime(CLOCK_REALTIME, &RTC_EPOCH_TIMESPEC);
 
     /* Check for error */
     if (res < 0) {
@@ -25,7 +25,6 @@
 /* Internal includes */
 #include "util/debug/Debug_public.h"
 #include "system/event_manager/EventManager_public.h"
-#include "system/kernel/Kernel_public.h"
 #include "drivers/timer/Timer_private.h"
 #include "drivers/timer/Timer_events.h"
 
@@ -34,10 +33,6 @@
  * ------------------------------------------------------------------------- */
 
 void Timer_int_raise_event(Timer_Timer *p_timer) {
-    /* Disable interrupts to prevent another one from triggering any changes to
-     * the event manager too */
-    Kernel_disable_interrupts();
-
     /* Clear the interrupt. This must be done early as it can take a number of
      * clock cycles for the clear to have an effect. */
     TimerIntClear(
@@ -45,9 +40,13 @@ void Timer_int_raise_event(Timer_Timer *p_timer) {
         p_timer->interrupt_mask
     );
 
-    /* Raise the event.
-     * TODO: Error handling in interrupt? */
-    EventManager_raise_event(p_timer->completed_event);
+    /* Queue the event, it will be raised at the start of the next cycle. A
+     * full queue is reported by the EventManager, so the return value isn't
+     * needed here. */
+    (void)EventManager_raise_event_from_isr(
+        EVENTMANAGER_ISR_SOURCE_TIMER,
+        p_timer->completed_event
+    );
 
     /* If the timer is not periodic make it available. If it was configured 
      * joined with it's other pair enable the pair too */
@@ -58,9 +57,6 @@ void Timer_int_raise_event(Timer_Timer *p_timer) {
             p_timer->p_block->p_b->is_available = true;
         }
     }
-
-    /* Reenable interrupts */
-    Kernel_enable_interrupts();
 }
 
 void Timer_int_00A(void) {
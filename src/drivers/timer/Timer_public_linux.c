@@ -14,6 +14,9 @@
  * This is to allow high level code to be developed and tested with a reliable
  * timer API.
  * 
+ * If built with VIRTUAL_TIME the POSIX timer is replaced by the VirtualTime
+ * alarm, which fires as soon as the main loop waits for an interrupt.
+ * 
  * @version 0.1
  * @date 2021-02-04
  * 
@@ -34,8 +37,11 @@
 
 /* Internal includes */
 #include "util/debug/Debug_public.h"
+#include "system/event_manager/EventManager_public.h"
 #include "drivers/timer/Timer_public.h"
 #include "drivers/timer/Timer_private.h"
+#include "drivers/virtual_time/VirtualTime_public.h"
+#include "drivers/replay/Replay_public.h"
 
 /* -------------------------------------------------------------------------   
  * DEFINES
@@ -65,10 +71,12 @@
  * GLOBALS
  * ------------------------------------------------------------------------- */
 
+#ifndef VIRTUAL_TIME
 /**
  * @brief Timer instance used to trigger all timers
  */
 static timer_t TIMER_TIMER;
+#endif
 
 /**
  * @brief Atomically modifiable timer states.
@@ -117,6 +125,10 @@ void Timer_signal_handler(
     void *p_context __attribute__((unused))
 );
 
+void Timer_check_timers(void);
+
+int Timer_arm(const struct timespec *const p_now_in, const double next_in);
+
 ErrorCode Timer_set(
     const double seconds_in, 
     bool periodic_in,
@@ -231,10 +243,7 @@ void Timer_signal_handler(
     siginfo_t *p_info, 
     void *p_context __attribute__((unused))
 ) {
-    struct timespec now;
-    struct itimerspec when;
-    int saved_errno, i, state;
-    double next;
+    int saved_errno;
 
     /* If not a timer signal exit now. */
     if (!p_info || p_info->si_code != SI_TIMER) {
@@ -244,12 +253,32 @@ void Timer_signal_handler(
     /* Save errno, some of the functions may modify it */
     saved_errno = errno;
 
+    Timer_check_timers();
+
+    errno = saved_errno;
+}
+
+/**
+ * @brief Fire the events of any timers which have passed and arm the timer
+ * for the next one.
+ * 
+ * This must be async-signal safe as it is called from the signal handler, or
+ * by the VirtualTime alarm. It is marked as an interrupt for the Replay
+ * module, as the RTC reads made when queueing the events are only seen
+ * through the events.
+ */
+void Timer_check_timers(void) {
+    struct timespec now;
+    int i, state;
+    double next;
+
     /* Get the current time */
-    if (clock_gettime(CLOCK_REALTIME, &now)) {
-        errno = saved_errno;
+    if (VirtualTime_clock_gettime(CLOCK_REALTIME, &now)) {
         return;
     }
 
+    Replay_enter_isr();
+
     /* Assume there's no timer next */
     next = -1.0;
 
@@ -269,10 +298,12 @@ void Timer_signal_handler(
             /* If passed, fire the timer's event. We count on the events being
              * mapped linearly with timer index */
             if (seconds <= 0.0) {
-                if (!EventManager_raise_event(
+                if (!EventManager_raise_event_from_isr(
+                    EVENTMANAGER_ISR_SOURCE_TIMER,
                     (Event)(EVT_TIMER_00A_COMPLETE + i))
                 ) {
-                    DEBUG_ERR("Failed to raise event in Timer signal handler");
+                    DEBUG_ERR("Failed to queue event in Timer signal handler");
+                    Replay_exit_isr();
                     return;
                 }
                 /* If periodic increment the target time in the timer */
@@ -302,25 +333,59 @@ void Timer_signal_handler(
         }
     }
 
+    Timer_arm(&now, next);
+
+    Replay_exit_isr();
+}
+
+/**
+ * @brief Arm the timer to fire the given number of seconds from now.
+ * 
+ * This must be async-signal safe.
+ * 
+ * @param p_now_in The current time.
+ * @param next_in Seconds from now at which to fire, the timer is disarmed if
+ * this is not positive.
+ * @return int 0 on success, otherwise -1.
+ */
+int Timer_arm(const struct timespec *const p_now_in, const double next_in) {
+    #ifdef VIRTUAL_TIME
+    struct timespec then;
+
+    if (next_in <= 0.0) {
+        VirtualTime_clear_alarm();
+        return 0;
+    }
+
+    then = *p_now_in;
+    timespec_add_seconds(&then, next_in);
+    VirtualTime_set_alarm(&then, &Timer_check_timers);
+
+    return 0;
+    #else
+    struct itimerspec when;
+
+    (void)p_now_in;
+
     /* Note: timespec_set() will set the time to zero if next <= 0.0,
      *       which in turn will disarm the timer.
      * The timer is one-shot; it_interval == 0.
     */
-    timespec_set_seconds(&when.it_value, next);
+    timespec_set_seconds(&when.it_value, next_in);
     when.it_interval.tv_sec = 0;
     when.it_interval.tv_nsec = 0L;
-    timer_settime(TIMER_TIMER, 0, &when, NULL);
 
-    errno = saved_errno;
+    return timer_settime(TIMER_TIMER, 0, &when, NULL);
+    #endif
 }
 
+
 ErrorCode Timer_set(
     const double seconds_in, 
     bool periodic_in,
     Event *p_event_out
 ) {
     struct timespec   now, then;
-    struct itimerspec when;
     double            next;
     int               timer, i, state;
 
@@ -331,7 +396,7 @@ ErrorCode Timer_set(
     }
 
     /* Get current time, */
-    if (clock_gettime(CLOCK_REALTIME, &now)) {
+    if (VirtualTime_clock_gettime(CLOCK_REALTIME, &now)) {
         DEBUG_ERR("Couldn't get current clock time");
         return TIMER_ERROR_NULL_TIMER;
     }
@@ -402,13 +467,8 @@ ErrorCode Timer_set(
         }
     }
 
-    /* Calculate duration when to fire the timeout next, */
-    timespec_set_seconds(&when.it_value, next);
-    when.it_interval.tv_sec = 0;
-    when.it_interval.tv_nsec = 0L;
-
-    /* and arm the timer. */
-    if (timer_settime(TIMER_TIMER, 0, &when, NULL)) {
+    /* Arm the timer for the next timeout */
+    if (Timer_arm(&now, next)) {
         /* Failed, clear the timer we just set */
         __atomic_store_n(
             &TIMER_LINUX_STATE[timer],
@@ -427,13 +487,19 @@ ErrorCode Timer_set(
 
 ErrorCode Timer_init(void) {
     
+    #ifndef VIRTUAL_TIME
     struct sigaction sig_act;
     struct sigevent sig_evt;
     struct itimerspec timer_spec;
+    #endif
+    int timer;
 
     /* Set the module as enabled at the start */
     TIMER_MODULE_DISABLED = false;
 
+    /* In virtual time the VirtualTime alarm is used instead of the signal */
+    #ifndef VIRTUAL_TIME
+
     /* Build signal for the timers */
     sigemptyset(&sig_act.sa_mask);
     sig_act.sa_sigaction = Timer_signal_handler;
@@ -469,6 +535,18 @@ ErrorCode Timer_init(void) {
         TIMER_MODULE_DISABLED = true;
         return TIMER_MODULE_DISABLED;
     }
+    #endif
+
+    /* Coalesce the timer events, so that a periodic timer which fires
+     * several times before it is polled can't fill the EventManager's lists.
+     * Failure just means each expiry takes its own slot, so only warn. */
+    for (timer = 0; timer < TIMER_NUM_TIMERS; ++timer) {
+        if (!EventManager_enable_coalescing(
+            (Event)(EVT_TIMER_00A_COMPLETE + timer)
+        )) {
+            DEBUG_WRN("Couldn't enable coalescing of timer %d events", timer);
+        }
+    }
 
     return ERROR_NONE;
 }
@@ -36,6 +36,7 @@
 
 ErrorCode Timer_init(void) {
     uint8_t block;
+    uint8_t timer_idx;
     uint8_t checks;
     uint8_t num_failed_peripherals = 0;
     bool ready;
@@ -99,6 +100,17 @@ ErrorCode Timer_init(void) {
 
     /* Timer configuration is performed when a timer is started */
 
+    /* Coalesce the timer events, so that a periodic timer which fires
+     * several times before it is polled can't fill the EventManager's lists.
+     * Failure just means each expiry takes its own slot, so only warn. */
+    for (timer_idx = 0; timer_idx < TIMER_NUM_TIMERS; ++timer_idx) {
+        if (!EventManager_enable_coalescing(
+            (Event)(EVT_TIMER_00A_COMPLETE + timer_idx)
+        )) {
+            DEBUG_WRN("Couldn't enable coalescing of timer %d events", timer_idx);
+        }
+    }
+
     return ERROR_NONE;
 }
 
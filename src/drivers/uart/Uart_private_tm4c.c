@@ -196,7 +196,10 @@ void Uart_service_irq(Uart_DeviceId uart_id_in) {
         );
         if (udma_mode_tx == UDMA_MODE_STOP) {
             // DEBUG_DBG("UART TX STOP");
-            EventManager_raise_event(p_uart_device->tx_event);
+            (void)EventManager_raise_event_from_isr(
+                EVENTMANAGER_ISR_SOURCE_UART,
+                p_uart_device->tx_event
+            );
             p_uart_device->uart_status_tx = UART_STATUS_COMPLETE;
 
             #if 0
@@ -217,7 +220,10 @@ void Uart_service_irq(Uart_DeviceId uart_id_in) {
         if (udma_mode_rx == UDMA_MODE_STOP) {
             // DEBUG_DBG("UART RX STOP");
             // DEBUG_DBG("UART DATA: %02X %02X", DP.EPS.EPS_REPLY[0], DP.EPS.EPS_REPLY[1]);
-            EventManager_raise_event(p_uart_device->rx_event);
+            (void)EventManager_raise_event_from_isr(
+                EVENTMANAGER_ISR_SOURCE_UART,
+                p_uart_device->rx_event
+            );
             p_uart_device->uart_status_rx = UART_STATUS_COMPLETE;
 
             // if (DP.EPS.EPS_REPLY[1] == 0x81 && DP.EPS.EXPECT_HEADER) {
@@ -252,7 +258,10 @@ void Uart_service_tx_irq(Uart_DeviceId uart_id_in) {
     /* The transfer is complete if the TX mode is "UDMA_MODE_STOP", so
     * raise the event and set the TX status as complete. */
     if (p_uart_device->udma_mode == UDMA_MODE_STOP) {
-        EventManager_raise_event(p_uart_device->tx_event);
+        (void)EventManager_raise_event_from_isr(
+            EVENTMANAGER_ISR_SOURCE_UART,
+            p_uart_device->tx_event
+        );
         p_uart_device->uart_status_tx = UART_STATUS_COMPLETE;
     }
 }
@@ -29,6 +29,7 @@
 #include "drivers/uart/Uart_errors.h"
 
 #include "util/debug/Debug_public.h"
+#include "drivers/replay/Replay_public.h"
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
@@ -59,6 +60,11 @@ ErrorCode Uart_recv_bytes(
     uint32_t length_in
 ) {
     DEBUG_DBG("UART recv bytes attempted when running on linux, ignoring.");
+
+    /* The data isn't written, but record whatever the buffer holds so that
+     * replays see the same bytes */
+    Replay_input(REPLAY_INPUT_UART_RECV, p_data_out, length_in);
+
     EventManager_raise_event(EVT_UART_EPS_RX_COMPLETE);
     return ERROR_NONE;
 }
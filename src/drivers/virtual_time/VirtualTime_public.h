@@ -0,0 +1,122 @@
+/**
+ * @file VirtualTime_public.h
+ * @author agent (agent@local)
+ * @brief Virtual clock used to run the software faster than real time on
+ * linux.
+ *
+ * On linux the Timer, Rtc, Delay, and Debug modules read the time through
+ * VirtualTime_clock_gettime(). Normally this is just clock_gettime(), but if
+ * the software is built with the UOS3_VIRTUAL_TIME CMake option (which defines
+ * VIRTUAL_TIME) it instead returns the time of a virtual clock which starts at
+ * 0 and only moves when told to:
+ *  - Delay_us() advances it by the length of the delay,
+ *  - each busy main loop cycle advances it by VIRTUALTIME_CYCLE_NS,
+ *  - and Kernel_wait_for_interrupt() jumps it straight to the next alarm,
+ *    which is set by the Timer module in place of its POSIX timer.
+ *
+ * Long waits such as the boot up dwell time therefore take no real time at
+ * all, while events are still raised in the same order as they would be in
+ * real time. As the clock doesn't depend on the host the same run always
+ * gives the same sequence of events.
+ *
+ * This module only exists on linux, and only the virtual clock functions
+ * (everything but VirtualTime_clock_gettime()) work regardless of whether
+ * VIRTUAL_TIME is defined.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+#ifndef H_VIRTUALTIME_PUBLIC_H
+#define H_VIRTUALTIME_PUBLIC_H
+
+#ifndef TARGET_UNIX
+#error "VirtualTime is only available on linux"
+#endif
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Virtual time taken by a main loop cycle which doesn't wait for an
+ * interrupt, in nanoseconds.
+ *
+ * This keeps time moving while the main loop polls, for instance while a
+ * delayed event is pending.
+ */
+#define VIRTUALTIME_CYCLE_NS (100000ULL)
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Get the time of the given clock, in place of clock_gettime().
+ *
+ * If VIRTUAL_TIME is defined every clock reads the virtual clock, otherwise
+ * this calls clock_gettime().
+ *
+ * @param clock_id_in The clock to read.
+ * @param p_time_out The time of the clock.
+ * @return int 0 on success, or -1 with errno set on failure.
+ */
+int VirtualTime_clock_gettime(clockid_t clock_id_in, struct timespec *p_time_out);
+
+/**
+ * @brief Get the current time of the virtual clock.
+ *
+ * @param p_time_out The virtual time since the clock started.
+ */
+void VirtualTime_get_time(struct timespec *p_time_out);
+
+/**
+ * @brief Advance the virtual clock, calling the alarm handler if the alarm
+ * passes.
+ *
+ * @param ns_in The number of nanoseconds to advance by.
+ */
+void VirtualTime_advance_ns(uint64_t ns_in);
+
+/**
+ * @brief Set the alarm, replacing any alarm already set.
+ *
+ * The handler is called, as if it were an interrupt, when the virtual clock
+ * reaches the alarm time. The alarm is cleared before the handler is called
+ * so that the handler can set the next one. An alarm in the past fires the
+ * next time the clock moves.
+ *
+ * @param p_time_in The virtual time at which the alarm fires.
+ * @param p_handler_in The function called when the alarm fires.
+ */
+void VirtualTime_set_alarm(
+    const struct timespec *p_time_in,
+    void (*p_handler_in)(void)
+);
+
+/**
+ * @brief Clear the alarm, if one is set.
+ */
+void VirtualTime_clear_alarm(void);
+
+/**
+ * @brief Wait for the next interrupt by jumping the virtual clock to the
+ * alarm and calling its handler.
+ *
+ * @return true The alarm fired.
+ * @return false No alarm is set, so nothing in virtual time can end the wait.
+ */
+bool VirtualTime_wait_for_interrupt(void);
+
+#endif /* H_VIRTUALTIME_PUBLIC_H */
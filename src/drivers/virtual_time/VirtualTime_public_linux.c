@@ -0,0 +1,132 @@
+/**
+ * @file VirtualTime_public_linux.c
+ * @author agent (agent@local)
+ * @brief Linux implementation of the virtual clock.
+ *
+ * See VirtualTime_public.h for more information.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Internal includes */
+#include "drivers/virtual_time/VirtualTime_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of nanoseconds in a second.
+ */
+#define VIRTUALTIME_NS_PER_SEC (1000000000ULL)
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Current virtual time in nanoseconds.
+ *
+ * ---- NUMERICAL PROTECTION ----
+ * A uint64_t of nanoseconds lasts over 500 years.
+ */
+static uint64_t VIRTUALTIME_NOW_NS = 0;
+
+/**
+ * @brief Virtual time of the alarm in nanoseconds.
+ */
+static uint64_t VIRTUALTIME_ALARM_NS = 0;
+
+/**
+ * @brief Handler of the alarm, or NULL if no alarm is set.
+ */
+static void (*VIRTUALTIME_P_ALARM_HANDLER)(void) = NULL;
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+int VirtualTime_clock_gettime(
+    clockid_t clock_id_in,
+    struct timespec *p_time_out
+) {
+    #ifdef VIRTUAL_TIME
+    (void)clock_id_in;
+
+    VirtualTime_get_time(p_time_out);
+    return 0;
+    #else
+    return clock_gettime(clock_id_in, p_time_out);
+    #endif
+}
+
+void VirtualTime_get_time(struct timespec *p_time_out) {
+    p_time_out->tv_sec = (time_t)(VIRTUALTIME_NOW_NS / VIRTUALTIME_NS_PER_SEC);
+    p_time_out->tv_nsec = (long)(VIRTUALTIME_NOW_NS % VIRTUALTIME_NS_PER_SEC);
+}
+
+void VirtualTime_advance_ns(uint64_t ns_in) {
+    uint64_t target_ns = VIRTUALTIME_NOW_NS + ns_in;
+    void (*p_handler)(void);
+
+    /* Fire the alarm at its own time rather than the target, so that the
+     * handler sees the same time it would in real time. The handler may set
+     * another alarm which also passes before the target. */
+    while (VIRTUALTIME_P_ALARM_HANDLER != NULL
+        &&
+        VIRTUALTIME_ALARM_NS <= target_ns
+    ) {
+        if (VIRTUALTIME_ALARM_NS > VIRTUALTIME_NOW_NS) {
+            VIRTUALTIME_NOW_NS = VIRTUALTIME_ALARM_NS;
+        }
+
+        p_handler = VIRTUALTIME_P_ALARM_HANDLER;
+        VIRTUALTIME_P_ALARM_HANDLER = NULL;
+        p_handler();
+    }
+
+    VIRTUALTIME_NOW_NS = target_ns;
+}
+
+void VirtualTime_set_alarm(
+    const struct timespec *p_time_in,
+    void (*p_handler_in)(void)
+) {
+    VIRTUALTIME_ALARM_NS
+        = ((uint64_t)p_time_in->tv_sec * VIRTUALTIME_NS_PER_SEC)
+        + (uint64_t)p_time_in->tv_nsec;
+    VIRTUALTIME_P_ALARM_HANDLER = p_handler_in;
+}
+
+void VirtualTime_clear_alarm(void) {
+    VIRTUALTIME_P_ALARM_HANDLER = NULL;
+}
+
+bool VirtualTime_wait_for_interrupt(void) {
+    if (VIRTUALTIME_P_ALARM_HANDLER == NULL) {
+        return false;
+    }
+
+    /* Jump to the alarm, which fires it */
+    if (VIRTUALTIME_ALARM_NS > VIRTUALTIME_NOW_NS) {
+        VirtualTime_advance_ns(VIRTUALTIME_ALARM_NS - VIRTUALTIME_NOW_NS);
+    }
+    else {
+        VirtualTime_advance_ns(0);
+    }
+
+    return true;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file VirtualTime_test.c
+ * @author agent (agent@local)
+ * @brief Tests for the virtual clock.
+ *
+ * The virtual clock isn't reset between tests, so all times are relative to
+ * the time at the start of each test.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+/* External library includes */
+#include <cmocka.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "drivers/virtual_time/VirtualTime_public.h"
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of times VirtualTime_test_alarm_handler() has been called.
+ */
+static int VIRTUALTIME_TEST_NUM_ALARMS;
+
+/**
+ * @brief Virtual time at which VirtualTime_test_alarm_handler() was last
+ * called, in nanoseconds.
+ */
+static uint64_t VIRTUALTIME_TEST_ALARM_NS;
+
+/**
+ * @brief Period of the alarm set by VirtualTime_test_alarm_handler(), or 0
+ * if it doesn't set another alarm.
+ */
+static uint64_t VIRTUALTIME_TEST_ALARM_PERIOD_NS;
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Get the virtual time in nanoseconds.
+ */
+static uint64_t VirtualTime_test_get_ns(void) {
+    struct timespec now;
+
+    VirtualTime_get_time(&now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Set the alarm to the given virtual time in nanoseconds.
+ */
+static void VirtualTime_test_set_alarm_ns(uint64_t ns_in);
+
+/**
+ * @brief Alarm handler which records when it was called, and sets the next
+ * alarm if VIRTUALTIME_TEST_ALARM_PERIOD_NS is set.
+ */
+static void VirtualTime_test_alarm_handler(void) {
+    VIRTUALTIME_TEST_NUM_ALARMS++;
+    VIRTUALTIME_TEST_ALARM_NS = VirtualTime_test_get_ns();
+
+    if (VIRTUALTIME_TEST_ALARM_PERIOD_NS != 0) {
+        VirtualTime_test_set_alarm_ns(
+            VIRTUALTIME_TEST_ALARM_NS + VIRTUALTIME_TEST_ALARM_PERIOD_NS
+        );
+    }
+}
+
+static void VirtualTime_test_set_alarm_ns(uint64_t ns_in) {
+    struct timespec time;
+
+    time.tv_sec = (time_t)(ns_in / 1000000000ULL);
+    time.tv_nsec = (long)(ns_in % 1000000000ULL);
+    VirtualTime_set_alarm(&time, &VirtualTime_test_alarm_handler);
+}
+
+/* -------------------------------------------------------------------------
+ * TESTS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Test the clock only moves when advanced
+ *
+ * @param state cmocka state
+ */
+static void VirtualTime_test_advance(void **state) {
+    (void) state;
+    uint64_t start = VirtualTime_test_get_ns();
+
+    assert_int_equal(VirtualTime_test_get_ns(), start);
+
+    VirtualTime_advance_ns(1500);
+    assert_int_equal(VirtualTime_test_get_ns(), start + 1500);
+
+    /* Advancing over a second carries into the seconds */
+    VirtualTime_advance_ns(2000000000ULL);
+    assert_int_equal(VirtualTime_test_get_ns(), start + 2000001500ULL);
+}
+
+/**
+ * @brief Test alarms fire at their own time, including several in one
+ * advance
+ *
+ * @param state cmocka state
+ */
+static void VirtualTime_test_alarm(void **state) {
+    (void) state;
+    uint64_t start = VirtualTime_test_get_ns();
+
+    VIRTUALTIME_TEST_NUM_ALARMS = 0;
+    VIRTUALTIME_TEST_ALARM_PERIOD_NS = 0;
+
+    /* An alarm after the advance doesn't fire */
+    VirtualTime_test_set_alarm_ns(start + 1000);
+    VirtualTime_advance_ns(999);
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 0);
+
+    /* But does once it's reached, seeing its own time */
+    VirtualTime_advance_ns(500);
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 1);
+    assert_int_equal(VIRTUALTIME_TEST_ALARM_NS, start + 1000);
+    assert_int_equal(VirtualTime_test_get_ns(), start + 1499);
+
+    /* A periodic alarm fires every period of a long advance */
+    start = VirtualTime_test_get_ns();
+    VIRTUALTIME_TEST_NUM_ALARMS = 0;
+    VIRTUALTIME_TEST_ALARM_PERIOD_NS = 100;
+    VirtualTime_test_set_alarm_ns(start + 100);
+    VirtualTime_advance_ns(1050);
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 10);
+    assert_int_equal(VIRTUALTIME_TEST_ALARM_NS, start + 1000);
+
+    /* Cleared alarms don't fire */
+    VirtualTime_clear_alarm();
+    VirtualTime_advance_ns(1000);
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 10);
+}
+
+/**
+ * @brief Test waiting for an interrupt jumps to the alarm
+ *
+ * @param state cmocka state
+ */
+static void VirtualTime_test_wait_for_interrupt(void **state) {
+    (void) state;
+    uint64_t start = VirtualTime_test_get_ns();
+
+    VIRTUALTIME_TEST_NUM_ALARMS = 0;
+    VIRTUALTIME_TEST_ALARM_PERIOD_NS = 0;
+
+    /* Nothing to wait for */
+    assert_false(VirtualTime_wait_for_interrupt());
+    assert_int_equal(VirtualTime_test_get_ns(), start);
+
+    /* An hour passes instantly */
+    VirtualTime_test_set_alarm_ns(start + 3600000000000ULL);
+    assert_true(VirtualTime_wait_for_interrupt());
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 1);
+    assert_int_equal(VirtualTime_test_get_ns(), start + 3600000000000ULL);
+
+    /* An alarm in the past fires without moving the clock */
+    VirtualTime_test_set_alarm_ns(start);
+    assert_true(VirtualTime_wait_for_interrupt());
+    assert_int_equal(VIRTUALTIME_TEST_NUM_ALARMS, 2);
+    assert_int_equal(VirtualTime_test_get_ns(), start + 3600000000000ULL);
+    assert_false(VirtualTime_wait_for_interrupt());
+}
+
+/* -------------------------------------------------------------------------
+ * TEST GROUP
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Tests to run for the VirtualTime module.
+ */
+const struct CMUnitTest virtualtime_tests[] = {
+    cmocka_unit_test(
+        VirtualTime_test_advance
+    ),
+    cmocka_unit_test(
+        VirtualTime_test_alarm
+    ),
+    cmocka_unit_test(
+        VirtualTime_test_wait_for_interrupt
+    )
+};
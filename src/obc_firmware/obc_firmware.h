@@ -16,47 +16,148 @@
  * INCLUDES
  * ------------------------------------------------------------------------- */
 
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
 /* -------------------------------------------------------------------------   
- * FUNCTIONS
+ * STRUCTS
  * ------------------------------------------------------------------------- */
 
 /**
- * @brief Perform the early module init, which includes:
- *  - Critical system modules, as defined by the Kernel
- *  - All drivers
+ * @brief Descriptor of a module which is initialised and stepped by the
+ * firmware.
+ * 
+ * The table of descriptors is generated from obc_firmware_modules.json by
+ * obc_firmware_generate_modules.py.
  */
-void obc_firmware_init_early_modules(void);
+typedef struct _ObcFirmware_Module {
+    /**
+     * @brief The name of the module, as in Kernel_module_ids.json.
+     */
+    const char *p_name;
+
+    /**
+     * @brief The (shifted) module ID.
+     */
+    uint16_t mod_id;
+
+    /**
+     * @brief Initialise the module, returning false on failure. NULL if the
+     * module has no init function.
+     */
+    bool (*p_init)(void);
+
+    /**
+     * @brief Called if p_init fails, to handle the failure. NULL if there is
+     * no handling beyond logging the failure.
+     */
+    void (*p_init_failed)(void);
+
+    /**
+     * @brief Step the module, returning false on error. NULL if the module has
+     * no step function.
+     */
+    bool (*p_step)(void);
+
+    /**
+     * @brief Check whether the module has any work to do this cycle, i.e. if
+     * any event in its wake set is raised or it is busy. NULL if the module is
+     * only stepped at its step rate.
+     */
+    bool (*p_is_step_required)(void);
+
+    /**
+     * @brief The default step rate of the module, see ObcFirmware_StepRate.
+     */
+    uint16_t period;
+
+    /**
+     * @brief The default step phase of the module, see ObcFirmware_StepRate.
+     */
+    uint16_t phase;
+} ObcFirmware_Module;
 
 /**
- * @brief Initialise all remaining system modules
+ * @brief The rate at which a module is stepped.
+ * 
+ * The module is stepped on every cycle where (cycle % period) == phase, which
+ * allows slow modules to be spread across different cycles. Modules with an
+ * is_step_required function are also stepped on any other cycle where it
+ * returns true. A period of 0 turns off the periodic steps, so a module with a
+ * period of 0 and no is_step_required function is never stepped.
  */
-void obc_firmware_init_system(void);
+typedef struct _ObcFirmware_StepRate {
+    /**
+     * @brief Number of cycles between periodic steps, 0 for none.
+     */
+    uint16_t period;
+
+    /**
+     * @brief The cycle within the period on which the module is stepped, must
+     * be less than the period.
+     */
+    uint16_t phase;
+} ObcFirmware_StepRate;
+
+/* -------------------------------------------------------------------------   
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
 
 /**
- * @brief Initialise all components.
+ * @brief Descriptors of all modules, in the order they are initialised.
  */
-void obc_firmware_init_components(void);
+extern const ObcFirmware_Module OBC_FIRMWARE_MODULES[];
 
 /**
- * @brief Initialise all applications
+ * @brief The number of modules in OBC_FIRMWARE_MODULES.
  */
-void obc_firmware_init_applications(void);
+extern const size_t OBC_FIRMWARE_NUM_MODULES;
 
 /**
- * @brief Step the drivers
+ * @brief The modules with a step function, in the order they are stepped.
  */
-void obc_firmware_step_drivers(void);
+extern const ObcFirmware_Module *const OBC_FIRMWARE_STEP_ORDER[];
 
 /**
- * @brief Step the components
+ * @brief The number of modules in OBC_FIRMWARE_STEP_ORDER.
  */
-void obc_firmware_step_components(void);
+extern const size_t OBC_FIRMWARE_NUM_STEPPED_MODULES;
 
 /**
- * @brief Step the system modules.
- * 
- * Note that this includes applications through the use of the OpModeManager.
+ * @brief The step rate of each module in OBC_FIRMWARE_STEP_ORDER. Initialised
+ * with the module table's defaults, which are overridden by
+ * CFG.MODULE_STEP_RATE_TABLE in obc_firmware_init_step_rates().
+ */
+extern ObcFirmware_StepRate OBC_FIRMWARE_STEP_RATES[];
+
+/* -------------------------------------------------------------------------   
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Initialise all modules. The critical modules, as defined by the
+ * Kernel, are initialised first, followed by each module in
+ * OBC_FIRMWARE_MODULES.
+ */
+void obc_firmware_init_modules(void);
+
+/**
+ * @brief Apply the step rates in CFG.MODULE_STEP_RATE_TABLE to
+ * OBC_FIRMWARE_STEP_RATES. Must be called after the config has been loaded.
+ */
+void obc_firmware_init_step_rates(void);
+
+/**
+ * @brief Handle a failure to initialise the EEPROM.
+ */
+void obc_firmware_eeprom_init_failed(void);
+
+/**
+ * @brief Step each module in OBC_FIRMWARE_STEP_ORDER which is due to be
+ * stepped this cycle and has work to do.
  */
-void obc_firmware_step_system(void);
+void obc_firmware_step_modules(void);
 
 #endif /* H_OBC_FIRMWARE_H */
\ No newline at end of file
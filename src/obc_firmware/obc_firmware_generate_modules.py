@@ -0,0 +1,272 @@
+'''
+---- GENERATE OBC FIRMWARE MODULE TABLE ----
+
+This script generates `obc_firmware_modules_generated.c`, which contains the
+table of module descriptors that obc_firmware initialises and steps.
+
+The modules are listed in `obc_firmware_modules.json` in the order in which
+they are initialised. Each entry has the form:
+```
+{
+    "module_name": "Eps",
+    "include": "components/eps/Eps_public.h",
+    "init": "Eps_init",
+    "init_returns": "bool",
+    "init_failed": "obc_firmware_eps_init_failed",
+    "step": "Eps_step",
+    "step_returns": "bool",
+    "is_step_required": "Eps_is_step_required",
+    "step_order": 1,
+    "period": 0,
+    "phase": 0,
+    "description": "Optional comment placed above the descriptor."
+}
+```
+where `module_name` must match a module in
+`system/kernel/Kernel_module_ids.json`, from which the module ID is taken in
+the same way as the DataPool generator. Functions may return either `bool` or
+`ErrorCode`, with adapters generated for the latter. All keys apart from
+`module_name` and `include` are optional, and modules with a step function
+are stepped in ascending `step_order`. `period` and `phase` give the default
+step rate of the module (see ObcFirmware_StepRate in obc_firmware.h), which
+may be overridden by the config.
+
+To add a new module add it to `obc_firmware_modules.json`, the table is
+regenerated by CMake.
+'''
+
+import os
+import json
+import textwrap
+from datetime import datetime
+from pathlib import Path
+
+# Return types which functions in the table may have
+RETURN_TYPES = {'bool', 'ErrorCode'}
+
+# The period and phase are stored in a uint16_t
+MAX_PERIOD = 0xFFFF
+
+def main():
+
+    print('Starting obc_firmware module table generation')
+
+    # Get the root dir of OBC-Firmware
+    root_dir = Path(__file__).parent.absolute()
+    root_dir = root_dir.parent.parent
+
+    # Change into src
+    src_dir = root_dir.joinpath('src')
+    os.chdir(src_dir)
+
+    with open('system/kernel/Kernel_module_ids.json') as ids_f:
+        mod_ids = {m['module_name']: m for m in json.load(ids_f)}
+
+    with open('obc_firmware/obc_firmware_modules.json') as modules_f:
+        modules = json.load(modules_f)
+
+    check_modules(modules, mod_ids)
+
+    print(f'Found {len(modules)} modules')
+
+    with open('obc_firmware/obc_firmware_modules_generated.c', 'w+') as f:
+        f.write(generate_source(modules, mod_ids))
+
+def check_modules(modules, mod_ids):
+    '''
+    Check the module list is valid, raising a RuntimeError if not.
+    '''
+    names = set()
+    step_orders = set()
+
+    for module in modules:
+        name = module.get('module_name')
+        if name not in mod_ids:
+            raise RuntimeError(
+                f'Module {name} isn\'t in Kernel_module_ids.json'
+            )
+        if name in names:
+            raise RuntimeError(f'Module {name} is listed twice')
+        names.add(name)
+
+        if 'include' not in module:
+            raise RuntimeError(f'Module {name} has no include')
+
+        for func in ('init', 'step'):
+            if func in module \
+                and module.get(f'{func}_returns') not in RETURN_TYPES:
+                raise RuntimeError(
+                    f'{func}_returns of module {name} must be one of '
+                    f'{sorted(RETURN_TYPES)}'
+                )
+
+        if 'step' in module:
+            if 'step_order' not in module:
+                raise RuntimeError(f'Module {name} has no step_order')
+            if module['step_order'] in step_orders:
+                raise RuntimeError(
+                    f'Step order {module["step_order"]} of module {name} is '
+                    'used twice'
+                )
+            step_orders.add(module['step_order'])
+
+            period = module.get('period', 1)
+            if not 0 <= period <= MAX_PERIOD:
+                raise RuntimeError(
+                    f'Period of module {name} must be between 0 and '
+                    f'{MAX_PERIOD}'
+                )
+            if not 0 <= module.get('phase', 0) < max(period, 1):
+                raise RuntimeError(
+                    f'Phase of module {name} must be less than its period'
+                )
+
+def adapter_name(module, func):
+    '''
+    Get the name of the adapter of the given function of a module.
+    '''
+    return f'obc_firmware_{module["module_name"].lower()}_{func}'
+
+def gen_adapter(module, func):
+    '''
+    Generate an adapter which converts the ErrorCode returned by a module's
+    function into the bool used by the table, or an empty string if the
+    function already returns bool.
+    '''
+    if module[f'{func}_returns'] != 'ErrorCode':
+        return ''
+
+    return f'''
+static bool {adapter_name(module, func)}(void) {{
+    ErrorCode error = {module[func]}();
+
+    if (error != ERROR_NONE) {{
+        DEBUG_ERR("{module[func]}() failed with error 0x%04X", error);
+        return false;
+    }}
+
+    return true;
+}}
+'''
+
+def gen_func_ptr(module, func):
+    '''
+    Get the pointer to the given function of a module, which is NULL if it
+    doesn't have one.
+    '''
+    if func not in module:
+        return 'NULL'
+    if module.get(f'{func}_returns', 'bool') == 'ErrorCode':
+        return f'&{adapter_name(module, func)}'
+    return f'&{module[func]}'
+
+def gen_descriptor(module, mod_ids):
+    '''
+    Generate the descriptor of a module.
+    '''
+    comment = ''
+    if 'description' in module:
+        lines = textwrap.wrap(module['description'], 70)
+        comment = '    /* ' + '\n     * '.join(lines) + ' */\n'
+
+    return f'''{comment}    {{
+        .p_name = "{module["module_name"]}",
+        .mod_id = {mod_ids[module["module_name"]]["definition"]},
+        .p_init = {gen_func_ptr(module, 'init')},
+        .p_init_failed = {gen_func_ptr(module, 'init_failed')},
+        .p_step = {gen_func_ptr(module, 'step')},
+        .p_is_step_required = {gen_func_ptr(module, 'is_step_required')},
+        .period = {module.get("period", 1) if "step" in module else 0},
+        .phase = {module.get("phase", 0) if "step" in module else 0}
+    }}'''
+
+def generate_source(modules, mod_ids):
+    '''
+    Generate the source file text.
+    '''
+    newline = '\n'
+
+    includes = sorted(set(m['include'] for m in modules))
+
+    adapters = [
+        gen_adapter(m, func)
+        for m in modules for func in ('init', 'step') if func in m
+    ]
+
+    descriptors = [gen_descriptor(m, mod_ids) for m in modules]
+
+    stepped = sorted(
+        [(m['step_order'], i) for (i, m) in enumerate(modules) if 'step' in m]
+    )
+    step_order = [
+        f'    &OBC_FIRMWARE_MODULES[{i}], /* {modules[i]["module_name"]} */'
+        for (_, i) in stepped
+    ]
+    step_rates = [
+        f'    {{ {modules[i].get("period", 1)}, {modules[i].get("phase", 0)} }}, '
+        f'/* {modules[i]["module_name"]} */'
+        for (_, i) in stepped
+    ]
+
+    return \
+f'''/**
+ * @file obc_firmware_modules_generated.c
+ * @author Generated by obc_firmware_generate_modules.py
+ * @brief Generated table of the modules initialised and stepped by
+ * obc_firmware.
+ *
+ * This file was generated from obc_firmware_modules.json and
+ * Kernel_module_ids.json by obc_firmware_generate_modules.py.
+ *
+ * @version Generated
+ * @date {datetime.today().strftime('%Y-%m-%d')}
+ *
+ * @copyright Copyright (c) UoS3 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
+{newline.join(f'#include "{include}"' for include in includes)}
+
+/* Firmware */
+#include "obc_firmware/obc_firmware.h"
+
+/* -------------------------------------------------------------------------
+ * ADAPTERS
+ * ------------------------------------------------------------------------- */
+{''.join(adapters)}
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+const ObcFirmware_Module OBC_FIRMWARE_MODULES[] = {{
+{(',' + newline).join(descriptors)}
+}};
+
+const size_t OBC_FIRMWARE_NUM_MODULES
+    = sizeof(OBC_FIRMWARE_MODULES) / sizeof(OBC_FIRMWARE_MODULES[0]);
+
+const ObcFirmware_Module *const OBC_FIRMWARE_STEP_ORDER[] = {{
+{newline.join(step_order)}
+}};
+
+const size_t OBC_FIRMWARE_NUM_STEPPED_MODULES
+    = sizeof(OBC_FIRMWARE_STEP_ORDER) / sizeof(OBC_FIRMWARE_STEP_ORDER[0]);
+
+ObcFirmware_StepRate OBC_FIRMWARE_STEP_RATES[] = {{
+{newline.join(step_rates)}
+}};
+'''
+
+if __name__ == '__main__':
+    main()
@@ -20,27 +20,10 @@
 /* Utility */
 #include "util/debug/Debug_public.h"
 
-/* Drivers */
-#include "drivers/board/Board_public.h"
-#include "drivers/udma/Udma_public.h"
-#include "drivers/uart/Uart_public.h"
-#include "drivers/timer/Timer_public.h"
-#include "drivers/eeprom/Eeprom_public.h"
-#include "drivers/gpio/Gpio_public.h"
-#include "drivers/rtc/Rtc_public.h"
-
 /* System */
 #include "system/kernel/Kernel_public.h"
 #include "system/data_pool/DataPool_public.h"
-#include "system/event_manager/EventManager_public.h"
-
-/* Components */
-#include "components/eps/Eps_public.h"
-#include "components/led/Led_public.h"
-#include "components/imu/Imu_public.h"
-
-/* Apps */
-#include "applications/power/Power_public.h"
+#include "system/mem_store_manager/MemStoreManager_public.h"
 
 /* Firmware */
 #include "obc_firmware/obc_firmware.h"
@@ -49,8 +32,8 @@
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
 
-void obc_firmware_init_early_modules(void) {
-    ErrorCode error = ERROR_NONE;
+void obc_firmware_init_modules(void) {
+    const ObcFirmware_Module *p_module;
 
     /* ---- MODULE INITIALISATION ---- */
 
@@ -66,161 +49,54 @@ void obc_firmware_init_early_modules(void) {
      */
     Kernel_init_critical_modules();
 
-    /* Init rtc driver. This is done as early as possible to get the RTC time
-     * as close to reboot as possible. It is possible that the RTC module could
-     * be unresponsive, in which case it wouldn't be available to provide
-     * critical timing information. This would be bad and there's not many ways
-     * we can recover from this. */
-    error = Rtc_init();
-    if (error != ERROR_NONE) {
-        DEBUG_ERR("Rtc_init failed!");
-        /* TODO: Inform FDIR about failure */
-    }
-
-    /* After critical modules want to initialise the config provider next */
-    error = Eeprom_init();
-    if (error != ERROR_NONE) {
-        /* EEPROM can fail to initialise for two reasons:
-         *  - The number of read/write cycles has been exceeded
-         *  - The power is unstable
-         * 
-         * If the number of read/write cycles is exceeded there's nothing we
-         * can do. If it's a power instability giving the system some time to
-         * stabilise and then resetting may help, but to do this we really need
-         * to keep the system going. If this happens we will therefore attempt
-         * to load the redundant configuration which is kept as a part of the
-         * software image. We do this by raising the
-         * DP.MEMSTOREMANAGER.USE_BACKUP_CFG flag.
-         */
-        DP.MEMSTOREMANAGER.USE_BACKUP_CFG = true;
-        DEBUG_WRN(
-            "EEPROM initialisation failed, MemStoreManager will load backup config file"
-        );
-    }
-
-    /* Init MemStoreManager, which can fail if the EventManager encounters an
-     * error. If some cfg files are corrupted the defaults will be loaded,
-     * which itself can't fail. */
-    if (!MemStoreManager_init()) {
-        /* TODO: actions on event manager failure */
-    }
-
-    /* TODO: Init watchdog driver */
-
-    /* TODO: init delay driver */
-
-    /* Init Timer driver. If this fails scheduling tasks won't work, but the
-     * anything else could continue as normal. This means that much of the
-     * functionality of the system will be broken, but up/downlink _might_
-     * still be able to continue. Therefore failure to init timer doesn't
-     * constitute a complete failure of the entire mission. */
-    error = Timer_init();
-    if (error != ERROR_NONE) {
-        /* TODO: raise timer disabled FDIR event? */
-    }
-
-    /* init udma driver */
-    error = Udma_init();
-    if (error != ERROR_NONE) {
-        /* If UDMA fails to init SPI and UART will also fail to init, mission
-         * ending failure? */
-    }
-
-    /* Init GPIO driver */
-    /* TODO: fix GPIO init
-    error = Gpio_init();
-    if (error != ERROR_NONE) {
+    /* Init the remaining modules in the order of the module table, see
+     * obc_firmware_modules.json.
+     * 
+     * A failure of any of these only affects the module itself and those
+     * depending on it, so the rest are still initialised. Modules which need
+     * more than logging to handle a failure provide an init failed function.
+     */
+    for (size_t i = 0; i < OBC_FIRMWARE_NUM_MODULES; ++i) {
+        p_module = &OBC_FIRMWARE_MODULES[i];
 
-    }*/
+        if (p_module->p_init == NULL) {
+            continue;
+        }
 
-    /* Init uart driver */
-    error = Uart_init();
-    if (error != ERROR_NONE) {
-        /* If UART fails to init EPS can't be communicated with, we will be
-         * entering safe mode */
-    }
+        if (!p_module->p_init()) {
+            DEBUG_ERR("%s init failed", p_module->p_name);
+            /* TODO: Inform FDIR about failure */
 
-    /* Init I2C driver. If this fails only those components dependent on I2C
-     * are affected, unfortunately this includes the temp monitoring app, which
-     * then only leaves the battery temperature as the only indicator. This
-     * failure is dealt with at the app level, but we want to generate an FDIR
-     * event for observability. */
-    error = I2c_init();
-    if (error != ERROR_NONE) {
-        /* TODO: Raise I2C init failed FDIR event */
+            if (p_module->p_init_failed != NULL) {
+                p_module->p_init_failed();
+            }
+        }
     }
 
-    /* TODO: init SPI driver */
+    /* Now that the config is loaded apply its step rates and cycle time
+     * budget. The budget isn't applied in virtual time, as overruns would
+     * depend on the speed of the host rather than the virtual clock. */
+    obc_firmware_init_step_rates();
+    #ifndef VIRTUAL_TIME
+    Kernel_set_cycle_budget(CFG.KERNEL_CYCLE_BUDGET_US);
+    #endif
 }
 
-void obc_firmware_init_system(void) {
-    /* TODO: init service interface */
-
-    /* TODO: init TM manager */
-
-    /* TODO: init TC router */
-
-    /* TODO: init parameter monitor */
-
-    /* Init OpModeManager */
-    OpModeManager_init();
-
-    /* TODO: init service handlers */
-}
-
-void obc_firmware_init_components(void) {
-
-    /* LED doesn't have an init function */
-    
-    /* Init EPS */
-    if (!Eps_init()) {
-        /* If the EPS init fails we have a major problem. The EPS system should
-         * start with all the rails required for SAFE mode on, so if we have
-         * this problem we must immediately raise the transition to safe event.
-         * 
-         * There's a chance that the problem could be fixed by the ground
-         * control changing config, so we want to give them that possibility by
-         * allowing commands and telemetry through still, which can be done in
-         * safe mode. */
-        /* TODO: raise FDIR safe mode event */
-    }
-
-    /* TODO: init radio */
-
-    /* TODO: init FRAM */
-
-    /* TODO: init Antenna */
-
-    /* TODO: init Camera */
-
-    /* TODO: init GNSS */
-    
-    /* Init IMU. Failures in IMU could be from event manager or from a critical
-     * module not being initialised. */
-    if (!Imu_init()) {
-        /* TODO: Raise error tm */
-    }
-
-    /* TODO: init temp */
+void obc_firmware_eeprom_init_failed(void) {
+    /* EEPROM can fail to initialise for two reasons:
+     *  - The number of read/write cycles has been exceeded
+     *  - The power is unstable
+     * 
+     * If the number of read/write cycles is exceeded there's nothing we
+     * can do. If it's a power instability giving the system some time to
+     * stabilise and then resetting may help, but to do this we really need
+     * to keep the system going. If this happens we will therefore attempt
+     * to load the redundant configuration which is kept as a part of the
+     * software image. We do this by raising the
+     * DP.MEMSTOREMANAGER.USE_BACKUP_CFG flag.
+     */
+    DP.MEMSTOREMANAGER.USE_BACKUP_CFG = true;
+    DEBUG_WRN(
+        "EEPROM initialisation failed, MemStoreManager will load backup config file"
+    );
 }
-
-void obc_firmware_init_applications(void) {
-
-    /* Init power */
-    if (!Power_init()) {
-        /* Power can only fail to init if a critical module isn't init. We will
-         * do nothing as getting to this stage should be impossible. */
-    }
-
-    /* TODO: Init thermal */
-
-    /* TODO: init comms */
-
-    /* TODO: init deployment */
-
-    /* TODO: init picture */
-
-    /* TODO: init payload */
-
-    /* TODO: init beacon */
-}
\ No newline at end of file
@@ -13,30 +13,30 @@
  * INCLUDES
  * ------------------------------------------------------------------------- */
 
+#include "system/kernel/Kernel_public.h"
 #include "system/data_pool/DataPool_public.h"
 #include "system/event_manager/EventManager_public.h"
+#include "drivers/i2c/I2c_public.h"
+#include "drivers/timer/Timer_public.h"
 #include "util/debug/Debug_public.h"
 #include "obc_firmware/obc_firmware.h"
+#ifdef VIRTUAL_TIME
+#include "drivers/virtual_time/VirtualTime_public.h"
+#endif
 
 /* -------------------------------------------------------------------------   
  * MAIN
  * ------------------------------------------------------------------------- */
 
 int main(void) {
+    bool is_idle;
+    uint32_t delay_ms;
+    Event wake_event = EVT_NONE;
 
     /* ---- INITIALISATION ---- */
 
-    /* Perform the early init */
-    obc_firmware_init_early_modules();
-
-    /* Do system init */
-    obc_firmware_init_system();
-    
-    /* Do component init */
-    obc_firmware_init_components();
-
-    /* Do application init */
-    obc_firmware_init_applications();
+    /* Initialise all modules */
+    obc_firmware_init_modules();
 
     DEBUG_INF("obc_firmware init complete");
     DEBUG_INF("---- OBC-FIRMWARE MAIN LOOP ----");
@@ -44,29 +44,73 @@ int main(void) {
     /* ---- MAIN LOOP ---- */
     while (1) {
 
-        /* First thing in the loop is to step the drivers */
-        obc_firmware_step_drivers();
+        /* Time the cycle against the budget, excluding any wait for
+         * interrupt */
+        Kernel_start_cycle_profile();
 
-        /* Then the components */
-        obc_firmware_step_components();
+        /* First thing in the loop is to raise the events queued by interrupts
+         * since the last cycle, so that every module sees them this cycle */
+        EventManager_process_isr_events();
 
-        /* Then the system, which inclues the applications through system apps
-         * and user apps */
-        obc_firmware_step_system();
+        /* Call the handlers of any subscribed events which have been raised */
+        EventManager_dispatch_events();
+
+        /* Then step the modules, in the order of the module table */
+        obc_firmware_step_modules();
 
         /* Clean up events */
         EventManager_cleanup_events();
 
-        /* If no events after cleanup wait until interrupt occurs (only on
-         * TM4C, don't have propper interrupts on linux */
+        /* Check the cycle time after cleanup so that an overrun event isn't
+         * removed before modules see it next cycle */
+        Kernel_end_cycle_profile();
+
+        /* If no events after cleanup wait until an interrupt occurs, which on
+         * linux is a signal such as the timer signal. Interrupts are disabled
+         * for the check so that an event queued just before the wait isn't
+         * missed, the wait will still end on a pending interrupt. Events
+         * delayed by cycles are raised by the main loop rather than by an
+         * interrupt, so don't wait while any are pending. Likewise a busy I2C
+         * driver polls the peripheral rather than waiting for an interrupt. */
         Kernel_disable_interrupts();
-        if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0) {
-            #ifdef TARGET_TM4C
-            DEBUG_INF("No events, waiting for interrupt...");
-            __asm("WFI");
-            #endif
+        is_idle = DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0
+            &&
+            !EventManager_is_isr_event_pending()
+            &&
+            !EventManager_is_cycle_delayed_event_pending()
+            &&
+            !I2c_is_busy();
+
+        /* Events delayed by time are also raised by the main loop, so set a
+         * timer to wake it when the earliest is due. If the event is already
+         * due, or no timer is free, keep cycling instead. */
+        if (is_idle && EventManager_get_next_delay_ms(&delay_ms)) {
+            is_idle = delay_ms != 0
+                &&
+                Timer_start_one_shot(
+                    (double)delay_ms / 1000.0, 
+                    &wake_event
+                ) == ERROR_NONE;
+        }
+
+        if (is_idle) {
+            DEBUG_TRC("No events, waiting for interrupt...");
+            Kernel_wait_for_interrupt();
+        }
+        #ifdef VIRTUAL_TIME
+        else {
+            /* A cycle which doesn't wait still takes some time */
+            VirtualTime_advance_ns(VIRTUALTIME_CYCLE_NS);
         }
+        #endif
         Kernel_enable_interrupts();
+
+        /* Release the wake up timer in case another interrupt ended the wait
+         * first. Its event isn't used, so is cleaned up if it was raised. */
+        if (wake_event != EVT_NONE) {
+            (void)Timer_disable(wake_event);
+            wake_event = EVT_NONE;
+        }
     }
 
     return 0;
@@ -0,0 +1,287 @@
+/**
+ * @file obc_firmware_modules_generated.c
+ * @author Generated by obc_firmware_generate_modules.py
+ * @brief Generated table of the modules initialised and stepped by
+ * obc_firmware.
+ *
+ * This file was generated from obc_firmware_modules.json and
+ * Kernel_module_ids.json by obc_firmware_generate_modules.py.
+ *
+ * @version Generated
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) UoS3 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "applications/power/Power_public.h"
+#include "components/eps/Eps_public.h"
+#include "components/imu/Imu_public.h"
+#include "drivers/eeprom/Eeprom_public.h"
+#include "drivers/i2c/I2c_public.h"
+#include "drivers/rtc/Rtc_public.h"
+#include "drivers/timer/Timer_public.h"
+#include "drivers/uart/Uart_public.h"
+#include "drivers/udma/Udma_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/mem_store_manager/MemStoreManager_public.h"
+#include "system/opmode_manager/OpModeManager_public.h"
+
+/* Firmware */
+#include "obc_firmware/obc_firmware.h"
+
+/* -------------------------------------------------------------------------
+ * ADAPTERS
+ * ------------------------------------------------------------------------- */
+
+static bool obc_firmware_rtc_init(void) {
+    ErrorCode error = Rtc_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("Rtc_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_eeprom_init(void) {
+    ErrorCode error = Eeprom_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("Eeprom_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_timer_init(void) {
+    ErrorCode error = Timer_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("Timer_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_udma_init(void) {
+    ErrorCode error = Udma_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("Udma_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_uart_init(void) {
+    ErrorCode error = Uart_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("Uart_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_i2c_init(void) {
+    ErrorCode error = I2c_init();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("I2c_init() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+static bool obc_firmware_i2c_step(void) {
+    ErrorCode error = I2c_step();
+
+    if (error != ERROR_NONE) {
+        DEBUG_ERR("I2c_step() failed with error 0x%04X", error);
+        return false;
+    }
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+const ObcFirmware_Module OBC_FIRMWARE_MODULES[] = {
+    /* Initialised as early as possible to get the RTC time as close to
+     * reboot as possible. */
+    {
+        .p_name = "Rtc",
+        .mod_id = MOD_ID_RTC,
+        .p_init = &obc_firmware_rtc_init,
+        .p_init_failed = NULL,
+        .p_step = NULL,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    /* The config provider, which must be initialised before MemStoreManager. */
+    {
+        .p_name = "Eeprom",
+        .mod_id = MOD_ID_EEPROM,
+        .p_init = &obc_firmware_eeprom_init,
+        .p_init_failed = &obc_firmware_eeprom_init_failed,
+        .p_step = NULL,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    /* Stepped last so that any modifications made to persistent data during
+     * the cycle are written at the end of it. */
+    {
+        .p_name = "MemStoreManager",
+        .mod_id = MOD_ID_MEMSTOREMANAGER,
+        .p_init = &MemStoreManager_init,
+        .p_init_failed = NULL,
+        .p_step = &MemStoreManager_step,
+        .p_is_step_required = NULL,
+        .period = 1,
+        .phase = 0
+    },
+    {
+        .p_name = "Timer",
+        .mod_id = MOD_ID_TIMER,
+        .p_init = &obc_firmware_timer_init,
+        .p_init_failed = NULL,
+        .p_step = NULL,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    /* Must be initialised before UART and SPI, which use it. */
+    {
+        .p_name = "Udma",
+        .mod_id = MOD_ID_UDMA,
+        .p_init = &obc_firmware_udma_init,
+        .p_init_failed = NULL,
+        .p_step = NULL,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    {
+        .p_name = "Uart",
+        .mod_id = MOD_ID_UART,
+        .p_init = &obc_firmware_uart_init,
+        .p_init_failed = NULL,
+        .p_step = NULL,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    /* Only stepped when it has work to do. */
+    {
+        .p_name = "I2c",
+        .mod_id = MOD_ID_I2C,
+        .p_init = &obc_firmware_i2c_init,
+        .p_init_failed = NULL,
+        .p_step = &obc_firmware_i2c_step,
+        .p_is_step_required = &I2c_is_step_required,
+        .period = 0,
+        .phase = 0
+    },
+    {
+        .p_name = "OpModeManager",
+        .mod_id = MOD_ID_OPMODEMANAGER,
+        .p_init = &OpModeManager_init,
+        .p_init_failed = NULL,
+        .p_step = &OpModeManager_step,
+        .p_is_step_required = NULL,
+        .period = 1,
+        .phase = 0
+    },
+    /* Only stepped when it has work to do. */
+    {
+        .p_name = "Eps",
+        .mod_id = MOD_ID_EPS,
+        .p_init = &Eps_init,
+        .p_init_failed = NULL,
+        .p_step = &Eps_step,
+        .p_is_step_required = &Eps_is_step_required,
+        .period = 0,
+        .phase = 0
+    },
+    /* Stepping is disabled as the component isn't finished. */
+    {
+        .p_name = "Imu",
+        .mod_id = MOD_ID_IMU,
+        .p_init = &Imu_init,
+        .p_init_failed = NULL,
+        .p_step = &Imu_step,
+        .p_is_step_required = NULL,
+        .period = 0,
+        .phase = 0
+    },
+    {
+        .p_name = "Power",
+        .mod_id = MOD_ID_POWER,
+        .p_init = &Power_init,
+        .p_init_failed = NULL,
+        .p_step = &Power_step,
+        .p_is_step_required = &Power_is_step_required,
+        .period = 1,
+        .phase = 0
+    },
+    /* Scans for the stack high water mark, which is slow and only needs to
+     * be seen eventually. */
+    {
+        .p_name = "Kernel",
+        .mod_id = MOD_ID_KERNEL,
+        .p_init = NULL,
+        .p_init_failed = NULL,
+        .p_step = &Kernel_stack_step,
+        .p_is_step_required = NULL,
+        .period = 1000,
+        .phase = 0
+    }
+};
+
+const size_t OBC_FIRMWARE_NUM_MODULES
+    = sizeof(OBC_FIRMWARE_MODULES) / sizeof(OBC_FIRMWARE_MODULES[0]);
+
+const ObcFirmware_Module *const OBC_FIRMWARE_STEP_ORDER[] = {
+    &OBC_FIRMWARE_MODULES[6], /* I2c */
+    &OBC_FIRMWARE_MODULES[8], /* Eps */
+    &OBC_FIRMWARE_MODULES[10], /* Power */
+    &OBC_FIRMWARE_MODULES[7], /* OpModeManager */
+    &OBC_FIRMWARE_MODULES[9], /* Imu */
+    &OBC_FIRMWARE_MODULES[2], /* MemStoreManager */
+    &OBC_FIRMWARE_MODULES[11], /* Kernel */
+};
+
+const size_t OBC_FIRMWARE_NUM_STEPPED_MODULES
+    = sizeof(OBC_FIRMWARE_STEP_ORDER) / sizeof(OBC_FIRMWARE_STEP_ORDER[0]);
+
+ObcFirmware_StepRate OBC_FIRMWARE_STEP_RATES[] = {
+    { 0, 0 }, /* I2c */
+    { 0, 0 }, /* Eps */
+    { 1, 0 }, /* Power */
+    { 1, 0 }, /* OpModeManager */
+    { 0, 0 }, /* Imu */
+    { 1, 0 }, /* MemStoreManager */
+    { 1000, 0 }, /* Kernel */
+};
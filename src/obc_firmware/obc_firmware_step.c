@@ -20,107 +20,128 @@
 /* Utility */
 #include "util/debug/Debug_public.h"
 
-/* Drivers */
-#include "drivers/board/Board_public.h"
-#include "drivers/uart/Uart_public.h"
-#include "drivers/timer/Timer_public.h"
-#include "drivers/eeprom/Eeprom_public.h"
-#include "drivers/gpio/Gpio_public.h"
-#include "drivers/uart/Uart_public.h"
-
 /* System */
 #include "system/kernel/Kernel_public.h"
-#include "system/data_pool/DataPool_public.h"
-#include "system/event_manager/EventManager_public.h"
 #include "system/mem_store_manager/MemStoreManager_public.h"
-#include "system/opmode_manager/OpModeManager_public.h"
-
-/* Components */
-#include "components/eps/Eps_public.h"
-#include "components/led/Led_public.h"
-#include "components/imu/Imu_public.h"
-
-/* Apps */
-#include "applications/power/Power_public.h"
 
 /* Firmware */
 #include "obc_firmware/obc_firmware.h"
 
 /* -------------------------------------------------------------------------   
- * FUNCTIONS
+ * GLOBALS
  * ------------------------------------------------------------------------- */
 
-void obc_firmware_step_drivers(void) {
-    /* GPIO has no step function, as it is effectively stateless */
-    
-    /* Step I2C */
-    if (!I2c_step()) {
-        /* TODO: register error with FDIR */
-    }
-
-    /* UART has no step, as it is handled by the UDMA */
-
-    /* TODO: step SPI */
-}
+/**
+ * @brief Number of cycles since boot, used to step modules at their rate in
+ * OBC_FIRMWARE_STEP_RATES.
+ */
+static uint32_t OBC_FIRMWARE_CYCLE_COUNT = 0;
 
-void obc_firmware_step_components(void) {
+/* -------------------------------------------------------------------------   
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
 
-    /* Step EPS */
-    if (!Eps_step()) {
-        /* TODO: register error with FDIR */
+void obc_firmware_init_step_rates(void) {
+    size_t num_rates = CFG.MODULE_STEP_RATE_TABLE_LENGTH;
+    uint16_t mod_id;
+    uint16_t period;
+    uint16_t phase;
+    bool found;
+
+    /* ---- NUMERICAL PROTECTION ----
+     * A corrupted length mustn't read past the end of the table */
+    if (num_rates > MEMSTOREMANAGER_MAX_NUM_STEP_RATES) {
+        DEBUG_WRN(
+            "Step rate table length %u is more than the maximum %u",
+            (unsigned int)num_rates,
+            (unsigned int)MEMSTOREMANAGER_MAX_NUM_STEP_RATES
+        );
+        num_rates = MEMSTOREMANAGER_MAX_NUM_STEP_RATES;
     }
 
-    /* TODO: step radio */
-
-    /* TODO: step FRAM */
-
-    /* TODO: step Antenna */
-
-    /* TODO: step Camera */
-
-    /* TODO: step GNSS */
-    
-    /* Step IMU
-     * Note: IMU stepping currently disabled as the component isn't finished
-     */
-    #if 0
-    if (!Imu_step()) {
-        /* TODO: Raise error tm */
+    for (size_t i = 0; i < num_rates; ++i) {
+        mod_id = CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_MOD_ID];
+        period = CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_PERIOD];
+        phase = CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_PHASE];
+
+        /* ---- NUMERICAL PROTECTION ----
+         * A phase outside the period would never be reached, so wrap it into
+         * the period rather than stopping the module's periodic steps. */
+        if (period != 0 && phase >= period) {
+            DEBUG_WRN(
+                "Step phase %u of module 0x%02X isn't less than its period %u",
+                phase,
+                mod_id,
+                period
+            );
+            phase %= period;
+        }
+
+        found = false;
+        for (size_t j = 0; j < OBC_FIRMWARE_NUM_STEPPED_MODULES; ++j) {
+            if ((OBC_FIRMWARE_STEP_ORDER[j]->mod_id >> KERNEL_MOD_ID_SHIFT)
+                ==
+                mod_id
+            ) {
+                OBC_FIRMWARE_STEP_RATES[j].period = period;
+                OBC_FIRMWARE_STEP_RATES[j].phase = phase;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            DEBUG_WRN(
+                "Step rate given for module 0x%02X, which isn't stepped",
+                mod_id
+            );
+        }
     }
-    #endif
-
-    /* TODO: step temp */
-
 }
 
-void obc_firmware_step_system(void) {
-
-    /* Step power */
-    if (!Power_step()) {
-        /* TODO: register error with FDIR */
-    }
-
-    /* TODO: step thermal */
-
-    /* TODO: step comms */
-
-    /* TODO: step TC router */
-
-    /* TODO: step TM manager (if it has a step func?) */
-
-    /* TODO: step parameter monitor */
-
-    /* Step opmode manager */
-    if (!OpModeManager_step()) {
-        /* TODO: register error with FDIR */
+/* Each step call is wrapped by the step profiler, which records its execution
+ * time against the module's ID in DP.KERNEL.
+ *
+ * A module is stepped on the cycles given by its step rate, and on any other
+ * cycle where its `_is_step_required()` function, if it has one, shows that it
+ * has work to do. Event driven modules such as I2C and EPS have no periodic
+ * steps, so are only stepped when they have work to do. Skipped steps aren't
+ * profiled, so the profile only shows the cost of real work. */
+
+void obc_firmware_step_modules(void) {
+    const ObcFirmware_Module *p_module;
+    const ObcFirmware_StepRate *p_rate;
+    bool is_due;
+    uint32_t profile_start;
+
+    for (size_t i = 0; i < OBC_FIRMWARE_NUM_STEPPED_MODULES; ++i) {
+        p_module = OBC_FIRMWARE_STEP_ORDER[i];
+        p_rate = &OBC_FIRMWARE_STEP_RATES[i];
+
+        is_due = p_rate->period != 0
+            &&
+            (OBC_FIRMWARE_CYCLE_COUNT % p_rate->period) == p_rate->phase;
+
+        /* Modules which aren't due are still stepped if they have work to
+         * do, so that events aren't missed between periodic steps */
+        if (!is_due
+            &&
+            (p_module->p_is_step_required == NULL
+             ||
+             !p_module->p_is_step_required())
+        ) {
+            continue;
+        }
+
+        profile_start = Kernel_start_step_profile();
+        if (!p_module->p_step()) {
+            /* TODO: register error with FDIR */
+        }
+        Kernel_end_step_profile(p_module->mod_id, profile_start);
     }
 
-    /* Step MemStoreManager
-     *
-     * This is done at the end of the cycle so that any modifications made to
-     * persistent data are written at the end of the cycle, rather than halfway
-     * through which could result in some data being missed */
-    if (!MemStoreManager_step()) {
-        /* TODO: register error with FDIR */
-    }
-}
\ No newline at end of file
+    /* ---- NUMERICAL PROTECTION ----
+     * The count wraps, which only causes one early step of modules whose
+     * period isn't a power of two. */
+    OBC_FIRMWARE_CYCLE_COUNT++;
+}
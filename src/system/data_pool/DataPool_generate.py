@@ -44,6 +44,9 @@ MODULE_ID_BITS = 6
 # Maximum number of items in a block
 BLOCK_INDEX_MAX_LIMIT = 1024
 
+# Pattern matching an array member's symbol, i.e. `SYMBOL[LENGTH]`
+ARRAY_SYMBOL_REGEX = re.compile(r'^(\w+)\s*\[(.*?)\]$')
+
 def main():
 
     print('Starting DataPool code generation')
@@ -186,9 +189,13 @@ def parse_dp_matches(matches, included_structs, module_ids):
             'block_index': 1,
             'dp_id: 0x0c01
             'data_type': 'bool',
+            'array_length': None,
             'brief': 'Indicates whether or not the EventManager has been initialised.'
         }
     }
+
+    Array members have the brackets removed from their symbol, and the text
+    between the brackets stored in 'array_length'.
     '''
 
     # Preallocate the datapool
@@ -257,11 +264,13 @@ def parse_dp_matches(matches, included_structs, module_ids):
 
             # Add the parameter to the data pool, noting that this is in the
             # DataPool module itself so the block ID is 0.
-            datapool[f'DP.{match.group(3)}'] = {
+            (member_symbol, array_length) = split_array_symbol(match.group(3))
+            datapool[f'DP.{member_symbol}'] = {
                 'block_id': 0,
                 'block_index': block_index,
                 'dp_id': block_index,
                 'data_type': match.group(2),
+                'array_length': array_length,
                 'brief': brief_text
             }
         else:
@@ -333,11 +342,13 @@ def parse_module_struct(block_ids, text, symbol):
 
             # Add the parameter to the data pool, noting that this is in the
             # DataPool module itself so the block ID is 0.
-            mod_dp[f'DP.{symbol}.{match.group(3)}'] = {
+            (member_symbol, array_length) = split_array_symbol(match.group(3))
+            mod_dp[f'DP.{symbol}.{member_symbol}'] = {
                 'block_id': block_ids[block_id_idx],
                 'block_index': dp_idx,
                 'dp_id': block_ids[block_id_idx] << (16 - MODULE_ID_BITS) | dp_idx,
                 'data_type': match.group(2),
+                'array_length': array_length,
                 'brief': brief_text
             }
         else:
@@ -347,6 +358,20 @@ def parse_module_struct(block_ids, text, symbol):
 
     return mod_dp
 
+def split_array_symbol(symbol):
+    '''
+    Split a member symbol into its name and array length. The length is kept
+    as the text inside the brackets, since it is usually a define, and is None
+    if the member is not an array.
+    '''
+
+    match = ARRAY_SYMBOL_REGEX.match(symbol)
+
+    if match is None:
+        return (symbol, None)
+
+    return (match.group(1), match.group(2).strip())
+
 def get_structs(text):
     '''
     Match all structs (typedef struct _StructName {...} StructName;) in some
@@ -444,7 +469,7 @@ bool DataPool_get(
 
 bool DataPool_get_symbol_str(
     DataPool_Id id_in, 
-    char **pp_symbol_str_out
+    const char **pp_symbol_str_out
 ) {{
 
     switch (id_in) {{
@@ -536,19 +561,19 @@ bool DataPool_get(
 );
 
 /**
- * @brief Fill a buffer with the symbol name of the DataPool parameter with the
- * given ID.
+ * @brief Get the symbol name of the DataPool parameter with the given ID.
  *
- * The caller is responsible for freeing the memory allocated for the symbol
- * string.
+ * The name is a constant string, so nothing is allocated and it mustn't be
+ * freed. Heap allocation through malloc() isn't available on the TM4C, see
+ * Kernel_malloc().
  *
  * @param id_in The ID of the DataPool parameter.
- * @param pp_symbol_str_out Pointer to the buffer to store the string in.
+ * @param pp_symbol_str_out Pointer to set to the symbol string.
  * @return bool True if successful, false if the ID is invalid.
  */
 bool DataPool_get_symbol_str(
     DataPool_Id id_in, 
-    char **pp_symbol_str_out
+    const char **pp_symbol_str_out
 );
 
 #endif /* H_DATAPOOL_GENERATED_H */
@@ -561,6 +586,20 @@ def get_parameter_code(symbol, dp_value, data_type_map):
     Return a string for the given symbol that returns the case statement for 
     get_symbol_str.
     '''
+
+    # Arrays are returned as a pointer to their first element, with the size
+    # of the whole array
+    if dp_value['array_length'] is not None:
+        return \
+f'''
+    /* {symbol} */
+    case 0x{dp_value["dp_id"]:04x}:
+        *pp_data_out = {symbol};
+        *p_data_type_out = {data_type_map[dp_value["data_type"]]};
+        *p_data_size_out = sizeof({symbol});
+        return true;
+'''
+
     return \
 f'''
     /* {symbol} */
@@ -580,7 +619,7 @@ def get_symbol_str_code(symbol, dp_value):
 f'''
     /* {symbol} */
     case 0x{dp_value["dp_id"]:04x}:
-        *pp_symbol_str_out = strdup("{symbol}");
+        *pp_symbol_str_out = "{symbol}";
         return true;
 '''
 
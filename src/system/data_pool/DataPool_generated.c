@@ -9,7 +9,7 @@
  * This file was generated from DataPool_struct.h by DataPool_generate.py.
  * 
  * @version Generated from DataPool_struct.h version 0.1
- * @date 2021-06-02
+ * @date 2026-10-17
  * 
  * @copyright Copyright (c) UoS3 2020
  */
@@ -64,6 +64,238 @@ bool DataPool_get(
         return true;
 
 
+    /* DP.DEBUG_NUM_DROPPED_LOGS */
+    case 0x0016:
+        *pp_data_out = &DP.DEBUG_NUM_DROPPED_LOGS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.DEBUG_TX_PEAK_BYTES */
+    case 0x0017:
+        *pp_data_out = &DP.DEBUG_TX_PEAK_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.DEBUG_VERBOSE_MODULES */
+    case 0x0018:
+        *pp_data_out = DP.DEBUG_VERBOSE_MODULES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.DEBUG_VERBOSE_MODULES);
+        return true;
+
+
+    /* DP.DEBUG_QUIET_MODULES */
+    case 0x0019:
+        *pp_data_out = DP.DEBUG_QUIET_MODULES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.DEBUG_QUIET_MODULES);
+        return true;
+
+
+    /* DP.DEBUG_NUM_SUPPRESSED_LOGS */
+    case 0x001a:
+        *pp_data_out = &DP.DEBUG_NUM_SUPPRESSED_LOGS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.DEBUG_CRASH_REASON */
+    case 0x001b:
+        *pp_data_out = &DP.DEBUG_CRASH_REASON;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
+        *p_data_size_out = sizeof(uint8_t);
+        return true;
+
+
+    /* DP.DEBUG_CRASH_CODE */
+    case 0x001c:
+        *pp_data_out = &DP.DEBUG_CRASH_CODE;
+        *p_data_type_out = DATAPOOL_DATATYPE_INT32_T;
+        *p_data_size_out = sizeof(int32_t);
+        return true;
+
+
+    /* DP.DEBUG_CRASH_FRAME */
+    case 0x001d:
+        *pp_data_out = DP.DEBUG_CRASH_FRAME;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.DEBUG_CRASH_FRAME);
+        return true;
+
+
+    /* DP.DEBUG_CRASH_ERROR_LENGTH */
+    case 0x001e:
+        *pp_data_out = &DP.DEBUG_CRASH_ERROR_LENGTH;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
+        *p_data_size_out = sizeof(uint8_t);
+        return true;
+
+
+    /* DP.DEBUG_CRASH_ERROR_BYTES */
+    case 0x001f:
+        *pp_data_out = DP.DEBUG_CRASH_ERROR_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
+        *p_data_size_out = sizeof(DP.DEBUG_CRASH_ERROR_BYTES);
+        return true;
+
+
+    /* DP.KERNEL.STEP_COUNT */
+    case 0x0004:
+        *pp_data_out = DP.KERNEL.STEP_COUNT;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.KERNEL.STEP_COUNT);
+        return true;
+
+
+    /* DP.KERNEL.STEP_MIN_NS */
+    case 0x0005:
+        *pp_data_out = DP.KERNEL.STEP_MIN_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.KERNEL.STEP_MIN_NS);
+        return true;
+
+
+    /* DP.KERNEL.STEP_MAX_NS */
+    case 0x0006:
+        *pp_data_out = DP.KERNEL.STEP_MAX_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.KERNEL.STEP_MAX_NS);
+        return true;
+
+
+    /* DP.KERNEL.STEP_MEAN_NS */
+    case 0x0007:
+        *pp_data_out = DP.KERNEL.STEP_MEAN_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.KERNEL.STEP_MEAN_NS);
+        return true;
+
+
+    /* DP.KERNEL.CYCLE_BUDGET_US */
+    case 0x0008:
+        *pp_data_out = &DP.KERNEL.CYCLE_BUDGET_US;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.CYCLE_MAX_NS */
+    case 0x0009:
+        *pp_data_out = &DP.KERNEL.CYCLE_MAX_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.NUM_CYCLE_OVERRUNS */
+    case 0x000a:
+        *pp_data_out = &DP.KERNEL.NUM_CYCLE_OVERRUNS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_TIMESTAMP */
+    case 0x000b:
+        *pp_data_out = &DP.KERNEL.LAST_OVERRUN_TIMESTAMP;
+        *p_data_type_out = DATAPOOL_DATATYPE_RTC_TIMESTAMP;
+        *p_data_size_out = sizeof(Rtc_Timestamp);
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_NS */
+    case 0x000c:
+        *pp_data_out = &DP.KERNEL.LAST_OVERRUN_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_MOD_ID */
+    case 0x000d:
+        *pp_data_out = &DP.KERNEL.LAST_OVERRUN_MOD_ID;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT16_T;
+        *p_data_size_out = sizeof(uint16_t);
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_MOD_NS */
+    case 0x000e:
+        *pp_data_out = &DP.KERNEL.LAST_OVERRUN_MOD_NS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.STACK_SIZE_BYTES */
+    case 0x000f:
+        *pp_data_out = &DP.KERNEL.STACK_SIZE_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.STACK_MAX_USED_BYTES */
+    case 0x0010:
+        *pp_data_out = &DP.KERNEL.STACK_MAX_USED_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.HEAP_SIZE_BYTES */
+    case 0x0011:
+        *pp_data_out = &DP.KERNEL.HEAP_SIZE_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.HEAP_USED_BYTES */
+    case 0x0012:
+        *pp_data_out = &DP.KERNEL.HEAP_USED_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.HEAP_PEAK_BYTES */
+    case 0x0013:
+        *pp_data_out = &DP.KERNEL.HEAP_PEAK_BYTES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.NUM_HEAP_ALLOC_FAILURES */
+    case 0x0014:
+        *pp_data_out = &DP.KERNEL.NUM_HEAP_ALLOC_FAILURES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS */
+    case 0x0015:
+        *pp_data_out = DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT16_T;
+        *p_data_size_out = sizeof(DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS);
+        return true;
+
+
+    /* DP.KERNEL.NUM_HEAP_INVALID_FREES */
+    case 0x0020:
+        *pp_data_out = &DP.KERNEL.NUM_HEAP_INVALID_FREES;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
     /* DP.EVENTMANAGER.INITIALISED */
     case 0x0c01:
         *pp_data_out = &DP.EVENTMANAGER.INITIALISED;
@@ -104,6 +336,54 @@ bool DataPool_get(
         return true;
 
 
+    /* DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED */
+    case 0x0c06:
+        *pp_data_out = &DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
+    /* DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER */
+    case 0x0c07:
+        *pp_data_out = &DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT16_T;
+        *p_data_size_out = sizeof(uint16_t);
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_CYCLES_HIST */
+    case 0x0c08:
+        *pp_data_out = DP.EVENTMANAGER.LATENCY_CYCLES_HIST;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.EVENTMANAGER.LATENCY_CYCLES_HIST);
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_US_HIST */
+    case 0x0c09:
+        *pp_data_out = DP.EVENTMANAGER.LATENCY_US_HIST;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(DP.EVENTMANAGER.LATENCY_US_HIST);
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_EVENT */
+    case 0x0c0a:
+        *pp_data_out = &DP.EVENTMANAGER.LATENCY_EVENT;
+        *p_data_type_out = DATAPOOL_DATATYPE_EVENT;
+        *p_data_size_out = sizeof(Event);
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_MAX_US */
+    case 0x0c0b:
+        *pp_data_out = &DP.EVENTMANAGER.LATENCY_MAX_US;
+        *p_data_type_out = DATAPOOL_DATATYPE_UINT32_T;
+        *p_data_size_out = sizeof(uint32_t);
+        return true;
+
+
     /* DP.IMU.INITIALISED */
     case 0x9401:
         *pp_data_out = &DP.IMU.INITIALISED;
@@ -336,11 +616,11 @@ bool DataPool_get(
         return true;
 
 
-    /* DP.EPS.EPS_REQUEST[EPS_MAX_UART_FRAME_LENGTH] */
+    /* DP.EPS.EPS_REQUEST */
     case 0x8806:
-        *pp_data_out = &DP.EPS.EPS_REQUEST[EPS_MAX_UART_FRAME_LENGTH];
+        *pp_data_out = DP.EPS.EPS_REQUEST;
         *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
-        *p_data_size_out = sizeof(uint8_t);
+        *p_data_size_out = sizeof(DP.EPS.EPS_REQUEST);
         return true;
 
 
@@ -352,11 +632,11 @@ bool DataPool_get(
         return true;
 
 
-    /* DP.EPS.EPS_REPLY[EPS_MAX_UART_FRAME_LENGTH] */
+    /* DP.EPS.EPS_REPLY */
     case 0x8808:
-        *pp_data_out = &DP.EPS.EPS_REPLY[EPS_MAX_UART_FRAME_LENGTH];
+        *pp_data_out = DP.EPS.EPS_REPLY;
         *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
-        *p_data_size_out = sizeof(uint8_t);
+        *p_data_size_out = sizeof(DP.EPS.EPS_REPLY);
         return true;
 
 
@@ -440,19 +720,19 @@ bool DataPool_get(
         return true;
 
 
-    /* DP.EPS.CONTINUE_TC[EPS_UART_HEADER_LENGTH] */
+    /* DP.EPS.CONTINUE_TC */
     case 0x8813:
-        *pp_data_out = &DP.EPS.CONTINUE_TC[EPS_UART_HEADER_LENGTH];
+        *pp_data_out = DP.EPS.CONTINUE_TC;
         *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
-        *p_data_size_out = sizeof(uint8_t);
+        *p_data_size_out = sizeof(DP.EPS.CONTINUE_TC);
         return true;
 
 
-    /* DP.EPS.RESET_COMMS_TC[EPS_UART_HEADER_LENGTH] */
+    /* DP.EPS.RESET_COMMS_TC */
     case 0x8814:
-        *pp_data_out = &DP.EPS.RESET_COMMS_TC[EPS_UART_HEADER_LENGTH];
+        *pp_data_out = DP.EPS.RESET_COMMS_TC;
         *p_data_type_out = DATAPOOL_DATATYPE_UINT8_T;
-        *p_data_size_out = sizeof(uint8_t);
+        *p_data_size_out = sizeof(DP.EPS.RESET_COMMS_TC);
         return true;
 
 
@@ -656,11 +936,11 @@ bool DataPool_get(
         return true;
 
 
-    /* DP.OPMODEMANAGER.APP_IN_NEXT_MODE[OPMODEMANAGER_MAX_NUM_APPS_IN_MODE] */
+    /* DP.OPMODEMANAGER.APP_IN_NEXT_MODE */
     case 0x2809:
-        *pp_data_out = &DP.OPMODEMANAGER.APP_IN_NEXT_MODE[OPMODEMANAGER_MAX_NUM_APPS_IN_MODE];
+        *pp_data_out = DP.OPMODEMANAGER.APP_IN_NEXT_MODE;
         *p_data_type_out = DATAPOOL_DATATYPE_BOOL;
-        *p_data_size_out = sizeof(bool);
+        *p_data_size_out = sizeof(DP.OPMODEMANAGER.APP_IN_NEXT_MODE);
         return true;
 
 
@@ -688,7 +968,7 @@ bool DataPool_get(
 
 bool DataPool_get_symbol_str(
     DataPool_Id id_in, 
-    char **pp_symbol_str_out
+    const char **pp_symbol_str_out
 ) {
 
     switch (id_in) {
@@ -696,481 +976,691 @@ bool DataPool_get_symbol_str(
     
     /* DP.INITIALISED */
     case 0x0001:
-        *pp_symbol_str_out = strdup("DP.INITIALISED");
+        *pp_symbol_str_out = "DP.INITIALISED";
         return true;
 
 
     /* DP.BOARD_INITIALISED */
     case 0x0002:
-        *pp_symbol_str_out = strdup("DP.BOARD_INITIALISED");
+        *pp_symbol_str_out = "DP.BOARD_INITIALISED";
         return true;
 
 
     /* DP.RTC_INITIALISED */
     case 0x0003:
-        *pp_symbol_str_out = strdup("DP.RTC_INITIALISED");
+        *pp_symbol_str_out = "DP.RTC_INITIALISED";
+        return true;
+
+
+    /* DP.DEBUG_NUM_DROPPED_LOGS */
+    case 0x0016:
+        *pp_symbol_str_out = "DP.DEBUG_NUM_DROPPED_LOGS";
+        return true;
+
+
+    /* DP.DEBUG_TX_PEAK_BYTES */
+    case 0x0017:
+        *pp_symbol_str_out = "DP.DEBUG_TX_PEAK_BYTES";
+        return true;
+
+
+    /* DP.DEBUG_VERBOSE_MODULES */
+    case 0x0018:
+        *pp_symbol_str_out = "DP.DEBUG_VERBOSE_MODULES";
+        return true;
+
+
+    /* DP.DEBUG_QUIET_MODULES */
+    case 0x0019:
+        *pp_symbol_str_out = "DP.DEBUG_QUIET_MODULES";
+        return true;
+
+
+    /* DP.DEBUG_NUM_SUPPRESSED_LOGS */
+    case 0x001a:
+        *pp_symbol_str_out = "DP.DEBUG_NUM_SUPPRESSED_LOGS";
+        return true;
+
+
+    /* DP.DEBUG_CRASH_REASON */
+    case 0x001b:
+        *pp_symbol_str_out = "DP.DEBUG_CRASH_REASON";
+        return true;
+
+
+    /* DP.DEBUG_CRASH_CODE */
+    case 0x001c:
+        *pp_symbol_str_out = "DP.DEBUG_CRASH_CODE";
+        return true;
+
+
+    /* DP.DEBUG_CRASH_FRAME */
+    case 0x001d:
+        *pp_symbol_str_out = "DP.DEBUG_CRASH_FRAME";
+        return true;
+
+
+    /* DP.DEBUG_CRASH_ERROR_LENGTH */
+    case 0x001e:
+        *pp_symbol_str_out = "DP.DEBUG_CRASH_ERROR_LENGTH";
+        return true;
+
+
+    /* DP.DEBUG_CRASH_ERROR_BYTES */
+    case 0x001f:
+        *pp_symbol_str_out = "DP.DEBUG_CRASH_ERROR_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.STEP_COUNT */
+    case 0x0004:
+        *pp_symbol_str_out = "DP.KERNEL.STEP_COUNT";
+        return true;
+
+
+    /* DP.KERNEL.STEP_MIN_NS */
+    case 0x0005:
+        *pp_symbol_str_out = "DP.KERNEL.STEP_MIN_NS";
+        return true;
+
+
+    /* DP.KERNEL.STEP_MAX_NS */
+    case 0x0006:
+        *pp_symbol_str_out = "DP.KERNEL.STEP_MAX_NS";
+        return true;
+
+
+    /* DP.KERNEL.STEP_MEAN_NS */
+    case 0x0007:
+        *pp_symbol_str_out = "DP.KERNEL.STEP_MEAN_NS";
+        return true;
+
+
+    /* DP.KERNEL.CYCLE_BUDGET_US */
+    case 0x0008:
+        *pp_symbol_str_out = "DP.KERNEL.CYCLE_BUDGET_US";
+        return true;
+
+
+    /* DP.KERNEL.CYCLE_MAX_NS */
+    case 0x0009:
+        *pp_symbol_str_out = "DP.KERNEL.CYCLE_MAX_NS";
+        return true;
+
+
+    /* DP.KERNEL.NUM_CYCLE_OVERRUNS */
+    case 0x000a:
+        *pp_symbol_str_out = "DP.KERNEL.NUM_CYCLE_OVERRUNS";
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_TIMESTAMP */
+    case 0x000b:
+        *pp_symbol_str_out = "DP.KERNEL.LAST_OVERRUN_TIMESTAMP";
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_NS */
+    case 0x000c:
+        *pp_symbol_str_out = "DP.KERNEL.LAST_OVERRUN_NS";
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_MOD_ID */
+    case 0x000d:
+        *pp_symbol_str_out = "DP.KERNEL.LAST_OVERRUN_MOD_ID";
+        return true;
+
+
+    /* DP.KERNEL.LAST_OVERRUN_MOD_NS */
+    case 0x000e:
+        *pp_symbol_str_out = "DP.KERNEL.LAST_OVERRUN_MOD_NS";
+        return true;
+
+
+    /* DP.KERNEL.STACK_SIZE_BYTES */
+    case 0x000f:
+        *pp_symbol_str_out = "DP.KERNEL.STACK_SIZE_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.STACK_MAX_USED_BYTES */
+    case 0x0010:
+        *pp_symbol_str_out = "DP.KERNEL.STACK_MAX_USED_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.HEAP_SIZE_BYTES */
+    case 0x0011:
+        *pp_symbol_str_out = "DP.KERNEL.HEAP_SIZE_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.HEAP_USED_BYTES */
+    case 0x0012:
+        *pp_symbol_str_out = "DP.KERNEL.HEAP_USED_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.HEAP_PEAK_BYTES */
+    case 0x0013:
+        *pp_symbol_str_out = "DP.KERNEL.HEAP_PEAK_BYTES";
+        return true;
+
+
+    /* DP.KERNEL.NUM_HEAP_ALLOC_FAILURES */
+    case 0x0014:
+        *pp_symbol_str_out = "DP.KERNEL.NUM_HEAP_ALLOC_FAILURES";
+        return true;
+
+
+    /* DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS */
+    case 0x0015:
+        *pp_symbol_str_out = "DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS";
+        return true;
+
+
+    /* DP.KERNEL.NUM_HEAP_INVALID_FREES */
+    case 0x0020:
+        *pp_symbol_str_out = "DP.KERNEL.NUM_HEAP_INVALID_FREES";
         return true;
 
 
     /* DP.EVENTMANAGER.INITIALISED */
     case 0x0c01:
-        *pp_symbol_str_out = strdup("DP.EVENTMANAGER.INITIALISED");
+        *pp_symbol_str_out = "DP.EVENTMANAGER.INITIALISED";
         return true;
 
 
     /* DP.EVENTMANAGER.ERROR */
     case 0x0c02:
-        *pp_symbol_str_out = strdup("DP.EVENTMANAGER.ERROR");
+        *pp_symbol_str_out = "DP.EVENTMANAGER.ERROR";
         return true;
 
 
     /* DP.EVENTMANAGER.MAX_EVENTS_REACHED */
     case 0x0c03:
-        *pp_symbol_str_out = strdup("DP.EVENTMANAGER.MAX_EVENTS_REACHED");
+        *pp_symbol_str_out = "DP.EVENTMANAGER.MAX_EVENTS_REACHED";
         return true;
 
 
     /* DP.EVENTMANAGER.NUM_RAISED_EVENTS */
     case 0x0c04:
-        *pp_symbol_str_out = strdup("DP.EVENTMANAGER.NUM_RAISED_EVENTS");
+        *pp_symbol_str_out = "DP.EVENTMANAGER.NUM_RAISED_EVENTS";
         return true;
 
 
     /* DP.EVENTMANAGER.EVENT_LIST_SIZE */
     case 0x0c05:
-        *pp_symbol_str_out = strdup("DP.EVENTMANAGER.EVENT_LIST_SIZE");
+        *pp_symbol_str_out = "DP.EVENTMANAGER.EVENT_LIST_SIZE";
+        return true;
+
+
+    /* DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED */
+    case 0x0c06:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED";
+        return true;
+
+
+    /* DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER */
+    case 0x0c07:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER";
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_CYCLES_HIST */
+    case 0x0c08:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.LATENCY_CYCLES_HIST";
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_US_HIST */
+    case 0x0c09:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.LATENCY_US_HIST";
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_EVENT */
+    case 0x0c0a:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.LATENCY_EVENT";
+        return true;
+
+
+    /* DP.EVENTMANAGER.LATENCY_MAX_US */
+    case 0x0c0b:
+        *pp_symbol_str_out = "DP.EVENTMANAGER.LATENCY_MAX_US";
         return true;
 
 
     /* DP.IMU.INITIALISED */
     case 0x9401:
-        *pp_symbol_str_out = strdup("DP.IMU.INITIALISED");
+        *pp_symbol_str_out = "DP.IMU.INITIALISED";
         return true;
 
 
     /* DP.IMU.ERROR_CODE */
     case 0x9402:
-        *pp_symbol_str_out = strdup("DP.IMU.ERROR_CODE");
+        *pp_symbol_str_out = "DP.IMU.ERROR_CODE";
         return true;
 
 
     /* DP.IMU.I2C_ERROR_CODE */
     case 0x9403:
-        *pp_symbol_str_out = strdup("DP.IMU.I2C_ERROR_CODE");
+        *pp_symbol_str_out = "DP.IMU.I2C_ERROR_CODE";
         return true;
 
 
     /* DP.IMU.STATE */
     case 0x9404:
-        *pp_symbol_str_out = strdup("DP.IMU.STATE");
+        *pp_symbol_str_out = "DP.IMU.STATE";
         return true;
 
 
     /* DP.IMU.SUBSTATE */
     case 0x9405:
-        *pp_symbol_str_out = strdup("DP.IMU.SUBSTATE");
+        *pp_symbol_str_out = "DP.IMU.SUBSTATE";
         return true;
 
 
     /* DP.IMU.COMMAND */
     case 0x9406:
-        *pp_symbol_str_out = strdup("DP.IMU.COMMAND");
+        *pp_symbol_str_out = "DP.IMU.COMMAND";
         return true;
 
 
     /* DP.IMU.GYROSCOPE_DATA */
     case 0x9407:
-        *pp_symbol_str_out = strdup("DP.IMU.GYROSCOPE_DATA");
+        *pp_symbol_str_out = "DP.IMU.GYROSCOPE_DATA";
         return true;
 
 
     /* DP.IMU.GYROSCOPE_DATA_VALID */
     case 0x9408:
-        *pp_symbol_str_out = strdup("DP.IMU.GYROSCOPE_DATA_VALID");
+        *pp_symbol_str_out = "DP.IMU.GYROSCOPE_DATA_VALID";
         return true;
 
 
     /* DP.IMU.MAGNETOMETER_DATA */
     case 0x9409:
-        *pp_symbol_str_out = strdup("DP.IMU.MAGNETOMETER_DATA");
+        *pp_symbol_str_out = "DP.IMU.MAGNETOMETER_DATA";
         return true;
 
 
     /* DP.IMU.MAGNE_SENSE_ADJUST_DATA */
     case 0x940a:
-        *pp_symbol_str_out = strdup("DP.IMU.MAGNE_SENSE_ADJUST_DATA");
+        *pp_symbol_str_out = "DP.IMU.MAGNE_SENSE_ADJUST_DATA";
         return true;
 
 
     /* DP.IMU.MAGNETOMETER_DATA_VALID */
     case 0x940b:
-        *pp_symbol_str_out = strdup("DP.IMU.MAGNETOMETER_DATA_VALID");
+        *pp_symbol_str_out = "DP.IMU.MAGNETOMETER_DATA_VALID";
         return true;
 
 
     /* DP.IMU.TEMPERATURE_DATA */
     case 0x940c:
-        *pp_symbol_str_out = strdup("DP.IMU.TEMPERATURE_DATA");
+        *pp_symbol_str_out = "DP.IMU.TEMPERATURE_DATA";
         return true;
 
 
     /* DP.IMU.TEMPERATURE_DATA_VALID */
     case 0x940d:
-        *pp_symbol_str_out = strdup("DP.IMU.TEMPERATURE_DATA_VALID");
+        *pp_symbol_str_out = "DP.IMU.TEMPERATURE_DATA_VALID";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.INITIALISED */
     case 0x1001:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.INITIALISED");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.INITIALISED";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.ERROR_CODE */
     case 0x1002:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.ERROR_CODE");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.ERROR_CODE";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.EEPROM_ERROR_CODE */
     case 0x1003:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.EEPROM_ERROR_CODE");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.EEPROM_ERROR_CODE";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.CFG_FILE_1_OK */
     case 0x1004:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.CFG_FILE_1_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.CFG_FILE_1_OK";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.CFG_FILE_2_OK */
     case 0x1005:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.CFG_FILE_2_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.CFG_FILE_2_OK";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.CFG_FILE_3_OK */
     case 0x1006:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.CFG_FILE_3_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.CFG_FILE_3_OK";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.USE_BACKUP_CFG */
     case 0x1007:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.USE_BACKUP_CFG");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.USE_BACKUP_CFG";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.PERS_DATA_DIRTY */
     case 0x1008:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.PERS_DATA_DIRTY");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.PERS_DATA_DIRTY";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.PERS_FILE_1_OK */
     case 0x1009:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.PERS_FILE_1_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.PERS_FILE_1_OK";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.PERS_FILE_2_OK */
     case 0x100a:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.PERS_FILE_2_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.PERS_FILE_2_OK";
         return true;
 
 
     /* DP.MEMSTOREMANAGER.PERS_FILE_3_OK */
     case 0x100b:
-        *pp_symbol_str_out = strdup("DP.MEMSTOREMANAGER.PERS_FILE_3_OK");
+        *pp_symbol_str_out = "DP.MEMSTOREMANAGER.PERS_FILE_3_OK";
         return true;
 
 
     /* DP.EPS.INITIALISED */
     case 0x8801:
-        *pp_symbol_str_out = strdup("DP.EPS.INITIALISED");
+        *pp_symbol_str_out = "DP.EPS.INITIALISED";
         return true;
 
 
     /* DP.EPS.ERROR */
     case 0x8802:
-        *pp_symbol_str_out = strdup("DP.EPS.ERROR");
+        *pp_symbol_str_out = "DP.EPS.ERROR";
         return true;
 
 
     /* DP.EPS.STATE */
     case 0x8803:
-        *pp_symbol_str_out = strdup("DP.EPS.STATE");
+        *pp_symbol_str_out = "DP.EPS.STATE";
         return true;
 
 
     /* DP.EPS.CONFIG_SYNCED */
     case 0x8804:
-        *pp_symbol_str_out = strdup("DP.EPS.CONFIG_SYNCED");
+        *pp_symbol_str_out = "DP.EPS.CONFIG_SYNCED";
         return true;
 
 
     /* DP.EPS.NEW_REQUEST */
     case 0x8805:
-        *pp_symbol_str_out = strdup("DP.EPS.NEW_REQUEST");
+        *pp_symbol_str_out = "DP.EPS.NEW_REQUEST";
         return true;
 
 
-    /* DP.EPS.EPS_REQUEST[EPS_MAX_UART_FRAME_LENGTH] */
+    /* DP.EPS.EPS_REQUEST */
     case 0x8806:
-        *pp_symbol_str_out = strdup("DP.EPS.EPS_REQUEST[EPS_MAX_UART_FRAME_LENGTH]");
+        *pp_symbol_str_out = "DP.EPS.EPS_REQUEST";
         return true;
 
 
     /* DP.EPS.EPS_REQUEST_LENGTH */
     case 0x8807:
-        *pp_symbol_str_out = strdup("DP.EPS.EPS_REQUEST_LENGTH");
+        *pp_symbol_str_out = "DP.EPS.EPS_REQUEST_LENGTH";
         return true;
 
 
-    /* DP.EPS.EPS_REPLY[EPS_MAX_UART_FRAME_LENGTH] */
+    /* DP.EPS.EPS_REPLY */
     case 0x8808:
-        *pp_symbol_str_out = strdup("DP.EPS.EPS_REPLY[EPS_MAX_UART_FRAME_LENGTH]");
+        *pp_symbol_str_out = "DP.EPS.EPS_REPLY";
         return true;
 
 
     /* DP.EPS.EPS_REPLY_LENGTH */
     case 0x8809:
-        *pp_symbol_str_out = strdup("DP.EPS.EPS_REPLY_LENGTH");
+        *pp_symbol_str_out = "DP.EPS.EPS_REPLY_LENGTH";
         return true;
 
 
     /* DP.EPS.UART_FRAME_NUMBER */
     case 0x880a:
-        *pp_symbol_str_out = strdup("DP.EPS.UART_FRAME_NUMBER");
+        *pp_symbol_str_out = "DP.EPS.UART_FRAME_NUMBER";
         return true;
 
 
     /* DP.EPS.COMMAND_STATUS */
     case 0x880b:
-        *pp_symbol_str_out = strdup("DP.EPS.COMMAND_STATUS");
+        *pp_symbol_str_out = "DP.EPS.COMMAND_STATUS";
         return true;
 
 
     /* DP.EPS.HK_DATA */
     case 0x880c:
-        *pp_symbol_str_out = strdup("DP.EPS.HK_DATA");
+        *pp_symbol_str_out = "DP.EPS.HK_DATA";
         return true;
 
 
     /* DP.EPS.UART_ERROR */
     case 0x880d:
-        *pp_symbol_str_out = strdup("DP.EPS.UART_ERROR");
+        *pp_symbol_str_out = "DP.EPS.UART_ERROR";
         return true;
 
 
     /* DP.EPS.EXPECT_HEADER */
     case 0x880e:
-        *pp_symbol_str_out = strdup("DP.EPS.EXPECT_HEADER");
+        *pp_symbol_str_out = "DP.EPS.EXPECT_HEADER";
         return true;
 
 
     /* DP.EPS.TRIPPED_OCP_RAILS */
     case 0x880f:
-        *pp_symbol_str_out = strdup("DP.EPS.TRIPPED_OCP_RAILS");
+        *pp_symbol_str_out = "DP.EPS.TRIPPED_OCP_RAILS";
         return true;
 
 
     /* DP.EPS.REPORTED_OCP_STATE */
     case 0x8810:
-        *pp_symbol_str_out = strdup("DP.EPS.REPORTED_OCP_STATE");
+        *pp_symbol_str_out = "DP.EPS.REPORTED_OCP_STATE";
         return true;
 
 
     /* DP.EPS.TIMEOUT_EVENT */
     case 0x8811:
-        *pp_symbol_str_out = strdup("DP.EPS.TIMEOUT_EVENT");
+        *pp_symbol_str_out = "DP.EPS.TIMEOUT_EVENT";
         return true;
 
 
     /* DP.EPS.TIMER_ERROR */
     case 0x8812:
-        *pp_symbol_str_out = strdup("DP.EPS.TIMER_ERROR");
+        *pp_symbol_str_out = "DP.EPS.TIMER_ERROR";
         return true;
 
 
-    /* DP.EPS.CONTINUE_TC[EPS_UART_HEADER_LENGTH] */
+    /* DP.EPS.CONTINUE_TC */
     case 0x8813:
-        *pp_symbol_str_out = strdup("DP.EPS.CONTINUE_TC[EPS_UART_HEADER_LENGTH]");
+        *pp_symbol_str_out = "DP.EPS.CONTINUE_TC";
         return true;
 
 
-    /* DP.EPS.RESET_COMMS_TC[EPS_UART_HEADER_LENGTH] */
+    /* DP.EPS.RESET_COMMS_TC */
     case 0x8814:
-        *pp_symbol_str_out = strdup("DP.EPS.RESET_COMMS_TC[EPS_UART_HEADER_LENGTH]");
+        *pp_symbol_str_out = "DP.EPS.RESET_COMMS_TC";
         return true;
 
 
     /* DP.POWER.INITIALISED */
     case 0xd401:
-        *pp_symbol_str_out = strdup("DP.POWER.INITIALISED");
+        *pp_symbol_str_out = "DP.POWER.INITIALISED";
         return true;
 
 
     /* DP.POWER.ERROR */
     case 0xd402:
-        *pp_symbol_str_out = strdup("DP.POWER.ERROR");
+        *pp_symbol_str_out = "DP.POWER.ERROR";
         return true;
 
 
     /* DP.POWER.TIMER_ERROR */
     case 0xd403:
-        *pp_symbol_str_out = strdup("DP.POWER.TIMER_ERROR");
+        *pp_symbol_str_out = "DP.POWER.TIMER_ERROR";
         return true;
 
 
     /* DP.POWER.LOW_POWER_STATUS */
     case 0xd404:
-        *pp_symbol_str_out = strdup("DP.POWER.LOW_POWER_STATUS");
+        *pp_symbol_str_out = "DP.POWER.LOW_POWER_STATUS";
         return true;
 
 
     /* DP.POWER.TASK_TIMER_EVENT */
     case 0xd405:
-        *pp_symbol_str_out = strdup("DP.POWER.TASK_TIMER_EVENT");
+        *pp_symbol_str_out = "DP.POWER.TASK_TIMER_EVENT";
         return true;
 
 
     /* DP.POWER.REQUESTED_OCP_STATE */
     case 0xd406:
-        *pp_symbol_str_out = strdup("DP.POWER.REQUESTED_OCP_STATE");
+        *pp_symbol_str_out = "DP.POWER.REQUESTED_OCP_STATE";
         return true;
 
 
     /* DP.POWER.UPDATE_EPS_HK */
     case 0xd407:
-        *pp_symbol_str_out = strdup("DP.POWER.UPDATE_EPS_HK");
+        *pp_symbol_str_out = "DP.POWER.UPDATE_EPS_HK";
         return true;
 
 
     /* DP.POWER.UPDATE_EPS_CFG */
     case 0xd408:
-        *pp_symbol_str_out = strdup("DP.POWER.UPDATE_EPS_CFG");
+        *pp_symbol_str_out = "DP.POWER.UPDATE_EPS_CFG";
         return true;
 
 
     /* DP.POWER.UPDATE_EPS_OCP_STATE */
     case 0xd409:
-        *pp_symbol_str_out = strdup("DP.POWER.UPDATE_EPS_OCP_STATE");
+        *pp_symbol_str_out = "DP.POWER.UPDATE_EPS_OCP_STATE";
         return true;
 
 
     /* DP.POWER.LAST_EPS_COMMAND */
     case 0xd40a:
-        *pp_symbol_str_out = strdup("DP.POWER.LAST_EPS_COMMAND");
+        *pp_symbol_str_out = "DP.POWER.LAST_EPS_COMMAND";
         return true;
 
 
     /* DP.POWER.NUM_CONSEC_FAILED_EPS_COMMANDS */
     case 0xd40b:
-        *pp_symbol_str_out = strdup("DP.POWER.NUM_CONSEC_FAILED_EPS_COMMANDS");
+        *pp_symbol_str_out = "DP.POWER.NUM_CONSEC_FAILED_EPS_COMMANDS";
         return true;
 
 
     /* DP.POWER.EPS_OCP_STATE_CORRECT */
     case 0xd40c:
-        *pp_symbol_str_out = strdup("DP.POWER.EPS_OCP_STATE_CORRECT");
+        *pp_symbol_str_out = "DP.POWER.EPS_OCP_STATE_CORRECT";
         return true;
 
 
     /* DP.POWER.OPMODE_CHANGE_IN_PROGRESS */
     case 0xd40d:
-        *pp_symbol_str_out = strdup("DP.POWER.OPMODE_CHANGE_IN_PROGRESS");
+        *pp_symbol_str_out = "DP.POWER.OPMODE_CHANGE_IN_PROGRESS";
         return true;
 
 
     /* DP.POWER.SEND_RESET_OCP_TC */
     case 0xd40e:
-        *pp_symbol_str_out = strdup("DP.POWER.SEND_RESET_OCP_TC");
+        *pp_symbol_str_out = "DP.POWER.SEND_RESET_OCP_TC";
         return true;
 
 
     /* DP.POWER.OCP_RAILS_TO_RESET */
     case 0xd40f:
-        *pp_symbol_str_out = strdup("DP.POWER.OCP_RAILS_TO_RESET");
+        *pp_symbol_str_out = "DP.POWER.OCP_RAILS_TO_RESET";
         return true;
 
 
     /* DP.POWER.SEND_BATT_TC */
     case 0xd410:
-        *pp_symbol_str_out = strdup("DP.POWER.SEND_BATT_TC");
+        *pp_symbol_str_out = "DP.POWER.SEND_BATT_TC";
         return true;
 
 
     /* DP.POWER.BATT_CMD_TO_SEND */
     case 0xd411:
-        *pp_symbol_str_out = strdup("DP.POWER.BATT_CMD_TO_SEND");
+        *pp_symbol_str_out = "DP.POWER.BATT_CMD_TO_SEND";
         return true;
 
 
     /* DP.OPMODEMANAGER.INITIALISED */
     case 0x2801:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.INITIALISED");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.INITIALISED";
         return true;
 
 
     /* DP.OPMODEMANAGER.ERROR */
     case 0x2802:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.ERROR");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.ERROR";
         return true;
 
 
     /* DP.OPMODEMANAGER.STATE */
     case 0x2803:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.STATE");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.STATE";
         return true;
 
 
     /* DP.OPMODEMANAGER.OPMODE */
     case 0x2804:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.OPMODE");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.OPMODE";
         return true;
 
 
     /* DP.OPMODEMANAGER.NEXT_OPMODE */
     case 0x2805:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.NEXT_OPMODE");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.NEXT_OPMODE";
         return true;
 
 
     /* DP.OPMODEMANAGER.TC_REQUEST_NEW_OPMODE */
     case 0x2806:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.TC_REQUEST_NEW_OPMODE");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.TC_REQUEST_NEW_OPMODE";
         return true;
 
 
     /* DP.OPMODEMANAGER.GRACE_TRANS_STATE */
     case 0x2807:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.GRACE_TRANS_STATE");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.GRACE_TRANS_STATE";
         return true;
 
 
     /* DP.OPMODEMANAGER.GRACE_TRANS_TIMEOUT_EVENT */
     case 0x2808:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.GRACE_TRANS_TIMEOUT_EVENT");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.GRACE_TRANS_TIMEOUT_EVENT";
         return true;
 
 
-    /* DP.OPMODEMANAGER.APP_IN_NEXT_MODE[OPMODEMANAGER_MAX_NUM_APPS_IN_MODE] */
+    /* DP.OPMODEMANAGER.APP_IN_NEXT_MODE */
     case 0x2809:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.APP_IN_NEXT_MODE[OPMODEMANAGER_MAX_NUM_APPS_IN_MODE]");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.APP_IN_NEXT_MODE";
         return true;
 
 
     /* DP.OPMODEMANAGER.BU_DWELL_TIMER_EVENT */
     case 0x280a:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.BU_DWELL_TIMER_EVENT");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.BU_DWELL_TIMER_EVENT";
         return true;
 
 
     /* DP.OPMODEMANAGER.BU_DWELL_CHECK_RTC */
     case 0x280b:
-        *pp_symbol_str_out = strdup("DP.OPMODEMANAGER.BU_DWELL_CHECK_RTC");
+        *pp_symbol_str_out = "DP.OPMODEMANAGER.BU_DWELL_CHECK_RTC";
         return true;
 
 
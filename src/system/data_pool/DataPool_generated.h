@@ -9,7 +9,7 @@
  * This file was generated from DataPool_struct.h by DataPool_generate.py.
  * 
  * @version Generated from DataPool_struct.h version 0.1
- * @date 2021-06-02
+ * @date 2026-10-17
  * 
  * @copyright Copyright (c) UoS3 2020
  */
@@ -27,6 +27,8 @@
 #include <string.h>
 
 /* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_dp_struct.h"
 #include "system/event_manager/EventManager_dp_struct.h"
 #include "system/mem_store_manager/MemStoreManager_dp_struct.h"
 #include "system/opmode_manager/OpModeManager_dp_struct.h"
@@ -52,9 +54,14 @@ typedef uint16_t DataPool_Id;
  */
 typedef enum _DataPool_DataType {
     DATAPOOL_DATATYPE_BOOL,
-    DATAPOOL_DATATYPE_ERROR,
+    DATAPOOL_DATATYPE_UINT32_T,
+    DATAPOOL_DATATYPE_UINT8_T,
+    DATAPOOL_DATATYPE_INT32_T,
+    DATAPOOL_DATATYPE_RTC_TIMESTAMP,
     DATAPOOL_DATATYPE_UINT16_T,
+    DATAPOOL_DATATYPE_ERROR,
     DATAPOOL_DATATYPE_SIZE_T,
+    DATAPOOL_DATATYPE_EVENT,
     DATAPOOL_DATATYPE_ERRORCODE,
     DATAPOOL_DATATYPE_IMU_STATE,
     DATAPOOL_DATATYPE_IMU_SUBSTATE,
@@ -63,11 +70,9 @@ typedef enum _DataPool_DataType {
     DATAPOOL_DATATYPE_IMU_VECUINT8,
     DATAPOOL_DATATYPE_INT16_T,
     DATAPOOL_DATATYPE_EPS_STATE,
-    DATAPOOL_DATATYPE_UINT8_T,
     DATAPOOL_DATATYPE_EPS_COMMANDSTATUS,
     DATAPOOL_DATATYPE_EPS_HKDATA,
     DATAPOOL_DATATYPE_EPS_OCPSTATE,
-    DATAPOOL_DATATYPE_EVENT,
     DATAPOOL_DATATYPE_POWER_LOWPOWERSTATUS,
     DATAPOOL_DATATYPE_EPS_UARTDATATYPE,
     DATAPOOL_DATATYPE_EPS_BATTCMD,
@@ -99,19 +104,19 @@ bool DataPool_get(
 );
 
 /**
- * @brief Fill a buffer with the symbol name of the DataPool parameter with the
- * given ID.
+ * @brief Get the symbol name of the DataPool parameter with the given ID.
  *
- * The caller is responsible for freeing the memory allocated for the symbol
- * string.
+ * The name is a constant string, so nothing is allocated and it mustn't be
+ * freed. Heap allocation through malloc() isn't available on the TM4C, see
+ * Kernel_malloc().
  *
  * @param id_in The ID of the DataPool parameter.
- * @param pp_symbol_str_out Pointer to the buffer to store the string in.
+ * @param pp_symbol_str_out Pointer to set to the symbol string.
  * @return bool True if successful, false if the ID is invalid.
  */
 bool DataPool_get_symbol_str(
     DataPool_Id id_in, 
-    char **pp_symbol_str_out
+    const char **pp_symbol_str_out
 );
 
 #endif /* H_DATAPOOL_GENERATED_H */
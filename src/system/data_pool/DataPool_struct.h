@@ -25,6 +25,8 @@
 #include <stdbool.h>
 
 /* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_dp_struct.h"
 #include "system/event_manager/EventManager_dp_struct.h"
 #include "system/mem_store_manager/MemStoreManager_dp_struct.h"
 #include "system/opmode_manager/OpModeManager_dp_struct.h"
@@ -70,6 +72,96 @@ typedef struct _DataPool {
      */
     bool RTC_INITIALISED;
 
+    /**
+     * @brief Number of debug logs dropped because the debug TX ring was full.
+     * 
+     * Note: This is located in the DataPool struct itself because Debug is a
+     * utility without its own module ID.
+     * 
+     * @dp 22
+     */
+    uint32_t DEBUG_NUM_DROPPED_LOGS;
+
+    /**
+     * @brief Most bytes waiting in the debug TX ring at once, which should be
+     * kept below DEBUG_TX_RING_SIZE to avoid dropping logs.
+     * 
+     * @dp 23
+     */
+    uint32_t DEBUG_TX_PEAK_BYTES;
+
+    /**
+     * @brief Modules which send all debug logs compiled into them, one bit
+     * per module number, which is the module ID shifted down by
+     * KERNEL_MOD_ID_SHIFT. Takes priority over DEBUG_QUIET_MODULES.
+     * 
+     * @dp 24
+     */
+    uint32_t DEBUG_VERBOSE_MODULES[DEBUG_MODULE_MASK_WORDS];
+
+    /**
+     * @brief Modules which only send error logs, one bit per module number.
+     * 
+     * @dp 25
+     */
+    uint32_t DEBUG_QUIET_MODULES[DEBUG_MODULE_MASK_WORDS];
+
+    /**
+     * @brief Number of debug logs not sent because their call site was
+     * repeating faster than the rate limit allows.
+     * 
+     * @dp 26
+     */
+    uint32_t DEBUG_NUM_SUPPRESSED_LOGS;
+
+    /**
+     * @brief Debug_CrashReason recovered from the crash log at boot, or
+     * DEBUG_CRASH_REASON_NONE if the last reset didn't store one.
+     * 
+     * @dp 27
+     */
+    uint8_t DEBUG_CRASH_REASON;
+
+    /**
+     * @brief Exit code recovered from the crash log, if the reason is
+     * DEBUG_CRASH_REASON_EXIT.
+     * 
+     * @dp 28
+     */
+    int32_t DEBUG_CRASH_CODE;
+
+    /**
+     * @brief Stacked register frame recovered from the crash log, if the
+     * reason is DEBUG_CRASH_REASON_FAULT, in the order of
+     * Debug_ContextStateFrame (r0-r3, r12, lr, return address, xpsr).
+     * 
+     * @dp 29
+     */
+    uint32_t DEBUG_CRASH_FRAME[DEBUG_CONTEXT_STATE_FRAME_WORDS];
+
+    /**
+     * @brief Number of bytes of DEBUG_CRASH_ERROR_BYTES recovered from the
+     * crash log.
+     * 
+     * @dp 30
+     */
+    uint8_t DEBUG_CRASH_ERROR_LENGTH;
+
+    /**
+     * @brief Error chain recovered from the crash log, as given by
+     * Kernel_error_to_bytes().
+     * 
+     * @dp 31
+     */
+    uint8_t DEBUG_CRASH_ERROR_BYTES[DEBUG_CRASH_LOG_MAX_ERROR_BYTES];
+
+    /**
+     * @brief DataPool parameters for the Kernel.
+     * 
+     * @dp_module Kernel
+     */
+    Kernel_Dp KERNEL;
+
     /**
      * @brief DataPool parameters for the event manager.
      * 
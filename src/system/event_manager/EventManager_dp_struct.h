@@ -62,16 +62,81 @@ typedef struct _EventManager_Dp {
     uint16_t NUM_RAISED_EVENTS;
 
     /**
-     * @brief The current size of the allocated event lists.
-     * 
-     * This value must be capable of storing the value of
-     * EVENTMANAGER_MAX_LIST_SIZE, which currently is 256. Therefore size_t,
-     * which is 32 bits on the TM4C, is sufficient.
+     * @brief The size of the statically allocated event lists, which is
+     * always EVENTMANAGER_LIST_SIZE.
      * 
      * @dp 5
      */
     size_t EVENT_LIST_SIZE;
 
+    /**
+     * @brief The total number of events raised from interrupts which were
+     * dropped because the ISR queue was full.
+     * 
+     * @dp 6
+     */
+    uint32_t NUM_ISR_EVENTS_DROPPED;
+
+    /**
+     * @brief The highest value NUM_RAISED_EVENTS has reached since the
+     * EventManager was initialised.
+     * 
+     * Used to tune EVENTMANAGER_MAX_RAISES_PER_EVENT (and therefore the size
+     * of the lists) from flight data.
+     * 
+     * @dp 7
+     */
+    uint16_t NUM_RAISED_EVENTS_HIGH_WATER;
+
+    /**
+     * @brief Histogram of the number of cycles between an event being raised
+     * and polled.
+     * 
+     * Bucket 0 counts events polled in the cycle they were raised in, and
+     * bucket n counts latencies of 2^(n-1) to 2^n - 1 cycles. The last bucket
+     * also counts all longer latencies. Only events matching LATENCY_EVENT
+     * are counted.
+     * 
+     * @dp 8
+     */
+    uint32_t LATENCY_CYCLES_HIST[EVENTMANAGER_LATENCY_CYCLES_NUM_BUCKETS];
+
+    /**
+     * @brief Histogram of the time in microseconds between an event being
+     * raised and polled.
+     * 
+     * Bucket 0 counts latencies under 1 us, and bucket n counts latencies of
+     * 2^(n-1) to 2^n - 1 us. The last bucket also counts all longer
+     * latencies. Only events matching LATENCY_EVENT are counted. The time is
+     * measured with the Rtc, so has a resolution of ~31 us, and is only
+     * measured once the Rtc is initialised.
+     * 
+     * @dp 9
+     */
+    uint32_t LATENCY_US_HIST[EVENTMANAGER_LATENCY_US_NUM_BUCKETS];
+
+    /**
+     * @brief The event whose latency is measured, or EVT_NONE to measure the
+     * latency of all events.
+     * 
+     * Set this to the event of a particular module to find out how long that
+     * module takes to respond. There is only one pair of histograms, so this
+     * selects what they measure rather than giving a latency per event.
+     * Changing it doesn't clear the histograms, so counts from before the
+     * change remain.
+     * 
+     * @dp 10
+     */
+    Event LATENCY_EVENT;
+
+    /**
+     * @brief The largest latency in microseconds measured since the
+     * EventManager was initialised.
+     * 
+     * @dp 11
+     */
+    uint32_t LATENCY_MAX_US;
+
 
 } EventManager_Dp;
 
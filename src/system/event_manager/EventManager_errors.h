@@ -35,12 +35,18 @@
 /**
  * @brief There was insufficient memory to increase the size of the event 
  * lists.
+ * 
+ * No longer raised since the lists are statically allocated, the code is
+ * kept so that it isn't reused.
  */
 #define EVENTMANAGER_ERROR_OUT_OF_MEMORY ((ErrorCode)MOD_ID_EVENTMANAGER | 2)
 
 /**
- * @brief A call to realloc() failed while trying to shrink the lists. This
- * indicates memory corruption. 
+ * @brief An allocation failed while trying to shrink the lists. This
+ * indicates memory corruption or heap exhaustion.
+ * 
+ * No longer raised since the lists are statically allocated, the code is
+ * kept so that it isn't reused.
  */
 #define EVENTMANAGER_ERROR_SHRINK_REALLOC_FAILED ((ErrorCode)MOD_ID_EVENTMANAGER | 3)
 
@@ -51,4 +57,61 @@
  */
 #define EVENTMANAGER_ERROR_NOT_INITIALISED  ((ErrorCode)MOD_ID_EVENTMANAGER | 4)
 
+/**
+ * @brief An attempt was made to raise EVT_NONE, which is reserved to mark
+ * empty slots in the event lists and cannot be raised.
+ */
+#define EVENTMANAGER_ERROR_RAISED_EVT_NONE ((ErrorCode)MOD_ID_EVENTMANAGER | 5)
+
+/**
+ * @brief The ISR queue was full when an interrupt raised an event, so one or
+ * more events were dropped. See DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED.
+ */
+#define EVENTMANAGER_ERROR_ISR_QUEUE_FULL ((ErrorCode)MOD_ID_EVENTMANAGER | 6)
+
+/**
+ * @brief An attempt was made to subscribe to EVT_NONE or with a NULL handler.
+ */
+#define EVENTMANAGER_ERROR_INVALID_SUBSCRIPTION ((ErrorCode)MOD_ID_EVENTMANAGER | 7)
+
+/**
+ * @brief The maximum number of subscriptions has been reached, increase
+ * EVENTMANAGER_MAX_SUBSCRIPTIONS.
+ */
+#define EVENTMANAGER_ERROR_MAX_SUBSCRIPTIONS_REACHED ((ErrorCode)MOD_ID_EVENTMANAGER | 8)
+
+/**
+ * @brief An attempt was made to enable coalescing of EVT_NONE.
+ */
+#define EVENTMANAGER_ERROR_INVALID_COALESCED_EVENT ((ErrorCode)MOD_ID_EVENTMANAGER | 9)
+
+/**
+ * @brief The maximum number of coalesced events has been reached, increase
+ * EVENTMANAGER_MAX_COALESCED_EVENTS.
+ */
+#define EVENTMANAGER_ERROR_MAX_COALESCED_EVENTS_REACHED ((ErrorCode)MOD_ID_EVENTMANAGER | 10)
+
+/**
+ * @brief EventManager_poll_set() was given more than
+ * EVENTMANAGER_MAX_POLL_SET_SIZE events.
+ */
+#define EVENTMANAGER_ERROR_POLL_SET_TOO_LARGE ((ErrorCode)MOD_ID_EVENTMANAGER | 11)
+
+/**
+ * @brief An attempt was made to delay EVT_NONE, or to delay an event by more
+ * than EVENTMANAGER_MAX_DELAY_MS.
+ */
+#define EVENTMANAGER_ERROR_INVALID_DELAYED_EVENT ((ErrorCode)MOD_ID_EVENTMANAGER | 12)
+
+/**
+ * @brief The delay queue was full, increase EVENTMANAGER_MAX_DELAYED_EVENTS.
+ */
+#define EVENTMANAGER_ERROR_MAX_DELAYED_EVENTS_REACHED ((ErrorCode)MOD_ID_EVENTMANAGER | 13)
+
+/**
+ * @brief An event was delayed by a number of milliseconds while the Rtc
+ * wasn't initialised, so the delay can't be measured.
+ */
+#define EVENTMANAGER_ERROR_RTC_NOT_INITIALISED ((ErrorCode)MOD_ID_EVENTMANAGER | 14)
+
 #endif /* H_EVENTMANAGER_ERRORS_H */
\ No newline at end of file
@@ -0,0 +1,154 @@
+'''
+---- GENERATE EVENTMANAGER CAPACITY ----
+
+This script counts the events defined in all `*_events.h` files and generates
+`EventManager_generated.h`, which sets the compile-time size of the
+EventManager's statically allocated event lists.
+
+Events are defined in the form:
+```
+#define EVT_MODULE_SOMETHING ((Event)(MOD_ID_MODULE | 1))
+```
+
+Every define starting with `EVT_` in an events file counts as one event. The
+list size is then the smallest power of two which can hold
+EVENTMANAGER_MAX_RAISES_PER_EVENT raises of every defined event without going
+over the maximum load factor. These three values are read from
+`EventManager_public.h` so that the C code remains the single definition of
+them.
+'''
+
+import os
+import re
+from datetime import datetime
+from pathlib import Path
+
+# DP.EVENTMANAGER.NUM_RAISED_EVENTS is a uint16_t, so the lists can't be any
+# larger than this
+NUM_RAISED_EVENTS_LIMIT = 32768
+
+# Pattern matching an event definition
+EVENT_DEFINE_PATTERN = re.compile(r'^\s*#define\s+(EVT_[A-Z0-9_]+)\s', re.M)
+
+def main():
+
+    print('Starting EventManager capacity generation')
+
+    # Get the root dir of OBC-Firmware
+    root_dir = Path(__file__).parent.absolute()
+    root_dir = root_dir.parent.parent.parent
+
+    # Change into src
+    src_dir = root_dir.joinpath('src')
+    os.chdir(src_dir)
+
+    # Read the sizing parameters from the public header
+    with open('system/event_manager/EventManager_public.h') as public_f:
+        public_text = public_f.read()
+    max_raises = get_define_int(
+        public_text,
+        'EVENTMANAGER_MAX_RAISES_PER_EVENT'
+    )
+    load_num = get_define_int(
+        public_text,
+        'EVENTMANAGER_MAX_LOAD_FACTOR_NUMERATOR'
+    )
+    load_den = get_define_int(
+        public_text,
+        'EVENTMANAGER_MAX_LOAD_FACTOR_DENOMINATOR'
+    )
+
+    # Find all defined events
+    events = get_defined_events(Path('.'))
+    print(f'Found {len(events)} defined events')
+
+    # Get the smallest power of two list size that can hold all raises at or
+    # below the maximum load factor
+    num_slots = len(events) * max_raises
+    list_size = 1
+    while list_size * load_num < num_slots * load_den:
+        list_size *= 2
+
+    print(f'EventManager list size is {list_size}')
+
+    # The number of raised events is stored in 16 bits in the DataPool
+    if list_size > NUM_RAISED_EVENTS_LIMIT:
+        raise RuntimeError(
+            f'List size {list_size} is too large, must be at most '
+            f'{NUM_RAISED_EVENTS_LIMIT}'
+        )
+
+    # Write the header out
+    with open('system/event_manager/EventManager_generated.h', 'w+') as f:
+        f.write(generate_header(len(events), list_size))
+
+def get_define_int(text, name):
+    '''
+    Get the integer value of a define of the form `#define NAME (value)`.
+    '''
+    match = re.search(rf'#define\s+{name}\s+\(?(\d+)\)?', text)
+    if match is None:
+        raise RuntimeError(f'Couldn\'t find the value of {name}')
+    return int(match.group(1))
+
+def get_defined_events(src_dir):
+    '''
+    Get a sorted list of the names of all events defined in `*_events.h` files
+    under the given directory.
+    '''
+    events = set()
+
+    for path in src_dir.glob('**/*_events.h'):
+        with open(path) as events_f:
+            events.update(EVENT_DEFINE_PATTERN.findall(events_f.read()))
+
+    return sorted(events)
+
+def generate_header(num_events, list_size):
+    '''
+    Generate the header file text.
+    '''
+
+    return \
+f'''/**
+ * @ingroup event_manager
+ *
+ * @file EventManager_generated.h
+ * @author Generated by EventManager_generate.py
+ * @brief Generated sizes of the EventManager's event lists.
+ *
+ * This file was generated from all *_events.h files by
+ * EventManager_generate.py.
+ *
+ * @version Generated
+ * @date {datetime.today().strftime('%Y-%m-%d')}
+ *
+ * @copyright Copyright (c) UoS3 2020
+ */
+
+#ifndef H_EVENTMANAGER_GENERATED_H
+#define H_EVENTMANAGER_GENERATED_H
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The number of events defined in all *_events.h files.
+ */
+#define EVENTMANAGER_NUM_DEFINED_EVENTS ({num_events})
+
+/**
+ * @brief The size of the EventManager's event lists.
+ *
+ * This is the smallest power of two that can hold
+ * EVENTMANAGER_MAX_RAISES_PER_EVENT raises of every defined event at or below
+ * the maximum load factor.
+ */
+#define EVENTMANAGER_LIST_SIZE ({list_size})
+
+#endif /* H_EVENTMANAGER_GENERATED_H */
+'''
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,38 @@
+/**
+ * @ingroup event_manager
+ *
+ * @file EventManager_generated.h
+ * @author Generated by EventManager_generate.py
+ * @brief Generated sizes of the EventManager's event lists.
+ *
+ * This file was generated from all *_events.h files by
+ * EventManager_generate.py.
+ *
+ * @version Generated
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) UoS3 2020
+ */
+
+#ifndef H_EVENTMANAGER_GENERATED_H
+#define H_EVENTMANAGER_GENERATED_H
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The number of events defined in all *_events.h files.
+ */
+#define EVENTMANAGER_NUM_DEFINED_EVENTS (66)
+
+/**
+ * @brief The size of the EventManager's event lists.
+ *
+ * This is the smallest power of two that can hold
+ * EVENTMANAGER_MAX_RAISES_PER_EVENT raises of every defined event at or below
+ * the maximum load factor.
+ */
+#define EVENTMANAGER_LIST_SIZE (256)
+
+#endif /* H_EVENTMANAGER_GENERATED_H */
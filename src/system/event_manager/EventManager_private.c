@@ -16,12 +16,15 @@
  * ------------------------------------------------------------------------- */
 
 /* Standard library includes */
-#include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 
 /* Internal includes */
 #include "util/debug/Debug_public.h"
 #include "system/data_pool/DataPool_public.h"
+#include "drivers/rtc/Rtc_public.h"
 #include "system/event_manager/EventManager_public.h"
 #include "system/event_manager/EventManager_private.h"
 
@@ -35,116 +38,400 @@ EventManager EVENTMANAGER;
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
 
-void EventManager_shrink_lists(void) {
-    /* Note: previously a check of DP.EVENTMANAGER.INITIALISED was made here,
-     * and an error return if it wasn't init. This has been removed to make
-     * this function infallible. Since EventManager is now counted as a
-     * critical module it shall be initialised before any other module could
-     * use this function */
-
-    Event *p_temp_raised_events;
-    uint8_t *p_temp_num_cycles_raised;
-
-    /* Check if the lists need to be shrunk */
-    if (
-        DP.EVENTMANAGER.NUM_RAISED_EVENTS * EVENTMANAGER_SHRINK_LIST_MULTIPLIER
-        <=
-        DP.EVENTMANAGER.EVENT_LIST_SIZE
+bool EventManager_raise_event_with_timestamp(
+    Event event_in, 
+    uint32_t timestamp_in
+) {
+    size_t idx;
+
+    /* EVT_NONE marks an empty slot so it can't be stored */
+    if (event_in == EVT_NONE) {
+        DEBUG_ERR("Cannot raise EVT_NONE");
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_RAISED_EVT_NONE;
+        return false;
+    }
+
+    /* If the event is coalesced and already raised count this raise against
+     * the existing entry rather than taking another slot. The entry's age is
+     * reset so that it isn't cleaned up straight after the latest raise, but
+     * the cycle count and timestamp of the first raise are kept so that both
+     * latencies are measured from the oldest unpolled raise.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * The raise count saturates rather than wrapping round to 0.
+     */
+    if (EventManager_find_coalesced_event(event_in, &idx)
+        &&
+        EventManager_find_event(event_in, &idx)
     ) {
-        /* Get new list size */
-        size_t new_list_size = 
-            DP.EVENTMANAGER.EVENT_LIST_SIZE 
-            / EVENTMANAGER_SHRUNK_LIST_SIZE_DIVISOR;
-
-        /* If the new size is less than the min size clamp to the min size.
-         * By preventing the lists getting too small the number of reallocs
-         * required is reduced. */
-        if (new_list_size < EVENTMANAGER_MIN_LIST_SIZE) {
-            new_list_size = EVENTMANAGER_MIN_LIST_SIZE;
+        if (EVENTMANAGER.raise_counts[idx] < UINT8_MAX) {
+            EVENTMANAGER.raise_counts[idx]++;
         }
+        EVENTMANAGER.event_ages[idx] = 0;
+        EventManager_trace(
+            EVENTMANAGER_TRACE_TYPE_RAISE, 
+            event_in, 
+            EVENTMANAGER.raise_counts[idx]
+        );
+        return true;
+    }
 
-        /* If a reallocation is required.
-         * This is done since the new list size could be clamped, and want to
-         * avoid reallocating to the same size. */
-        if (new_list_size != DP.EVENTMANAGER.EVENT_LIST_SIZE) {
-            /* Realloc the lists. We use temporary pointers so that if the
-             * realloc fails the original pointers will be left untouched.
-             * Failing to shrink the lists won't prevent further execution of
-             * the EM code, so we will simply inform FDIR of the failed
-             * attempt and leave the lists as they are. */
-            p_temp_raised_events = (Event *)realloc(
-                (void *)EVENTMANAGER.p_raised_events,
-                new_list_size * sizeof(Event)
-            );
-            p_temp_num_cycles_raised = (uint8_t *)realloc(
-                (void *)EVENTMANAGER.p_num_cycles_events_raised,
-                new_list_size * sizeof(uint8_t)
-            );
+    /* If the maximum number of events are raised error out. The lists must
+     * not be filled above this limit, see EVENTMANAGER_MAX_RAISED_EVENTS. */
+    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS >= EVENTMANAGER_MAX_RAISED_EVENTS) {
+        /* Debug log */
+        DEBUG_ERR("Maximum number of events reached");
+
+        /* Raise the error code and flag */
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_MAX_EVENTS_REACHED;
+        DP.EVENTMANAGER.MAX_EVENTS_REACHED = true;
+        return false;
+    }
+
+    /* Raise a new event */
+    EventManager_insert_event(event_in, timestamp_in);
+    EventManager_trace(EVENTMANAGER_TRACE_TYPE_RAISE, event_in, 1);
+
+    /* Increment number of events, tracking the most that have been raised */
+    DP.EVENTMANAGER.NUM_RAISED_EVENTS++;
+    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS 
+        > 
+        DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER
+    ) {
+        DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER 
+            = DP.EVENTMANAGER.NUM_RAISED_EVENTS;
+    }
 
-            /* Check reallocation failed */
-            if (
-                p_temp_raised_events == NULL
-                ||
-                p_temp_num_cycles_raised == NULL
-            ) {
-                /* Debug log */
-                DEBUG_ERR("Error reallocating memory for EVENTMANAGER");
-
-                /* Set the shrink realloc error and raise the error event */
-                DP.EVENTMANAGER.ERROR.code
-                    = EVENTMANAGER_ERROR_SHRINK_REALLOC_FAILED;
-                
-                /* TODO: inform FDIR of error here */
-            }
-            /* If it succeeded, move the pointers and update the new size of
-             * the lists */
-            else {
-                DEBUG_TRC(
-                    "EventManager list size increased to %lu", 
-                    new_list_size
-                );
-                EVENTMANAGER.p_raised_events = p_temp_raised_events;
-                EVENTMANAGER.p_num_cycles_events_raised 
-                    = p_temp_num_cycles_raised;
-                DP.EVENTMANAGER.EVENT_LIST_SIZE = new_list_size;
-            }
+    /* Return success */
+    return true;
+}
+
+size_t EventManager_hash(Event event_in) {
+    /* ---- NUMERICAL PROTECTION ----
+     * The multiplication is done in 32 bits and is intended to overflow, only
+     * the middle bits of the product are used. Masking by (list size - 1)
+     * keeps the index within the list as the list size is a power of two. */
+    return (size_t)(
+        ((uint32_t)event_in * (uint32_t)EVENTMANAGER_HASH_MULTIPLIER) >> 16
+    ) & (EVENTMANAGER_LIST_SIZE - 1);
+}
 
+bool EventManager_find_event(Event event_in, size_t *p_idx_out) {
+    size_t idx = EventManager_hash(event_in);
+
+    /* Follow the probe sequence until an empty slot is found. 
+     *
+     * ---- NUMERICAL PROTECTION ----
+     * The lists always have at least one empty slot (see
+     * EVENTMANAGER_MAX_RAISED_EVENTS), so this loop is guaranteed to end. */
+    while (EVENTMANAGER.raised_events[idx] != EVT_NONE) {
+        if (EVENTMANAGER.raised_events[idx] == event_in) {
+            *p_idx_out = idx;
+            return true;
         }
+        idx = (idx + 1) & (EVENTMANAGER_LIST_SIZE - 1);
     }
+
+    return false;
 }
 
-void EventManager_remove_stale_events(void) {
-    /* Allocate an array to store events that have gone stale (not been polled
-     * for 2 cycles ) and need to be removed */
-    Event *p_stale_events = (Event *)malloc(
-        DP.EVENTMANAGER.NUM_RAISED_EVENTS * sizeof(Event)
+bool EventManager_find_coalesced_event(Event event_in, size_t *p_idx_out) {
+    size_t low = 0;
+    size_t high = EVENTMANAGER.num_coalesced_events;
+    size_t mid;
+
+    /* Find the first coalesced event which is not less than event_in */
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        if (EVENTMANAGER.coalesced_events[mid] < event_in) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    *p_idx_out = low;
+    return (low < EVENTMANAGER.num_coalesced_events)
+        && 
+        (EVENTMANAGER.coalesced_events[low] == event_in);
+}
+
+void EventManager_insert_event(Event event_in, uint32_t timestamp_in) {
+    size_t idx = EventManager_hash(event_in);
+
+    /* Find the first empty slot in the probe sequence. The caller guarantees
+     * there is one. */
+    while (EVENTMANAGER.raised_events[idx] != EVT_NONE) {
+        idx = (idx + 1) & (EVENTMANAGER_LIST_SIZE - 1);
+    }
+
+    /* New events have been raised for zero cycles */
+    EVENTMANAGER.raised_events[idx] = event_in;
+    EVENTMANAGER.num_cycles_events_raised[idx] = 0;
+    EVENTMANAGER.event_ages[idx] = 0;
+    EVENTMANAGER.raise_counts[idx] = 1;
+    EVENTMANAGER.raise_timestamps[idx] = timestamp_in;
+}
+
+void EventManager_remove_event_at(size_t idx_in) {
+    size_t empty_idx = idx_in;
+    size_t idx = (idx_in + 1) & (EVENTMANAGER_LIST_SIZE - 1);
+    size_t home_idx;
+    bool can_move;
+
+    /* Walk the rest of the probe sequence and move back any event which
+     * wouldn't be found any more if the slot at empty_idx was left empty, i.e.
+     * any event whose home slot is not cyclically within (empty_idx, idx]. */
+    while (EVENTMANAGER.raised_events[idx] != EVT_NONE) {
+        home_idx = EventManager_hash(EVENTMANAGER.raised_events[idx]);
+
+        if (empty_idx <= idx) {
+            can_move = (home_idx <= empty_idx) || (home_idx > idx);
+        }
+        else {
+            can_move = (home_idx <= empty_idx) && (home_idx > idx);
+        }
+
+        if (can_move) {
+            EVENTMANAGER.raised_events[empty_idx] 
+                = EVENTMANAGER.raised_events[idx];
+            EVENTMANAGER.num_cycles_events_raised[empty_idx] 
+                = EVENTMANAGER.num_cycles_events_raised[idx];
+            EVENTMANAGER.event_ages[empty_idx] 
+                = EVENTMANAGER.event_ages[idx];
+            EVENTMANAGER.raise_counts[empty_idx] 
+                = EVENTMANAGER.raise_counts[idx];
+            EVENTMANAGER.raise_timestamps[empty_idx] 
+                = EVENTMANAGER.raise_timestamps[idx];
+            empty_idx = idx;
+        }
+
+        idx = (idx + 1) & (EVENTMANAGER_LIST_SIZE - 1);
+    }
+
+    /* Clear the final empty slot */
+    EVENTMANAGER.raised_events[empty_idx] = EVT_NONE;
+    EVENTMANAGER.num_cycles_events_raised[empty_idx] = 0;
+    EVENTMANAGER.event_ages[empty_idx] = 0;
+    EVENTMANAGER.raise_counts[empty_idx] = 0;
+    EVENTMANAGER.raise_timestamps[empty_idx] = 0;
+
+    /* Reduce the number of raised events by 1 */
+    DP.EVENTMANAGER.NUM_RAISED_EVENTS--;
+}
+
+uint32_t EventManager_get_timestamp(void) {
+    /* The RTC may not be initialised yet, since the EventManager is
+     * initialised first, in which case reading it could fault.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * Only the low 32 bits are returned. Differences between two timestamps
+     * are still correct when the counter wraps, as long as they are less than
+     * 2^32 ticks (~36 hours) apart.
+     */
+    if (!DP.RTC_INITIALISED) {
+        return 0;
+    }
+
+    return (uint32_t)Rtc_get_timestamp();
+}
+
+size_t EventManager_log2_bucket(uint32_t value_in, size_t num_buckets_in) {
+    size_t bucket = 0;
+
+    /* Bucket 0 holds 0, bucket n holds 2^(n-1) to 2^n - 1 */
+    while (value_in != 0 && bucket < (num_buckets_in - 1)) {
+        value_in >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+void EventManager_record_latency(size_t idx_in) {
+    Event event = EVENTMANAGER.raised_events[idx_in];
+    uint32_t ticks;
+    uint64_t latency_us_64;
+    uint32_t latency_us;
+    size_t bucket;
+
+    /* Only record the selected event, if there is one */
+    if (DP.EVENTMANAGER.LATENCY_EVENT != EVT_NONE 
+        && 
+        DP.EVENTMANAGER.LATENCY_EVENT != event
+    ) {
+        return;
+    }
+
+    /* ---- NUMERICAL PROTECTION ----
+     * Histogram counts saturate rather than wrapping round to 0. */
+    bucket = EventManager_log2_bucket(
+        EVENTMANAGER.num_cycles_events_raised[idx_in],
+        EVENTMANAGER_LATENCY_CYCLES_NUM_BUCKETS
+    );
+    if (DP.EVENTMANAGER.LATENCY_CYCLES_HIST[bucket] < UINT32_MAX) {
+        DP.EVENTMANAGER.LATENCY_CYCLES_HIST[bucket]++;
+    }
+
+    /* If the Rtc wasn't running when the event was raised the time isn't
+     * known */
+    if (EVENTMANAGER.raise_timestamps[idx_in] == 0 || !DP.RTC_INITIALISED) {
+        return;
+    }
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The difference is taken in 32 bits so is correct across a wrap of the
+     * timestamps. Converting to microseconds is done in 64 bits as the
+     * product overflows 32 bits for latencies over ~8 s, and the result is
+     * clamped to 32 bits.
+     */
+    ticks = EventManager_get_timestamp() - EVENTMANAGER.raise_timestamps[idx_in];
+    latency_us_64 = ((uint64_t)ticks * EVENTMANAGER_US_PER_RTC_TICK_NUMERATOR) 
+        / EVENTMANAGER_US_PER_RTC_TICK_DENOMINATOR;
+    latency_us = (latency_us_64 > UINT32_MAX) 
+        ? UINT32_MAX 
+        : (uint32_t)latency_us_64;
+
+    bucket = EventManager_log2_bucket(
+        latency_us, 
+        EVENTMANAGER_LATENCY_US_NUM_BUCKETS
     );
-    uint8_t stale_len = 0;
+    if (DP.EVENTMANAGER.LATENCY_US_HIST[bucket] < UINT32_MAX) {
+        DP.EVENTMANAGER.LATENCY_US_HIST[bucket]++;
+    }
+
+    if (latency_us > DP.EVENTMANAGER.LATENCY_MAX_US) {
+        DP.EVENTMANAGER.LATENCY_MAX_US = latency_us;
+    }
+}
+
+void EventManager_trace(
+    EventManager_TraceType type_in, 
+    Event event_in, 
+    uint8_t count_in
+) {
+    EventManager_TraceEntry *p_entry = &EVENTMANAGER.trace.entries[
+        EVENTMANAGER.trace.num_entries & (EVENTMANAGER_TRACE_SIZE - 1)
+    ];
+
+    /* Only the low 32 bits of the timestamp are kept, the decoder accounts
+     * for the wrap. */
+    p_entry->timestamp = EventManager_get_timestamp();
+    p_entry->event = event_in;
+    p_entry->type = (uint8_t)type_in;
+    p_entry->count = count_in;
+
+    EVENTMANAGER.trace.num_entries++;
+}
+
+void EventManager_remove_stale_events(void) {
+    size_t i = 0;
 
-    /* Loop through events */
-    for (uint8_t i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; i++) {
-        /* If the event has been raised for more than two cycles add it to the
-         * stale events array */
-        if (EVENTMANAGER.p_num_cycles_events_raised[i] 
+    /* Loop through the slots of the lists */
+    while (i < EVENTMANAGER_LIST_SIZE) {
+        /* If the event in this slot has been raised for more than two cycles
+         * remove it. Removing shifts the next event of the probe sequence
+         * into this slot, so the same slot is checked again rather than moving
+         * on. Any other event that is shifted either moves to a slot that is
+         * still to be checked, or wraps round from a slot that has already
+         * been checked, so no stale event is missed. */
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE
+            &&
+            EVENTMANAGER.event_ages[i] 
             >= 
             EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD
         ) {
-            p_stale_events[stale_len] = EVENTMANAGER.p_raised_events[i];
-            stale_len++;
+            DEBUG_TRC(
+                "Event 0x%04X was polled as part of cleanup", 
+                EVENTMANAGER.raised_events[i]
+            );
+            EventManager_trace(
+                EVENTMANAGER_TRACE_TYPE_CLEANUP,
+                EVENTMANAGER.raised_events[i],
+                EVENTMANAGER.raise_counts[i]
+            );
+            EventManager_remove_event_at(i);
+        }
+        else {
+            i++;
         }
     }
+}
 
-    /* If there are stale events poll them */
-    if (stale_len > 0) {
-        for (uint8_t i = 0; i < stale_len; i++) {
-            EventManager_poll_event(p_stale_events[i]);
-            DEBUG_TRC(
-                "Event 0x%04X was polled as part of cleanup", 
-                p_stale_events[i]
+bool EventManager_is_due_before(uint32_t a_in, uint32_t b_in) {
+    return (int32_t)(a_in - b_in) < 0;
+}
+
+bool EventManager_delay_event(
+    EventManager_DelayQueue *p_queue_inout,
+    Event event_in,
+    uint32_t due_in
+) {
+    size_t idx;
+
+    /* Check there's space for another delayed event */
+    if (p_queue_inout->num_entries >= EVENTMANAGER_MAX_DELAYED_EVENTS) {
+        DEBUG_ERR("Maximum number of delayed events reached");
+        DP.EVENTMANAGER.ERROR.code 
+            = EVENTMANAGER_ERROR_MAX_DELAYED_EVENTS_REACHED;
+        return false;
+    }
+
+    /* Find the insert position by stepping back from the end over all events
+     * which are due later, so that events due at the same time stay in the
+     * order they were delayed in */
+    idx = p_queue_inout->num_entries;
+    while (idx > 0 
+        && 
+        EventManager_is_due_before(due_in, p_queue_inout->entries[idx - 1].due)
+    ) {
+        idx--;
+    }
+
+    /* Shift the later events up and insert the new one */
+    memmove(
+        &p_queue_inout->entries[idx + 1],
+        &p_queue_inout->entries[idx],
+        (p_queue_inout->num_entries - idx) * sizeof(p_queue_inout->entries[0])
+    );
+    p_queue_inout->entries[idx].due = due_in;
+    p_queue_inout->entries[idx].event = event_in;
+    p_queue_inout->num_entries++;
+
+    return true;
+}
+
+void EventManager_raise_due_events(
+    EventManager_DelayQueue *p_queue_inout,
+    uint32_t now_in
+) {
+    size_t num_due = 0;
+
+    /* The queue is sorted so the due events are all at the start */
+    while (num_due < p_queue_inout->num_entries
+        &&
+        !EventManager_is_due_before(now_in, p_queue_inout->entries[num_due].due)
+    ) {
+        /* If raising fails the error has already been set, continue so that
+         * the event doesn't block the rest of the queue */
+        if (!EventManager_raise_event(p_queue_inout->entries[num_due].event)) {
+            DEBUG_ERR(
+                "Failed to raise delayed event 0x%04X", 
+                p_queue_inout->entries[num_due].event
             );
         }
+        num_due++;
     }
 
-    /* Free the stale events array */
-    free(p_stale_events);
+    /* Remove the raised events from the queue */
+    if (num_due > 0) {
+        memmove(
+            &p_queue_inout->entries[0],
+            &p_queue_inout->entries[num_due],
+            (p_queue_inout->num_entries - num_due) 
+                * sizeof(p_queue_inout->entries[0])
+        );
+        p_queue_inout->num_entries -= (uint8_t)num_due;
+    }
 }
@@ -14,6 +14,17 @@
 #ifndef H_EVENTMANAGER_PRIVATE_H
 #define H_EVENTMANAGER_PRIVATE_H
 
+/* -------------------------------------------------------------------------   
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Internal includes */
+#include "system/event_manager/EventManager_public.h"
 
 /* -------------------------------------------------------------------------   
  * GLOBALS
@@ -34,15 +45,156 @@ extern EventManager EVENTMANAGER;
  */
 #define EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD (2)
 
+/**
+ * @brief Multiplier used by EventManager_hash().
+ * 
+ * This is the 32 bit golden ratio constant used in Fibonacci (multiplicative)
+ * hashing. Event IDs are clustered in the low bits of each module's block, so
+ * multiplying by this spreads consecutive events across the whole table.
+ */
+#define EVENTMANAGER_HASH_MULTIPLIER (0x9E3779B1UL)
+
+/**
+ * @brief Numerator of the number of microseconds per Rtc tick.
+ * 
+ * The Rtc counts in 1/32768ths of a second, so one tick is 1000000/32768 =
+ * 15625/512 us.
+ */
+#define EVENTMANAGER_US_PER_RTC_TICK_NUMERATOR (15625ULL)
+
+/**
+ * @brief Denominator of the number of microseconds per Rtc tick, see
+ * EVENTMANAGER_US_PER_RTC_TICK_NUMERATOR.
+ */
+#define EVENTMANAGER_US_PER_RTC_TICK_DENOMINATOR (512ULL)
+
+/**
+ * @brief Number of Rtc ticks per second, used to convert delays in
+ * milliseconds to ticks.
+ */
+#define EVENTMANAGER_RTC_TICKS_PER_SEC (32768ULL)
+
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
 
 /**
- * @brief If the current number of raised events is less than 1/4 the allocated 
- * list size the lists shall be shrunk by 1/2.
+ * @brief Raise the given event, recording that it was raised at the given
+ * time.
+ * 
+ * Implements EventManager_raise_event(), which passes the current time, and
+ * is also used to raise the events from the ISR queue with the time at which
+ * the interrupt raised them.
+ * 
+ * @param event_in The event to raise.
+ * @param timestamp_in The low 32 bits of the Rtc_Timestamp of the raise, see
+ * EventManager_get_timestamp().
+ * @return true The event was successfully raised.
+ * @return false The event could not be raised.
+ */
+bool EventManager_raise_event_with_timestamp(
+    Event event_in, 
+    uint32_t timestamp_in
+);
+
+/**
+ * @brief Get the low 32 bits of the current Rtc_Timestamp, or 0 if the Rtc is
+ * not initialised.
+ * 
+ * Safe to call from interrupt context.
+ * 
+ * @return uint32_t The current timestamp.
+ */
+uint32_t EventManager_get_timestamp(void);
+
+/**
+ * @brief Get the log2 histogram bucket a value falls in.
+ * 
+ * Bucket 0 holds the value 0 and bucket n holds 2^(n-1) to 2^n - 1, with the
+ * last bucket holding all larger values.
+ * 
+ * @param value_in The value to find the bucket of.
+ * @param num_buckets_in The number of buckets in the histogram.
+ * @return size_t The index of the bucket.
+ */
+size_t EventManager_log2_bucket(uint32_t value_in, size_t num_buckets_in);
+
+/**
+ * @brief Record the latency of the event in the given slot in the DataPool
+ * histograms. Must be called just before the event is polled.
+ * 
+ * @param idx_in The index of the slot being polled.
+ */
+void EventManager_record_latency(size_t idx_in);
+
+/**
+ * @brief Get the home slot of an event in the lists.
+ * 
+ * @param event_in The event to hash.
+ * @return size_t The index of the home slot of the event.
+ */
+size_t EventManager_hash(Event event_in);
+
+/**
+ * @brief Find the slot of a raised event.
+ * 
+ * If the event has been raised more than once the first slot in the probe
+ * sequence is returned.
+ * 
+ * @param event_in The event to find.
+ * @param p_idx_out Pointer to the index of the event's slot, only set if the
+ * event is found.
+ * @return bool True if the event is raised, false otherwise.
+ */
+bool EventManager_find_event(Event event_in, size_t *p_idx_out);
+
+/**
+ * @brief Binary search the coalesced events for the given event.
+ * 
+ * @param event_in The event to find.
+ * @param p_idx_out Pointer to the index of the event in
+ * EVENTMANAGER.coalesced_events if it is found, or otherwise the index at
+ * which it would have to be inserted to keep the list sorted.
+ * @return bool True if coalescing is enabled for the event, false otherwise.
  */
-void EventManager_shrink_lists(void);
+bool EventManager_find_coalesced_event(Event event_in, size_t *p_idx_out);
+
+/**
+ * @brief Insert an event into the first free slot of its probe sequence, with
+ * a raise count of 1.
+ * 
+ * The caller must ensure there is at least one free slot in the lists. This
+ * function does not modify the DataPool.
+ * 
+ * @param event_in The event to insert.
+ * @param timestamp_in The time the event was raised at.
+ */
+void EventManager_insert_event(Event event_in, uint32_t timestamp_in);
+
+/**
+ * @brief Remove the event in the given slot.
+ * 
+ * The remaining events of the probe sequence are shifted back into the freed
+ * slot, so the table never contains tombstones. Decrements
+ * DP.EVENTMANAGER.NUM_RAISED_EVENTS.
+ * 
+ * @param idx_in The index of the slot to clear.
+ */
+void EventManager_remove_event_at(size_t idx_in);
+
+/**
+ * @brief Record an entry in the event trace ring, overwriting the oldest entry
+ * if the ring is full.
+ * 
+ * @param type_in The action to record.
+ * @param event_in The event the action was performed on.
+ * @param count_in The number of raises the action refers to.
+ */
+void EventManager_trace(
+    EventManager_TraceType type_in, 
+    Event event_in, 
+    uint8_t count_in
+);
 
 /**
  * @brief Remove stale events, i.e. those that have been raised for longer than
@@ -50,4 +202,44 @@ void EventManager_shrink_lists(void);
  */
 void EventManager_remove_stale_events(void);
 
+/**
+ * @brief Check whether due time a is before due time b.
+ * 
+ * ---- NUMERICAL PROTECTION ----
+ * Cycle counts and timestamps are free running, so they are compared by the
+ * sign of their difference, which is correct across a wrap as long as the
+ * two are less than 2^31 apart.
+ * 
+ * @param a_in The first due time.
+ * @param b_in The second due time.
+ * @return bool True if a_in is strictly before b_in.
+ */
+bool EventManager_is_due_before(uint32_t a_in, uint32_t b_in);
+
+/**
+ * @brief Add an event to a delay queue, keeping the queue sorted by due time.
+ * 
+ * @param p_queue_inout The queue to add the event to.
+ * @param event_in The event to delay.
+ * @param due_in The cycle count or timestamp at which the event is due.
+ * @return bool True if the event was added, false if the queue is full, in
+ * which case the error is set.
+ */
+bool EventManager_delay_event(
+    EventManager_DelayQueue *p_queue_inout,
+    Event event_in,
+    uint32_t due_in
+);
+
+/**
+ * @brief Raise and remove all events in a delay queue which are due.
+ * 
+ * @param p_queue_inout The queue to raise events from.
+ * @param now_in The current cycle count or timestamp.
+ */
+void EventManager_raise_due_events(
+    EventManager_DelayQueue *p_queue_inout,
+    uint32_t now_in
+);
+
 #endif /* H_EVENTMANAGER_PRIVATE_H */
\ No newline at end of file
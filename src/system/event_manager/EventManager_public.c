@@ -32,48 +32,37 @@
 #include "system/data_pool/DataPool_public.h"
 #include "system/event_manager/EventManager_public.h"
 #include "system/event_manager/EventManager_private.h"
+#ifdef TARGET_UNIX
+#include "drivers/replay/Replay_public.h"
+#endif
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
 
 bool EventManager_init(void) {
-    /* Zero the manager */
+    /* Zero the manager, which marks every slot of the lists as empty
+     * (EVT_NONE) and empties the ISR and delay queues. The lists are statically
+     * allocated so there is nothing else to set up. */
     memset(&EVENTMANAGER, 0, sizeof(EVENTMANAGER));
 
-    /* Allocate the lists to their minimum size
-     * 
-     * ---- NUMERICAL PROTECTION ----
-     * The multiplications below could result in an integer overflow. However
-     * the definition of EVENTMANAGER_MIN_LIST_SIZE shall ensure that the array
-     * is less than the overflow size of 32 bits.
-     */
-    EVENTMANAGER.p_raised_events = (Event *)malloc(
-        EVENTMANAGER_MIN_LIST_SIZE * sizeof(Event)
-    );
-    EVENTMANAGER.p_num_cycles_events_raised = (uint8_t *)malloc(
-        EVENTMANAGER_MIN_LIST_SIZE * sizeof(uint8_t)
-    );
-
-    /* Check allocation was successful */
-    if (
-        EVENTMANAGER.p_raised_events == NULL
-        ||
-        EVENTMANAGER.p_num_cycles_events_raised == NULL
-    ) {
-        /* Debug log */
-        DEBUG_ERR("Error allocating memory for EVENTMANAGER");
-
-        /* Since the event manager itself isn't allocated we just set the error
-         * code in the data pool and return false, rather than raising the
-         * eventmanager error event. */
-        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_OUT_OF_MEMORY;
-        return false;
-    }
-
     /* Set the size and counter members */
-    DP.EVENTMANAGER.EVENT_LIST_SIZE = EVENTMANAGER_MIN_LIST_SIZE;
+    DP.EVENTMANAGER.EVENT_LIST_SIZE = EVENTMANAGER_LIST_SIZE;
     DP.EVENTMANAGER.NUM_RAISED_EVENTS = 0;
+    DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER = 0;
+
+    /* Clear the latency measurements */
+    memset(
+        DP.EVENTMANAGER.LATENCY_CYCLES_HIST, 
+        0, 
+        sizeof(DP.EVENTMANAGER.LATENCY_CYCLES_HIST)
+    );
+    memset(
+        DP.EVENTMANAGER.LATENCY_US_HIST, 
+        0, 
+        sizeof(DP.EVENTMANAGER.LATENCY_US_HIST)
+    );
+    DP.EVENTMANAGER.LATENCY_MAX_US = 0;
 
     /* Set the initialised member */
     DP.EVENTMANAGER.INITIALISED = true;
@@ -85,20 +74,9 @@ bool EventManager_init(void) {
 void EventManager_destroy(void) {
     /* If the event manager is intiailised destroy it */
     if (DP.EVENTMANAGER.INITIALISED) {
-        /* Zero the manager's datapool. We do this before freeing the lists
-         * since an event could be raised by an interrupt, meaning that we
-         * could concievably free the list before setting the manager as
-         * uninitialised, which will cause a hard fault when the interrupt
-         * tries to raise an event using a free'd list (use after free). */
+        /* Zero the manager and its datapool */
         memset(&DP.EVENTMANAGER, 0, sizeof(DP.EVENTMANAGER));
-
-        /* Free the lists if not NULL */
-        if (EVENTMANAGER.p_raised_events != NULL) {
-            free(EVENTMANAGER.p_raised_events);
-        }
-        if (EVENTMANAGER.p_num_cycles_events_raised != NULL) {
-            free(EVENTMANAGER.p_num_cycles_events_raised);
-        }
+        memset(&EVENTMANAGER, 0, sizeof(EVENTMANAGER));
     }
     /* Otherwise warn that destroy was called twice */
     else {
@@ -111,103 +89,390 @@ void EventManager_destroy(void) {
 }
 
 bool EventManager_raise_event(Event event_in) {
-    Event *p_temp_raised_events;
-    uint8_t *p_temp_num_cycles_raised;
-
-    /* Raise event must be interrupt safe, as it could be called in an
-     * interrupt, therefore we disable interrupts for the duration of this 
-     * function
-     * 
-     * TODO: IS THIS NECESSARY??? */
-    Kernel_disable_interrupts();
-
-    DEBUG_TRC("EVENT: 0x%04X", event_in);
+    /* Note: this function is only called from the main loop, interrupts raise
+     * events through EventManager_raise_event_from_isr(). Therefore there is
+     * no need to disable interrupts here. */
 
     /* Note: previously a check of DP.EVENTMANAGER.INITIALISED was made here,
      * and an error return if it wasn't init. This has been removed since 
      * EventManager is counted as a critical module it shall be initialised 
      * before any other module could use this function */
 
-    /* Increase list size if the number of raised events has reached the
-     * current size of the list. */
-    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS 
-        >= 
-        DP.EVENTMANAGER.EVENT_LIST_SIZE - 1
-    ) {
+    return EventManager_raise_event_with_timestamp(
+        event_in, 
+        EventManager_get_timestamp()
+    );
+}
 
-        /* Calculate the new size of the list 
-         *
-         * ---- NUMERICAL PROTECTION ----
-         * This operation could cause EVENT_LIST_SIZE to overflow. Therefore
-         * the maximum list size must be set lower than the maximum value
-         * representable by EVENT_LIST_SIZE data type.
-         */
-        size_t new_list_size 
-            = DP.EVENTMANAGER.EVENT_LIST_SIZE 
-            * EVENTMANAGER_GROW_LIST_MULTIPLIER;
-
-        /* If the new size is greater than the max size raise an error */
-        if (new_list_size > EVENTMANAGER_MAX_LIST_SIZE) {
-            /* Debug log */
-            DEBUG_ERR("Maximum number of events reached");
-
-            /* Raise the error code and flag */
-            DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_MAX_EVENTS_REACHED;
-            DP.EVENTMANAGER.MAX_EVENTS_REACHED = true;
-            return false;
+bool EventManager_raise_event_from_isr(
+    EventManager_IsrSource source_in,
+    Event event_in
+) {
+    EventManager_IsrQueue *p_queue;
+    uint32_t head;
+    uint32_t tail;
+
+    /* EVT_NONE can't be raised, so don't put it in the queue. An invalid
+     * source has no queue, and as the DataPool must not be written from here
+     * the failure is only reported by the return value. */
+    if (event_in == EVT_NONE || source_in >= EVENTMANAGER_NUM_ISR_SOURCES) {
+        return false;
+    }
+
+    p_queue = &EVENTMANAGER.isr_queues[source_in];
+
+    /* The producer owns head, so it can be read without ordering. tail must
+     * be read with acquire ordering so that the consumer has finished reading
+     * a slot before it is overwritten here. */
+    head = __atomic_load_n(&p_queue->head, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&p_queue->tail, __ATOMIC_ACQUIRE);
+
+    /* If the queue is full count the dropped event. The error is raised by
+     * the main loop as the DataPool must not be written from here. 
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * head and tail are free running, so head - tail is the number of queued
+     * events even if head has wrapped and tail has not.
+     */
+    if (head - tail >= EVENTMANAGER_ISR_QUEUE_SIZE) {
+        __atomic_store_n(
+            &p_queue->num_dropped,
+            p_queue->num_dropped + 1,
+            __ATOMIC_RELAXED
+        );
+        return false;
+    }
+
+    /* Write the event and then publish it by advancing head. The release
+     * ordering ensures the event is written before the consumer sees it. */
+    p_queue->events[head & (EVENTMANAGER_ISR_QUEUE_SIZE - 1)] = event_in;
+    p_queue->timestamps[head & (EVENTMANAGER_ISR_QUEUE_SIZE - 1)] 
+        = EventManager_get_timestamp();
+    __atomic_store_n(&p_queue->head, head + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+void EventManager_process_isr_events(void) {
+    EventManager_IsrQueue *p_queue;
+    uint32_t tail;
+    uint32_t head;
+    uint32_t num_dropped = 0;
+    Event event;
+    uint32_t timestamp;
+
+    #ifdef TARGET_UNIX
+    Replay_start_cycle();
+    #endif
+
+    /* Raise all queued events, one source at a time. Events queued by
+     * interrupts while this loop runs will be left for the next cycle. */
+    for (size_t src = 0; src < EVENTMANAGER_NUM_ISR_SOURCES; ++src) {
+        p_queue = &EVENTMANAGER.isr_queues[src];
+        tail = __atomic_load_n(&p_queue->tail, __ATOMIC_RELAXED);
+        head = __atomic_load_n(&p_queue->head, __ATOMIC_ACQUIRE);
+
+        while (tail != head) {
+            event = p_queue->events[tail & (EVENTMANAGER_ISR_QUEUE_SIZE - 1)];
+            timestamp = p_queue->timestamps[
+                tail & (EVENTMANAGER_ISR_QUEUE_SIZE - 1)
+            ];
+
+            /* Free the slot, the release ordering ensures the event is read
+             * before the producer can overwrite it. */
+            tail++;
+            __atomic_store_n(&p_queue->tail, tail, __ATOMIC_RELEASE);
+
+            /* Record the event, or drop it if the recorded events are being
+             * replayed instead */
+            #ifdef TARGET_UNIX
+            if (!Replay_isr_event(event, timestamp)) {
+                continue;
+            }
+            #endif
+
+            /* If raising fails the error has already been set, so just
+             * continue so that the queue is always emptied. The event is
+             * raised with the time of the interrupt so that latency includes
+             * the time spent in the queue. */
+            if (!EventManager_raise_event_with_timestamp(event, timestamp)) {
+                DEBUG_ERR(
+                    "Failed to raise event 0x%04X from ISR queue",
+                    event
+                );
+            }
         }
 
-        /* Reallocate the lists. We use temporary values here so that if the
-         * realloc fails the original lists remain in place. A failure to
-         * reallocate here would actually prevent a new event being raised. The
-         * likelyhood of reallocation failing (i.e. running out of heap size)
-         * is very small, so instead of erroring out here we will instead raise
-         * an error for FDIR. */
-        p_temp_raised_events = (Event *)realloc(
-            (void *)EVENTMANAGER.p_raised_events, 
-            new_list_size * sizeof(Event)
+        /* ---- NUMERICAL PROTECTION ----
+         * The counts are free running, so the total wraps in the same way as
+         * DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED. */
+        num_dropped += __atomic_load_n(
+            &p_queue->num_dropped,
+            __ATOMIC_RELAXED
         );
-        p_temp_num_cycles_raised = (uint8_t *)realloc(
-            (void *)EVENTMANAGER.p_num_cycles_events_raised, 
-            new_list_size * sizeof(uint8_t)
+    }
+
+    #ifdef TARGET_UNIX
+    while (Replay_get_isr_event(&event, &timestamp)) {
+        if (!EventManager_raise_event_with_timestamp(event, timestamp)) {
+            DEBUG_ERR("Failed to raise replayed event 0x%04X", event);
+        }
+    }
+    #endif
+
+    /* Report any events the interrupts had to drop */
+    if (num_dropped != DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED) {
+        DEBUG_ERR(
+            "%lu events dropped from full ISR queues",
+            (unsigned long)(
+                num_dropped - DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED
+            )
         );
+        DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED = num_dropped;
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_ISR_QUEUE_FULL;
+    }
+}
 
-        /* Check reallocation failed */
-        if (
-            p_temp_raised_events == NULL
-            ||
-            p_temp_num_cycles_raised == NULL
+bool EventManager_is_isr_event_pending(void) {
+    EventManager_IsrQueue *p_queue;
+
+    for (size_t src = 0; src < EVENTMANAGER_NUM_ISR_SOURCES; ++src) {
+        p_queue = &EVENTMANAGER.isr_queues[src];
+        if (__atomic_load_n(&p_queue->head, __ATOMIC_ACQUIRE)
+            != 
+            __atomic_load_n(&p_queue->tail, __ATOMIC_RELAXED)
         ) {
-            /* Debug log */
-            DEBUG_ERR("Error reallocating memory for EVENTMANAGER");
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool EventManager_subscribe(Event event_in, EventManager_Handler handler_in) {
+    EventManager_Subscription *p_subs = EVENTMANAGER.subscriptions;
+    size_t idx;
+
+    /* Check the subscription is valid */
+    if (event_in == EVT_NONE || handler_in == NULL) {
+        DEBUG_ERR("Invalid subscription to event 0x%04X", event_in);
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_INVALID_SUBSCRIPTION;
+        return false;
+    }
 
-            /* Raise error code */
-            DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_OUT_OF_MEMORY;
-            return false;
+    /* Find the position to insert at, which keeps the subscriptions sorted by
+     * event. If this exact subscription already exists there's nothing to
+     * do. */
+    for (idx = 0; idx < EVENTMANAGER.num_subscriptions; ++idx) {
+        if (p_subs[idx].event == event_in 
+            && 
+            p_subs[idx].handler == handler_in
+        ) {
+            return true;
         }
-        /* Or if it succeeded, set the new pointers and list size */
-        else {
-            DEBUG_TRC("EventManager list size increased to %lu", new_list_size);
-            EVENTMANAGER.p_raised_events = p_temp_raised_events;
-            EVENTMANAGER.p_num_cycles_events_raised = p_temp_num_cycles_raised;
-            DP.EVENTMANAGER.EVENT_LIST_SIZE = new_list_size;
+        if (p_subs[idx].event > event_in) {
+            break;
         }
     }
 
-    /* Raise a new event */
-    EVENTMANAGER.p_raised_events[DP.EVENTMANAGER.NUM_RAISED_EVENTS] = event_in;
+    /* Check there's space for another subscription */
+    if (EVENTMANAGER.num_subscriptions >= EVENTMANAGER_MAX_SUBSCRIPTIONS) {
+        DEBUG_ERR("Maximum number of subscriptions reached");
+        DP.EVENTMANAGER.ERROR.code 
+            = EVENTMANAGER_ERROR_MAX_SUBSCRIPTIONS_REACHED;
+        return false;
+    }
 
-    /* Set number of cycles for this event to zero */
-    EVENTMANAGER.p_num_cycles_events_raised[DP.EVENTMANAGER.NUM_RAISED_EVENTS] 
-        = 0;
+    /* Shift the following subscriptions up and insert the new one */
+    memmove(
+        &p_subs[idx + 1], 
+        &p_subs[idx], 
+        (EVENTMANAGER.num_subscriptions - idx) * sizeof(p_subs[0])
+    );
+    p_subs[idx].event = event_in;
+    p_subs[idx].handler = handler_in;
+    EVENTMANAGER.num_subscriptions++;
 
-    /* Increment number of events */
-    DP.EVENTMANAGER.NUM_RAISED_EVENTS++;
+    return true;
+}
 
-    /* Reenable interrupts */
-    Kernel_enable_interrupts();
+void EventManager_dispatch_events(void) {
+    EventManager_Subscription *p_subs = EVENTMANAGER.subscriptions;
+    size_t i = 0;
+    size_t j;
+    Event event;
+
+    /* Subscriptions to the same event are next to each other, so step through
+     * them one event at a time */
+    while (i < EVENTMANAGER.num_subscriptions) {
+        event = p_subs[i].event;
+
+        /* Find the end of this event's subscriptions */
+        j = i;
+        while (j < EVENTMANAGER.num_subscriptions && p_subs[j].event == event) {
+            j++;
+        }
+
+        /* If the event was raised call all its handlers */
+        if (EventManager_poll_event(event)) {
+            for (; i < j; ++i) {
+                if (!p_subs[i].handler(event)) {
+                    DEBUG_ERR("Handler for event 0x%04X failed", event);
+                    /* TODO: register error with FDIR */
+                }
+            }
+        }
+
+        i = j;
+    }
+}
+
+bool EventManager_enable_coalescing(Event event_in) {
+    size_t idx;
+
+    /* EVT_NONE can't be raised so can't be coalesced */
+    if (event_in == EVT_NONE) {
+        DEBUG_ERR("Cannot coalesce EVT_NONE");
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_INVALID_COALESCED_EVENT;
+        return false;
+    }
+
+    /* If the event is already coalesced there's nothing to do */
+    if (EventManager_find_coalesced_event(event_in, &idx)) {
+        return true;
+    }
+
+    /* Check there's space for another coalesced event */
+    if (EVENTMANAGER.num_coalesced_events >= EVENTMANAGER_MAX_COALESCED_EVENTS) {
+        DEBUG_ERR("Maximum number of coalesced events reached");
+        DP.EVENTMANAGER.ERROR.code 
+            = EVENTMANAGER_ERROR_MAX_COALESCED_EVENTS_REACHED;
+        return false;
+    }
+
+    /* Shift the following events up and insert the new one, keeping the list
+     * sorted */
+    memmove(
+        &EVENTMANAGER.coalesced_events[idx + 1], 
+        &EVENTMANAGER.coalesced_events[idx], 
+        (EVENTMANAGER.num_coalesced_events - idx) 
+            * sizeof(EVENTMANAGER.coalesced_events[0])
+    );
+    EVENTMANAGER.coalesced_events[idx] = event_in;
+    EVENTMANAGER.num_coalesced_events++;
+
+    return true;
+}
+
+bool EventManager_raise_event_after_cycles(Event event_in, uint16_t cycles_in) {
+    /* EVT_NONE can't be raised so can't be delayed */
+    if (event_in == EVT_NONE) {
+        DEBUG_ERR("Cannot delay EVT_NONE");
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_INVALID_DELAYED_EVENT;
+        return false;
+    }
+
+    /* No delay, so just raise the event now */
+    if (cycles_in == 0) {
+        return EventManager_raise_event(event_in);
+    }
+
+    /* The event is raised when cleanup increments the cycle count to the due
+     * count, i.e. at the end of the cycle before the one it's due in.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * The delay is 16 bits, so is always less than the 2^31 limit of
+     * EventManager_is_due_before(), and the addition may safely wrap. */
+    return EventManager_delay_event(
+        &EVENTMANAGER.cycle_delay_queue,
+        event_in,
+        EVENTMANAGER.cycle_count + (uint32_t)cycles_in
+    );
+}
+
+bool EventManager_raise_event_after_ms(Event event_in, uint32_t ms_in) {
+    uint32_t delay_ticks;
+
+    /* Check the event and delay are valid */
+    if (event_in == EVT_NONE || ms_in > EVENTMANAGER_MAX_DELAY_MS) {
+        DEBUG_ERR(
+            "Cannot delay event 0x%04X by %lu ms", 
+            event_in, 
+            (unsigned long)ms_in
+        );
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_INVALID_DELAYED_EVENT;
+        return false;
+    }
+
+    /* No delay, so just raise the event now */
+    if (ms_in == 0) {
+        return EventManager_raise_event(event_in);
+    }
+
+    /* The delay is measured with the Rtc, so it must be running */
+    if (!DP.RTC_INITIALISED) {
+        DEBUG_ERR("Cannot delay event 0x%04X by time without the Rtc", event_in);
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_RTC_NOT_INITIALISED;
+        return false;
+    }
+
+    /* Convert the delay to Rtc ticks, rounding up so that the event is never
+     * raised early.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * The conversion is made in 64 bits, and as the delay is at most
+     * EVENTMANAGER_MAX_DELAY_MS the result fits in 31 bits. */
+    delay_ticks = (uint32_t)(
+        (((uint64_t)ms_in * EVENTMANAGER_RTC_TICKS_PER_SEC) + 999ULL) / 1000ULL
+    );
+
+    return EventManager_delay_event(
+        &EVENTMANAGER.time_delay_queue,
+        event_in,
+        EventManager_get_timestamp() + delay_ticks
+    );
+}
+
+bool EventManager_is_delayed_event_pending(void) {
+    return EVENTMANAGER.cycle_delay_queue.num_entries != 0
+        ||
+        EVENTMANAGER.time_delay_queue.num_entries != 0;
+}
+
+bool EventManager_is_cycle_delayed_event_pending(void) {
+    return EVENTMANAGER.cycle_delay_queue.num_entries != 0;
+}
+
+bool EventManager_get_next_delay_ms(uint32_t *p_ms_out) {
+    int32_t ticks;
+
+    if (EVENTMANAGER.time_delay_queue.num_entries == 0) {
+        return false;
+    }
+
+    /* The queue is kept in due order, so the first entry is the earliest.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * Due times are less than 2^31 ticks away (see
+     * EVENTMANAGER_MAX_DELAY_MS), so the signed difference is the time left,
+     * which is negative if the event is overdue. The conversion rounds up so
+     * that the wait never ends before the event is due, and as the delay is
+     * at most EVENTMANAGER_MAX_DELAY_MS it fits in 32 bits. */
+    ticks = (int32_t)(
+        EVENTMANAGER.time_delay_queue.entries[0].due
+        - EventManager_get_timestamp()
+    );
+    if (ticks <= 0) {
+        *p_ms_out = 0;
+    }
+    else {
+        *p_ms_out = (uint32_t)(
+            (((uint64_t)(uint32_t)ticks * 1000ULL) 
+                + (EVENTMANAGER_RTC_TICKS_PER_SEC - 1ULL))
+            / EVENTMANAGER_RTC_TICKS_PER_SEC
+        );
+    }
 
-    /* Return success */
     return true;
 }
 
@@ -218,22 +483,32 @@ bool EventManager_is_event_raised(Event event_in) {
      * critical module it shall be initialised before any other module could
      * use this function */
 
-    /* Set the default flag to false for checking if an event is raised */
-    bool is_raised = false;
-    
-    /* Check to see if the event is in the array of currently raised events */
-    int i;
-    for (i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; ++i) {
-        if (EVENTMANAGER.p_raised_events[i] == event_in) {
-            /* If the event to check is in the array of currently raised
-             * events, set the flag to true and exit here, no need to check
-             * other events */
-            is_raised = true;
-            break;
+    size_t event_idx;
+
+    /* EVT_NONE marks the empty slots so is never raised */
+    if (event_in == EVT_NONE) {
+        return false;
+    }
+
+    return EventManager_find_event(event_in, &event_idx);
+}
+
+bool EventManager_is_any_event_raised(
+    const Event *p_events_in, 
+    size_t num_events_in
+) {
+    /* If nothing is raised none of the set can be, so skip the lookups */
+    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < num_events_in; ++i) {
+        if (EventManager_is_event_raised(p_events_in[i])) {
+            return true;
         }
     }
 
-    return is_raised;
+    return false;
 }
 
 bool EventManager_clear_all_events(void) {
@@ -247,14 +522,32 @@ bool EventManager_clear_all_events(void) {
         return false;
     }
 
+    /* Empty every slot of the lists */
+    memset(
+        EVENTMANAGER.raised_events, 
+        0, 
+        sizeof(EVENTMANAGER.raised_events)
+    );
+    memset(
+        EVENTMANAGER.num_cycles_events_raised, 
+        0, 
+        sizeof(EVENTMANAGER.num_cycles_events_raised)
+    );
+    memset(
+        EVENTMANAGER.event_ages, 
+        0, 
+        sizeof(EVENTMANAGER.event_ages)
+    );
     memset(
-        EVENTMANAGER.p_raised_events, 
+        EVENTMANAGER.raise_counts, 
         0, 
-        DP.EVENTMANAGER.NUM_RAISED_EVENTS * sizeof(Event)
+        sizeof(EVENTMANAGER.raise_counts)
     );
-    
-    /* Shrink the lists */
-    EventManager_shrink_lists();
+    DP.EVENTMANAGER.NUM_RAISED_EVENTS = 0;
+
+    /* Cancel any delayed events */
+    EVENTMANAGER.cycle_delay_queue.num_entries = 0;
+    EVENTMANAGER.time_delay_queue.num_entries = 0;
 
     return true;
 }
@@ -266,55 +559,101 @@ bool EventManager_poll_event(Event event_in) {
      * critical module it shall be initialised before any other module could
      * use this function */
 
+    size_t event_idx;
+
     /* If the event isn't raised exit here */
-    if (!EventManager_is_event_raised(event_in)) {
+    if (event_in == EVT_NONE 
+        || 
+        !EventManager_find_event(event_in, &event_idx)
+    ) {
         return false;
     }
 
-    /* If the event was raised remove it from the list */
+    /* If the event was raised remove it from the lists */
+    EventManager_record_latency(event_idx);
+    EventManager_trace(
+        EVENTMANAGER_TRACE_TYPE_POLL, 
+        event_in, 
+        EVENTMANAGER.raise_counts[event_idx]
+    );
+    EventManager_remove_event_at(event_idx);
 
-    /* First have to find the position of the event in the list.
-     * 
-     * ---- NUMERICAL PROTECTION ----
-     * The event must be in the list since it is raised, so there is no
-     * need to check for the event not being in the list.
-     */
-    uint8_t event_idx = 0;
-    for (uint8_t i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; ++i) {
-        if (EVENTMANAGER.p_raised_events[i] == event_in) {
-            event_idx = i;
-            break;
+    return true;
+}
+
+uint32_t EventManager_poll_set(const Event *p_events_in, size_t num_events_in) {
+    uint32_t raised_mask = 0;
+
+    /* The result only has room for EVENTMANAGER_MAX_POLL_SET_SIZE events */
+    if (num_events_in > EVENTMANAGER_MAX_POLL_SET_SIZE) {
+        DEBUG_ERR(
+            "Cannot poll a set of %lu events", 
+            (unsigned long)num_events_in
+        );
+        DP.EVENTMANAGER.ERROR.code = EVENTMANAGER_ERROR_POLL_SET_TOO_LARGE;
+        return 0;
+    }
+
+    /* If nothing is raised none of the set can be, so skip the lookups */
+    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < num_events_in; ++i) {
+        if (EventManager_poll_event(p_events_in[i])) {
+            raised_mask |= ((uint32_t)1 << i);
         }
     }
 
-    /* Iterate through the list and move all events after the polled event
-     * to the left. This has to be done for both the events themsevles and
-     * the counters for the number of cycles each event has been raised. */
-    for (
-        uint8_t i = event_idx;
-        i < DP.EVENTMANAGER.NUM_RAISED_EVENTS;
-        ++i
-    ) {
-        /* Set the current value to the next value */
-        EVENTMANAGER.p_raised_events[i] 
-            = EVENTMANAGER.p_raised_events[i + 1];
-        EVENTMANAGER.p_num_cycles_events_raised[i]
-            = EVENTMANAGER.p_num_cycles_events_raised[i + 1];
+    return raised_mask;
+}
+
+bool EventManager_poll_any(const Event *p_events_in, size_t num_events_in) {
+    bool any_raised = false;
+
+    /* If nothing is raised none of the set can be, so skip the lookups */
+    if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0) {
+        return false;
     }
 
-    /* Set the final elements to 0 */
-    EVENTMANAGER.p_raised_events[DP.EVENTMANAGER.NUM_RAISED_EVENTS] = 0;
-    EVENTMANAGER.p_num_cycles_events_raised[
-        DP.EVENTMANAGER.NUM_RAISED_EVENTS
-    ] = 0;
+    /* Poll every event, rather than stopping at the first raised one, so that
+     * all matches are cleared */
+    for (size_t i = 0; i < num_events_in; ++i) {
+        any_raised |= EventManager_poll_event(p_events_in[i]);
+    }
 
-    /* Reduce the number of raised events by 1 */
-    DP.EVENTMANAGER.NUM_RAISED_EVENTS--;
+    return any_raised;
+}
 
-    /* Reduce the size of the lists if required by the new size */
-    EventManager_shrink_lists();
+uint16_t EventManager_poll_event_count(Event event_in) {
+    size_t event_idx;
+    uint32_t count = 0;
 
-    return true;
+    if (event_in == EVT_NONE) {
+        return 0;
+    }
+
+    /* Remove every entry of the event, summing their raise counts. A
+     * coalesced event only ever has one entry. */
+    while (EventManager_find_event(event_in, &event_idx)) {
+        count += EVENTMANAGER.raise_counts[event_idx];
+        EventManager_record_latency(event_idx);
+        EventManager_trace(
+            EVENTMANAGER_TRACE_TYPE_POLL, 
+            event_in, 
+            EVENTMANAGER.raise_counts[event_idx]
+        );
+        EventManager_remove_event_at(event_idx);
+    }
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The sum is made in 32 bits, which can't overflow as there are at most
+     * EVENTMANAGER_LIST_SIZE entries of at most UINT8_MAX raises each. */
+    if (count > UINT16_MAX) {
+        count = UINT16_MAX;
+    }
+
+    return (uint16_t)count;
 }
 
 void EventManager_cleanup_events(void) {
@@ -324,45 +663,125 @@ void EventManager_cleanup_events(void) {
      * critical module it shall be initialised before any other module could
      * use this function */
 
-    /* Loop through events */
-    for (uint8_t i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS; i++) {
+    /* Loop through the slots of the lists */
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; i++) {
         /* Increment the number of cycles for this event, as this function is
-         * to be called at the end of each cycle. */
-        EVENTMANAGER.p_num_cycles_events_raised[i]++;
+         * to be called at the end of each cycle. 
+         * 
+         * ---- NUMERICAL PROTECTION ----
+         * A coalesced event which keeps being raised is never cleaned up, so
+         * the cycles since its first raise saturate rather than wrapping. Its
+         * age is reset by every raise so can't reach the limit. */
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+            if (EVENTMANAGER.num_cycles_events_raised[i] < UINT8_MAX) {
+                EVENTMANAGER.num_cycles_events_raised[i]++;
+            }
+            EVENTMANAGER.event_ages[i]++;
+        }
     }
 
     /* Clean stale events */
     EventManager_remove_stale_events();
+
+    /* This cycle is complete, so raise the delayed events which are due, 
+     * after the stale events have been removed so that they are available for
+     * the whole of the next cycle */
+    EVENTMANAGER.cycle_count++;
+    EventManager_raise_due_events(
+        &EVENTMANAGER.cycle_delay_queue,
+        EVENTMANAGER.cycle_count
+    );
+    if (EVENTMANAGER.time_delay_queue.num_entries != 0) {
+        EventManager_raise_due_events(
+            &EVENTMANAGER.time_delay_queue,
+            EventManager_get_timestamp()
+        );
+    }
 }
 
-#ifdef DEBUG_MODE
-void EventManager_get_event_list_string(char **pp_str_out) {
-    /* Events will be listed like [0x0000, 0x0001, 0x0002], so the length to
-     * allocate for the string is 8*NUM_RAISED_EVENTS + 1 for the null byte */
-    *pp_str_out = (char *)malloc(
-        sizeof(char) * ((8 * (size_t)DP.EVENTMANAGER.NUM_RAISED_EVENTS) + 1)
+void EventManager_dump_trace(void) {
+    EventManager_Trace *p_trace = &EVENTMANAGER.trace;
+    uint32_t first;
+    EventManager_TraceEntry *p_entry;
+    /* Each byte is printed as 3 characters, plus the null byte */
+    char hex_str[(3 * sizeof(EventManager_TraceEntry)) + 1];
+
+    /* If the ring has wrapped the oldest entry is the one that will be
+     * overwritten next */
+    first = (p_trace->num_entries > EVENTMANAGER_TRACE_SIZE)
+        ? p_trace->num_entries - EVENTMANAGER_TRACE_SIZE
+        : 0;
+
+    DEBUG_INF(
+        "EVTTRACE BEGIN %lu %lu", 
+        (unsigned long)p_trace->num_entries,
+        (unsigned long)EVENTMANAGER_TRACE_SIZE
     );
-    /* Char buf for easy concat of the event IDs */
-    char buf[9] = {0};
 
-    /* Print the opening bracket */
-    sprintf(*pp_str_out, "[");
+    for (uint32_t i = first; i != p_trace->num_entries; ++i) {
+        p_entry = &p_trace->entries[i & (EVENTMANAGER_TRACE_SIZE - 1)];
+        hex_str[0] = '\0';
+        Debug_hex_string((uint8_t *)p_entry, hex_str, sizeof(*p_entry));
+        DEBUG_INF("EVTTRACE %s", hex_str);
+    }
+
+    DEBUG_INF("EVTTRACE END");
+}
 
-    /* Loop through all events except the last one */
-    for (int i = 0; i < DP.EVENTMANAGER.NUM_RAISED_EVENTS - 1; ++i) {
-        /* Format the event ID and concat with the string */
-        sprintf((char *)buf, "0x%04X, ", EVENTMANAGER.p_raised_events[i]);
-        strcat(*pp_str_out, (char *)buf);
+#ifdef DEBUG_MODE
+void EventManager_get_event_list_string(
+    char *p_str_out,
+    size_t length_in
+) {
+    size_t num_left = 0;
+    size_t used = 0;
+    size_t reserved;
+
+    /* ---- NUMERICAL PROTECTION ----
+     * Room is needed for at least "[...]" and the null byte */
+    if (length_in < 6) {
+        if (length_in > 0) {
+            p_str_out[0] = '\0';
+        }
+        return;
     }
 
-    /* Print the last one with the end bracket too */
-    sprintf(
-        (char *)buf, 
-        "0x%04X]", 
-        EVENTMANAGER.p_raised_events[DP.EVENTMANAGER.NUM_RAISED_EVENTS - 1]
-    );
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; ++i) {
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+            num_left++;
+        }
+    }
 
-    /* Concat the last one */
-    strcat(*pp_str_out, (char *)buf);
+    p_str_out[used++] = '[';
+
+    /* Loop through all occupied slots, separating the events with commas */
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; ++i) {
+        if (EVENTMANAGER.raised_events[i] == EVT_NONE) {
+            continue;
+        }
+        num_left--;
+
+        /* The last event only needs room for "]" and the null byte after it,
+         * the others also for the "..." shown if the list is cut short */
+        reserved = (num_left == 0) ? 2 : 5;
+
+        /* Each event is listed as ", 0x0000", without the comma for the
+         * first */
+        if (used + ((used == 1) ? 6 : 8) + reserved > length_in) {
+            memcpy(&p_str_out[used], "...", 3);
+            used += 3;
+            break;
+        }
+
+        used += (size_t)sprintf(
+            &p_str_out[used],
+            (used == 1) ? "0x%04X" : ", 0x%04X", 
+            EVENTMANAGER.raised_events[i]
+        );
+    }
+
+    /* Print the end bracket */
+    p_str_out[used++] = ']';
+    p_str_out[used] = '\0';
 }
-#endif
\ No newline at end of file
+#endif
@@ -13,6 +13,18 @@
  * - See if any events have been raised
  * - Clear events that have been raised
  * - Single global instance of the EventManager
+ * - Raise events from interrupt context without disabling interrupts, via a
+ *   queue which is drained by the main loop
+ * - Subscribe handler functions to events, which are called by the main loop
+ *   only when their event has been raised
+ * - Coalesce repeated raises of an event into a single entry with a raise
+ *   count, so that frequently raised events can't fill the event lists
+ * - Record raises, polls, and cleanups in a binary trace ring for post-mortem
+ *   analysis, decoded by src/tools/tool_event_trace.py
+ * - Measure the latency between raising and polling events, in cycles and
+ *   microseconds, as histograms in DP.EVENTMANAGER
+ * - Raise events after a delay of a number of cycles or milliseconds, so that
+ *   modules can wait without using a hardware timer or blocking the main loop
  * - Events raised for two or more cycles will be discarded. Events shall be
  *   cleared within two cycles so that unserviced event accumulation does not
  *   happen, and prevent exceeding the maximum number of raised events
@@ -36,68 +48,136 @@
  * ------------------------------------------------------------------------- */
 
 /* Standard library includes */
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 /* Internal includes */
 #include "system/event_manager/EventManager_events.h"
 #include "system/event_manager/EventManager_errors.h"
+#include "system/event_manager/EventManager_generated.h"
 
 /* -------------------------------------------------------------------------   
  * DEFINES
  * ------------------------------------------------------------------------- */
 
 /**
- * @brief The maximum size of the lists in the EventManager.
+ * @brief The number of times each defined event is expected to be raised at
+ * once, used to size the event lists.
  * 
- * Implicitly this is also the limit on the number of events that can be raised
- * at any one time.
+ * An event may be raised again before it is polled, for example by a periodic
+ * timer, and each raise occupies its own slot. Since unpolled events are
+ * removed after EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD cycles two raises per
+ * event gives headroom for this.
  * 
- * This value must be less than the maximum size representable by the
- * DP.EVENTMANAGER.EVENT_LIST_SIZE datatype. This is currently 16 bits, or
- * ~65k, so a value of 1024 will not lead to an overflow. See numerical
- * proection comment in EventManager_raise_event().
+ * This value is read by EventManager_generate.py, which sets
+ * EVENTMANAGER_LIST_SIZE in EventManager_generated.h.
+ */
+#define EVENTMANAGER_MAX_RAISES_PER_EVENT (2)
+
+/**
+ * @brief Numerator of the maximum load factor of the event lists.
+ * 
+ * Keeping the table at most 3/4 full keeps the probe sequences short, which is
+ * what makes raise, check, and poll constant time on average. Also read by
+ * EventManager_generate.py.
+ */
+#define EVENTMANAGER_MAX_LOAD_FACTOR_NUMERATOR (3)
+
+/**
+ * @brief Denominator of the maximum load factor of the event lists.
+ * 
+ * See EVENTMANAGER_MAX_LOAD_FACTOR_NUMERATOR.
+ */
+#define EVENTMANAGER_MAX_LOAD_FACTOR_DENOMINATOR (4)
+
+/**
+ * @brief The maximum number of events that can be raised at any one time.
+ * 
+ * This is the size of the lists at the maximum load factor. As the size is a
+ * power of two and the load factor is less than one there is always at least
+ * one empty slot, which is required to terminate probing.
+ * 
+ * ---- NUMERICAL PROTECTION ----
+ * EVENTMANAGER_LIST_SIZE must be less than the maximum value representable by
+ * DP.EVENTMANAGER.NUM_RAISED_EVENTS (16 bits), which is checked by
+ * EventManager_generate.py.
+ */
+#define EVENTMANAGER_MAX_RAISED_EVENTS \
+    ((EVENTMANAGER_LIST_SIZE * EVENTMANAGER_MAX_LOAD_FACTOR_NUMERATOR) \
+    / EVENTMANAGER_MAX_LOAD_FACTOR_DENOMINATOR)
+
+/**
+ * @brief The number of events that can be waiting in each ISR queue.
  * 
- * This value is set to 1024, or 1kB. src/link/tm4c123g.cmake specifies the
- * heap size of the system to be 8kB, therefore at it's worst the EventManager
- * could take up 1/8th the heap of the TM4C. It is not known if this is a
- * reasonable max size, as the full system is not yet functional, it is however
- * sufficiently large that memory allocation errors shall not be seen during
- * development. It may be larger than necessary, which could see reduction of
- * this at a future date.
+ * The interrupts of one EventManager_IsrSource that fire between two calls to
+ * EventManager_process_isr_events() must not raise more events than this,
+ * otherwise the extra events are dropped. Must be a power of two, so that the queue indices can be masked
+ * rather than wrapped.
+ */
+#define EVENTMANAGER_ISR_QUEUE_SIZE (32)
+
+/**
+ * @brief The maximum number of event subscriptions.
+ * 
+ * Each subscription is an (event, handler) pair, so a handler subscribed to
+ * two events uses two subscriptions.
+ */
+#define EVENTMANAGER_MAX_SUBSCRIPTIONS (32)
+
+/**
+ * @brief The maximum number of events which can have coalescing enabled.
  * 
- * TODO: The appropriate size of the EM shall be determined at the software
- * functional tests.
+ * See EventManager_enable_coalescing().
+ */
+#define EVENTMANAGER_MAX_COALESCED_EVENTS (32)
+
+/**
+ * @brief The maximum number of events that can be polled at once by
+ * EventManager_poll_set(), which is the number of bits in its result.
  */
-#define EVENTMANAGER_MAX_LIST_SIZE (1024)
+#define EVENTMANAGER_MAX_POLL_SET_SIZE (32)
 
 /**
- * @brief The minimum size of the lists in the EventManager.
+ * @brief The number of entries in the event trace ring.
+ * 
+ * Must be a power of two so that the ring index can be masked rather than
+ * wrapped. Each entry is 8 bytes.
  */
-#define EVENTMANAGER_MIN_LIST_SIZE (8)
+#define EVENTMANAGER_TRACE_SIZE (64)
 
 /**
- * @brief The multipler used to determine if the lists need to be shrunk.
+ * @brief Number of buckets in DP.EVENTMANAGER.LATENCY_CYCLES_HIST.
  * 
- * If (num raised events) * (this multiplier) <= (list size) then the lists 
- * will be shrunk.
+ * Events are removed once they are EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD
+ * cycles old, so only the first few buckets are normally used. The last
+ * bucket also catches coalesced events which are kept raised for longer.
  */
-#define EVENTMANAGER_SHRINK_LIST_MULTIPLIER (4)
+#define EVENTMANAGER_LATENCY_CYCLES_NUM_BUCKETS (4)
 
 /**
- * @brief The divisor to use to calculate the new size of the lists when
- * shrinking.
+ * @brief Number of buckets in DP.EVENTMANAGER.LATENCY_US_HIST.
  * 
- * The new shrunk list size will be (list size) / (this divisor).
+ * The last bucket counts all latencies over 2^18 us (~0.26 s).
+ */
+#define EVENTMANAGER_LATENCY_US_NUM_BUCKETS (20)
+
+/**
+ * @brief The number of events that can be waiting in each of the delay
+ * queues, see EventManager_raise_event_after_cycles() and
+ * EventManager_raise_event_after_ms().
  */
-#define EVENTMANAGER_SHRUNK_LIST_SIZE_DIVISOR (2)
+#define EVENTMANAGER_MAX_DELAYED_EVENTS (16)
 
 /**
- * @brief The multiplier used to grow the size of a list.
+ * @brief The longest delay that can be given to
+ * EventManager_raise_event_after_ms(), one hour.
  * 
- * The new list will be (list size) * (this multiplier) in size.
+ * ---- NUMERICAL PROTECTION ----
+ * Due times are compared as the signed difference of two 32 bit Rtc tick
+ * counts, so a delay must be less than 2^31 ticks (~18 hours).
  */
-#define EVENTMANAGER_GROW_LIST_MULTIPLIER (2)
+#define EVENTMANAGER_MAX_DELAY_MS (3600000UL)
 
 /**
  * @brief Reserved event code, corresponding to no event.
@@ -118,10 +198,221 @@
  */
 typedef uint16_t Event;
 
+/**
+ * @brief A function which handles a subscribed event.
+ * 
+ * @param event_in The event which was raised.
+ * @return bool True if the event was handled successfully, false otherwise.
+ * The handler is responsible for setting its own module's error code.
+ */
+typedef bool (*EventManager_Handler)(Event event_in);
+
+/**
+ * @brief The interrupt contexts which raise events, each of which has its own
+ * ISR queue.
+ * 
+ * Each queue has a single producer, so all the interrupt handlers of one
+ * source must never preempt each other. On the TM4C they must all be at the
+ * same NVIC priority, and on linux a signal handler must keep its own signal
+ * blocked while it runs (the default without SA_NODEFER) and must not be
+ * interrupted by another handler of the same source. Handlers of different
+ * sources may preempt each other freely.
+ */
+typedef enum _EventManager_IsrSource {
+    /**
+     * @brief The Timer interrupts, or the timer signal handler on linux.
+     */
+    EVENTMANAGER_ISR_SOURCE_TIMER = 0,
+
+    /**
+     * @brief The UART and uDMA interrupts of the UART driver.
+     */
+    EVENTMANAGER_ISR_SOURCE_UART = 1,
+
+    /**
+     * @brief The number of sources, not a valid source.
+     */
+    EVENTMANAGER_NUM_ISR_SOURCES
+} EventManager_IsrSource;
+
+/**
+ * @brief The action recorded by an event trace entry.
+ * 
+ * The values of this enum are part of the trace format read by
+ * tool_event_trace.py, so must not be changed.
+ */
+typedef enum _EventManager_TraceType {
+    /**
+     * @brief Unused trace entry.
+     */
+    EVENTMANAGER_TRACE_TYPE_NONE = 0,
+
+    /**
+     * @brief The event was raised. The count is the event's raise count after
+     * the raise, which is greater than 1 if the raise was coalesced.
+     */
+    EVENTMANAGER_TRACE_TYPE_RAISE = 1,
+
+    /**
+     * @brief The event was polled and cleared. The count is the number of
+     * raises cleared.
+     */
+    EVENTMANAGER_TRACE_TYPE_POLL = 2,
+
+    /**
+     * @brief The event was removed by cleanup as it was stale. The count is
+     * the number of raises removed.
+     */
+    EVENTMANAGER_TRACE_TYPE_CLEANUP = 3
+} EventManager_TraceType;
+
 /* -------------------------------------------------------------------------   
  * STRUCTS
  * ------------------------------------------------------------------------- */
 
+/**
+ * @brief A single entry of the event trace.
+ * 
+ * The entry is packed so that the ring can be read directly out of memory by
+ * a debugger and decoded on the host.
+ */
+typedef struct __attribute__((packed)) _EventManager_TraceEntry {
+    /**
+     * @brief The low 32 bits of the Rtc_Timestamp when the entry was
+     * recorded, or 0 if the Rtc wasn't initialised. Wraps every ~36 hours.
+     */
+    uint32_t timestamp;
+
+    /**
+     * @brief The event that the entry refers to.
+     */
+    Event event;
+
+    /**
+     * @brief The EventManager_TraceType of the entry.
+     */
+    uint8_t type;
+
+    /**
+     * @brief Number of raises the entry refers to, see
+     * EventManager_TraceType.
+     */
+    uint8_t count;
+} EventManager_TraceEntry;
+
+/**
+ * @brief Ring buffer of the most recent event trace entries.
+ * 
+ * Entries are only recorded from the main loop, so no synchronisation is
+ * needed. Once the ring is full the oldest entries are overwritten.
+ */
+typedef struct _EventManager_Trace {
+    /**
+     * @brief The trace entries, indexed by the number of entries masked by
+     * (EVENTMANAGER_TRACE_SIZE - 1).
+     */
+    EventManager_TraceEntry entries[EVENTMANAGER_TRACE_SIZE];
+
+    /**
+     * @brief Number of entries ever recorded. Free running, so the number of
+     * entries overwritten is known when the trace is decoded.
+     */
+    uint32_t num_entries;
+} EventManager_Trace;
+
+/**
+ * @brief A subscription of a handler to an event.
+ */
+typedef struct _EventManager_Subscription {
+    /**
+     * @brief The event subscribed to.
+     */
+    Event event;
+
+    /**
+     * @brief The function to call when the event is raised.
+     */
+    EventManager_Handler handler;
+} EventManager_Subscription;
+
+/**
+ * @brief Single-producer single-consumer queue of events raised in interrupt
+ * context.
+ * 
+ * There is one queue per EventManager_IsrSource. The interrupt handlers of
+ * the source are the only producer, and the main loop (through
+ * EventManager_process_isr_events()) is the only consumer.
+ * 
+ * head and tail are free running counters, so the number of queued events is
+ * always (head - tail), even when the counters wrap. Only the producer writes
+ * head and num_dropped, and only the consumer writes tail, so neither side
+ * ever needs to wait for or lock out the other.
+ */
+typedef struct _EventManager_IsrQueue {
+    /**
+     * @brief The queued events, indexed by the counters masked by
+     * (EVENTMANAGER_ISR_QUEUE_SIZE - 1).
+     */
+    Event events[EVENTMANAGER_ISR_QUEUE_SIZE];
+
+    /**
+     * @brief The low 32 bits of the Rtc_Timestamp at which each queued event
+     * was raised, so that latency is measured from the interrupt rather than
+     * from when the queue is processed. Indexed in the same way as events.
+     */
+    uint32_t timestamps[EVENTMANAGER_ISR_QUEUE_SIZE];
+
+    /**
+     * @brief Number of events ever pushed onto the queue.
+     */
+    volatile uint32_t head;
+
+    /**
+     * @brief Number of events ever popped from the queue.
+     */
+    volatile uint32_t tail;
+
+    /**
+     * @brief Number of events which have been dropped as the queue was full.
+     */
+    volatile uint32_t num_dropped;
+} EventManager_IsrQueue;
+
+/**
+ * @brief An event waiting in a delay queue.
+ */
+typedef struct _EventManager_DelayedEvent {
+    /**
+     * @brief The cycle count or low 32 bits of the Rtc_Timestamp at which the
+     * event is to be raised.
+     */
+    uint32_t due;
+
+    /**
+     * @brief The event to raise.
+     */
+    Event event;
+} EventManager_DelayedEvent;
+
+/**
+ * @brief Queue of events waiting to be raised, sorted by due time.
+ * 
+ * Events with the same due time are kept in the order they were delayed in,
+ * so they are raised in that order. The queue is only accessed from the main
+ * loop.
+ */
+typedef struct _EventManager_DelayQueue {
+    /**
+     * @brief The delayed events, earliest due first.
+     */
+    EventManager_DelayedEvent entries[EVENTMANAGER_MAX_DELAYED_EVENTS];
+
+    /**
+     * @brief The number of events in the queue.
+     */
+    uint8_t num_entries;
+} EventManager_DelayQueue;
+
 /**
  * @brief The EventManagerstructure.
  * 
@@ -129,28 +420,123 @@ typedef uint16_t Event;
  * code base. It provides a global interface for the raising, checking, and
  * polling of events via the EventManager_x functions.
  * 
- * List allocation strategy:
- *  - When the current number of raised events is 1 less than the size of the
- *    list the size of the lists will be doubled, unless this would exceed the
- *    maximum size of the list, in which case an error will occur.
- *  - When the current number of raised events is less than 1/4 of the size of
- *    the lists the lists will be shrunk to 1/2 their current size, unless this
- *    would make the list smaller than the minimum size.
+ * Event storage:
+ *  - The two lists form an open addressed hash table keyed on the 16 bit
+ *    Event. The home slot of an event is given by EventManager_hash(), and
+ *    collisions are resolved by linear probing.
+ *  - An empty slot is marked with EVT_NONE, which is why EVT_NONE can't be
+ *    raised.
+ *  - Each raise of an event occupies its own slot, so an event raised twice
+ *    must be polled twice, and each raise tracks its own cycle age.
+ *  - Events with coalescing enabled are the exception, a raise of one which
+ *    is already in the table increments its raise count rather than taking
+ *    another slot, so each coalesced event uses at most one slot.
+ *  - Polled events are removed by shifting the following entries of the probe
+ *    sequence back, so no tombstones are left behind and lookups never get
+ *    slower as events are raised and polled.
  * 
- * This is done to minimise the number of allocations/deallocs required when
- * raising or polling events.
+ * This gives constant average time raise, check, and poll, rather than a
+ * linear scan over all raised events.
+ * 
+ * List allocation strategy:
+ *  - The lists are statically allocated with EVENTMANAGER_LIST_SIZE slots,
+ *    which is generated from the number of defined events. No memory is
+ *    allocated at runtime, so the heap can't be fragmented and raising an
+ *    event never waits on the allocator.
+ *  - At most EVENTMANAGER_MAX_RAISED_EVENTS can be raised at once, after
+ *    which an error will occur. DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER
+ *    records the most events raised at once so that the size can be tuned
+ *    from flight data.
  */
 typedef struct _EventManager {
     /**
-     * @brief A pointer to the dynamically allocated list of raised events.
+     * @brief The hash table of raised events. Empty slots contain EVT_NONE.
+     */
+    Event raised_events[EVENTMANAGER_LIST_SIZE];
+
+    /**
+     * @brief The number of cycles that each event has been raised for, used
+     * to measure latency. For a coalesced event this counts from the first
+     * raise, in the same way as raise_timestamps.
+     * 
+     * Indexed in the same way as raised_events.
+     */
+    uint8_t num_cycles_events_raised[EVENTMANAGER_LIST_SIZE];
+
+    /**
+     * @brief The number of cycles since each event was last raised. Used in
+     * event clearup, so that a coalesced event which is raised again isn't
+     * removed straight after the latest raise.
+     * 
+     * Indexed in the same way as raised_events.
+     */
+    uint8_t event_ages[EVENTMANAGER_LIST_SIZE];
+
+    /**
+     * @brief The number of times that the event in each slot has been raised.
+     * Always 1 unless the event is coalesced.
+     * 
+     * Indexed in the same way as raised_events.
+     */
+    uint8_t raise_counts[EVENTMANAGER_LIST_SIZE];
+
+    /**
+     * @brief The low 32 bits of the Rtc_Timestamp at which the event in each
+     * slot was raised, used to measure latency. For a coalesced event this is
+     * the time of the first raise.
+     * 
+     * Indexed in the same way as raised_events.
+     */
+    uint32_t raise_timestamps[EVENTMANAGER_LIST_SIZE];
+
+    /**
+     * @brief Events raised from interrupt context, waiting to be moved into
+     * the lists by the main loop, indexed by EventManager_IsrSource.
+     */
+    EventManager_IsrQueue isr_queues[EVENTMANAGER_NUM_ISR_SOURCES];
+
+    /**
+     * @brief The event subscriptions, sorted by event so that all
+     * subscriptions to the same event are next to each other.
+     */
+    EventManager_Subscription subscriptions[EVENTMANAGER_MAX_SUBSCRIPTIONS];
+
+    /**
+     * @brief The number of subscriptions in use.
+     */
+    uint8_t num_subscriptions;
+
+    /**
+     * @brief The events which have coalescing enabled, sorted so that they can
+     * be binary searched when an event is raised.
+     */
+    Event coalesced_events[EVENTMANAGER_MAX_COALESCED_EVENTS];
+
+    /**
+     * @brief The number of events with coalescing enabled.
+     */
+    uint8_t num_coalesced_events;
+
+    /**
+     * @brief Trace of the most recent raises, polls, and cleanups.
+     */
+    EventManager_Trace trace;
+
+    /**
+     * @brief Number of times EventManager_cleanup_events() has been called,
+     * i.e. the number of completed cycles. Free running.
+     */
+    uint32_t cycle_count;
+
+    /**
+     * @brief Events waiting for a number of cycles, due at a cycle_count.
      */
-    Event *p_raised_events;
+    EventManager_DelayQueue cycle_delay_queue;
 
     /**
-     * @brief A pointer to the dynamically allocated list of the number of
-     * cycles that an event has been raised for. Used in event clearup.
+     * @brief Events waiting for a number of milliseconds, due at an Rtc tick.
      */
-    uint8_t *p_num_cycles_events_raised;
+    EventManager_DelayQueue time_delay_queue;
 } EventManager;
 
 /* -------------------------------------------------------------------------   
@@ -166,20 +552,188 @@ typedef struct _EventManager {
 bool EventManager_init(void);
 
 /**
- * @brief Destroy the event manager by deallocating all memory associated with
- * it.
+ * @brief Destroy the event manager, clearing all events and marking it as not
+ * initialised.
  */
 void EventManager_destroy(void);
 
 /**
  * @brief Raise the given event.
  * 
+ * EVT_NONE cannot be raised, attempting to do so will set the
+ * EVENTMANAGER_ERROR_RAISED_EVT_NONE error.
+ * 
+ * This function must only be called from the main loop, as it modifies the
+ * lists without disabling interrupts. Interrupt handlers must use
+ * EventManager_raise_event_from_isr() instead.
+ * 
  * @param event_in The event to raise.
  * @return true The event was successfully raised.
  * @return false The event could not be raised.
  */
 bool EventManager_raise_event(Event event_in);
 
+/**
+ * @brief Raise the given event from an interrupt handler (or signal handler on
+ * linux).
+ * 
+ * The event is pushed onto the ISR queue of the given source, and will be
+ * raised when the main loop next calls EventManager_process_isr_events().
+ * This function is wait free and doesn't disable interrupts, so its run time
+ * doesn't depend on the number of raised events.
+ * 
+ * Each queue has a single producer, so the handler must only give the source
+ * it belongs to, see EventManager_IsrSource for the rules on preemption.
+ * 
+ * If the queue is full the event is dropped and counted, the drop is reported
+ * by the next call to EventManager_process_isr_events().
+ * 
+ * @param source_in The interrupt context raising the event.
+ * @param event_in The event to raise.
+ * @return true The event was queued.
+ * @return false The queue was full, or the source or event was invalid.
+ */
+bool EventManager_raise_event_from_isr(
+    EventManager_IsrSource source_in,
+    Event event_in
+);
+
+/**
+ * @brief Raise all events that have been queued by interrupt handlers.
+ * 
+ * This function should be executed at the start of the software cycle, so
+ * that events raised in interrupts while the previous cycle ran (or while the
+ * processor was waiting for an interrupt) are available to all modules in
+ * this cycle.
+ * 
+ * If any queued events were dropped since the last call
+ * DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED is updated and the
+ * EVENTMANAGER_ERROR_ISR_QUEUE_FULL error is set.
+ */
+void EventManager_process_isr_events(void);
+
+/**
+ * @brief Check if there are events in any ISR queue which haven't been
+ * processed yet.
+ * 
+ * Used by the main loop to decide if it can wait for an interrupt.
+ * 
+ * @return bool True if there are queued events, false otherwise.
+ */
+bool EventManager_is_isr_event_pending(void);
+
+/**
+ * @brief Subscribe a handler to an event.
+ * 
+ * When the event is raised the handler will be called by
+ * EventManager_dispatch_events(), so the module doesn't need to poll for the
+ * event in its step function. Multiple handlers may subscribe to the same
+ * event, and subscribing the same handler to the same event twice has no
+ * effect.
+ * 
+ * Subscriptions are cleared by EventManager_init(), so modules should
+ * subscribe in their own init functions, or in their step function once the
+ * event is known, for instance after starting a timer.
+ * 
+ * @param event_in The event to subscribe to, must not be EVT_NONE.
+ * @param handler_in The function to call when the event is raised.
+ * @return bool True if subscribed, false on error.
+ */
+bool EventManager_subscribe(Event event_in, EventManager_Handler handler_in);
+
+/**
+ * @brief Call the handlers of all subscribed events which have been raised.
+ * 
+ * Each subscribed event which is raised is polled once, and every handler
+ * subscribed to it is called. If the event was raised more than once the
+ * remaining raises are dispatched in following cycles, unless the event is
+ * coalesced in which case all raises are dispatched at once. Events which
+ * have no subscribers are left for their modules to poll as normal.
+ * 
+ * This function should be executed once per cycle, after
+ * EventManager_process_isr_events().
+ */
+void EventManager_dispatch_events(void);
+
+/**
+ * @brief Enable coalescing of the given event.
+ * 
+ * While a coalesced event is raised and hasn't been polled, raising it again
+ * increments its raise count instead of adding another entry to the event
+ * lists. This caps the memory used by an event which may be raised many times
+ * before it is polled, such as a periodic timer. Polling a coalesced event
+ * clears all of its raises at once, use EventManager_poll_event_count() to
+ * find out how many there were.
+ * 
+ * Coalescing is cleared by EventManager_init(), so modules should enable it
+ * in their own init functions. Enabling it for an event twice has no effect.
+ * 
+ * @param event_in The event to coalesce, must not be EVT_NONE.
+ * @return bool True if coalescing is enabled, false on error.
+ */
+bool EventManager_enable_coalescing(Event event_in);
+
+/**
+ * @brief Raise the given event after a number of cycles.
+ * 
+ * The event is raised by EventManager_cleanup_events() at the end of the
+ * cycle before it is due, so that it is available to all modules in the
+ * cycle that is cycles_in after the current one. A delay of 1 therefore
+ * raises the event for the next cycle, and a delay of 0 raises it
+ * immediately.
+ * 
+ * @param event_in The event to raise, must not be EVT_NONE.
+ * @param cycles_in The number of cycles to wait.
+ * @return bool True if the event was delayed (or raised), false on error.
+ */
+bool EventManager_raise_event_after_cycles(Event event_in, uint16_t cycles_in);
+
+/**
+ * @brief Raise the given event after a number of milliseconds.
+ * 
+ * The delay is measured with the Rtc, which must be initialised. The event is
+ * raised by the first call to EventManager_cleanup_events() after the delay
+ * has elapsed, so the actual delay is rounded up to the end of a cycle. A
+ * delay of 0 raises the event immediately.
+ * 
+ * @param event_in The event to raise, must not be EVT_NONE.
+ * @param ms_in The number of milliseconds to wait, at most
+ * EVENTMANAGER_MAX_DELAY_MS.
+ * @return bool True if the event was delayed (or raised), false on error.
+ */
+bool EventManager_raise_event_after_ms(Event event_in, uint32_t ms_in);
+
+/**
+ * @brief Check if there are delayed events which haven't been raised yet.
+ * 
+ * @return bool True if there are delayed events, false otherwise.
+ */
+bool EventManager_is_delayed_event_pending(void);
+
+/**
+ * @brief Check if there are events delayed by a number of cycles which
+ * haven't been raised yet.
+ * 
+ * Used by the main loop to decide if it can wait for an interrupt, as these
+ * are raised by the main loop rather than an interrupt, so it must keep
+ * cycling until they are raised.
+ * 
+ * @return bool True if there are events delayed by cycles, false otherwise.
+ */
+bool EventManager_is_cycle_delayed_event_pending(void);
+
+/**
+ * @brief Get the time until the earliest event delayed by time is due.
+ * 
+ * Used by the main loop to set a timer to wake it when the event is due
+ * before waiting for an interrupt.
+ * 
+ * @param p_ms_out The number of milliseconds until the event is due, rounded
+ * up, or 0 if it is already due.
+ * @return bool True if an event is delayed by time, false otherwise.
+ */
+bool EventManager_get_next_delay_ms(uint32_t *p_ms_out);
+
 /**
  * @brief Check if an event has been raised. The event is not cleared if it is
  * raised. 
@@ -191,12 +745,29 @@ bool EventManager_raise_event(Event event_in);
  */
 bool EventManager_is_event_raised(Event event_in);
 
+/**
+ * @brief Check if any of a set of events has been raised, without clearing
+ * them.
+ * 
+ * This is the non-clearing counterpart of EventManager_poll_any(), used to
+ * decide whether a module has any work to do before stepping it.
+ * 
+ * @param p_events_in Array of the events to check.
+ * @param num_events_in Number of events in the array.
+ * @return bool True if any of the events are raised, false otherwise.
+ */
+bool EventManager_is_any_event_raised(
+    const Event *p_events_in, 
+    size_t num_events_in
+);
+
 /**
  * @brief Poll an event to see if it is raised. If the event is raised clear
  * it. 
  * 
  * Use EventManager_is_event_raised to check if an event is raised and not
- * clear it.
+ * clear it. If the event was raised more than once only one raise is cleared,
+ * unless the event is coalesced in which case all of its raises are cleared.
  * 
  * @param event_in The event to check.
  * @return bool true if raised, false if not.
@@ -204,7 +775,56 @@ bool EventManager_is_event_raised(Event event_in);
 bool EventManager_poll_event(Event event_in);
 
 /**
- * @brief Clear all the events in the manager.
+ * @brief Poll a set of events, clearing those that are raised.
+ * 
+ * This is equivalent to calling EventManager_poll_event() on each event of the
+ * set, but returns straight away if no events are raised, which is the case
+ * in most cycles, and saves a call per event otherwise. An event which
+ * appears in the set twice is polled twice.
+ * 
+ * @param p_events_in Array of the events to poll.
+ * @param num_events_in Number of events in the array, must be at most
+ * EVENTMANAGER_MAX_POLL_SET_SIZE.
+ * @return uint32_t Mask of the events that were raised, where bit i is set if
+ * p_events_in[i] was raised. 0 if none were raised or on error.
+ */
+uint32_t EventManager_poll_set(const Event *p_events_in, size_t num_events_in);
+
+/**
+ * @brief Poll a set of events, clearing those that are raised, and return
+ * whether any of them were raised.
+ * 
+ * Unlike EventManager_poll_set() the set may be any size.
+ * 
+ * @param p_events_in Array of the events to poll.
+ * @param num_events_in Number of events in the array.
+ * @return bool True if any of the events were raised, false otherwise.
+ */
+bool EventManager_poll_any(const Event *p_events_in, size_t num_events_in);
+
+/**
+ * @brief Poll an event, returning the number of times it has been raised since
+ * it was last polled, and clear it.
+ * 
+ * For a coalesced event this is its raise count, otherwise it is the number of
+ * entries the event has in the lists. Unlike EventManager_poll_event() all
+ * raises of the event are cleared.
+ * 
+ * ---- NUMERICAL PROTECTION ----
+ * The count saturates at UINT16_MAX. The raise count of a single coalesced
+ * entry saturates at UINT8_MAX, which can only be reached if the event is
+ * raised that many times without being polled, i.e. within 
+ * EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD cycles of its last raise.
+ * 
+ * @param event_in The event to poll.
+ * @return uint16_t The number of times the event was raised, 0 if it is not
+ * raised.
+ */
+uint16_t EventManager_poll_event_count(Event event_in);
+
+/**
+ * @brief Clear all the events in the manager, including delayed events which
+ * haven't been raised yet.
  * 
  * @return true All events were cleared.
  * @return false An error occured.
@@ -213,7 +833,8 @@ bool EventManager_clear_all_events(void);
 
 /**
  * @brief Clean up stale events (those that haven't been polled within a number
- * of cycles, see EventManager_remove_stale_events).
+ * of cycles, see EventManager_remove_stale_events), and raise the delayed
+ * events which are due.
  * 
  * This function should be executed at the end of the software cycle.
  * 
@@ -222,17 +843,35 @@ bool EventManager_clear_all_events(void);
  */
 void EventManager_cleanup_events(void);
 
+/**
+ * @brief Dump the event trace to the debug output, oldest entry first.
+ * 
+ * The trace is printed as a line containing "EVTTRACE BEGIN", followed by one
+ * "EVTTRACE" line per entry containing the entry's bytes in hex, and a final
+ * "EVTTRACE END" line. Capture the output and decode it with
+ * tool_event_trace.py.
+ * 
+ * Outside of DEBUG_MODE the debug output is disabled so nothing is printed,
+ * the trace can be read from EVENTMANAGER.trace with a debugger instead.
+ */
+void EventManager_dump_trace(void);
+
 #ifdef DEBUG_MODE
 /**
- * @brief Print a list of events into the given string pointer. 
+ * @brief Print the list of raised events into the given buffer.
  * 
- * The pointer will be allocated sufficient memory to store the entire list. 
- * The user must free the pointer after it has been used.
+ * The events are listed like "[0x0001, 0x0002]". Each event takes at most 8
+ * characters, so a buffer of 8 * DP.EVENTMANAGER.NUM_RAISED_EVENTS + 3 bytes
+ * holds the whole list. If the buffer is too short the list is cut short and
+ * ends with "...]" instead. Buffers shorter than 6 bytes are left empty.
  * 
- * @param pp_str_out Pointer to a char array to place the list into
- * @return bool True if successful, false otherwise.
+ * @param p_str_out Buffer to place the null terminated list into.
+ * @param length_in Length of the buffer in bytes.
  */
-void EventManager_get_event_list_string(char **pp_str_out);
+void EventManager_get_event_list_string(
+    char *p_str_out,
+    size_t length_in
+);
 #endif
 
 #endif /* H_EVENTMANAGER_PUBLIC_H */
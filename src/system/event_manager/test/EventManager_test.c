@@ -21,6 +21,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <string.h>
 
 /* External library includes */
 #include <cmocka.h>
@@ -31,6 +32,31 @@
 #include "system/event_manager/EventManager_public.h"
 #include "system/event_manager/EventManager_private.h"
 
+/* -------------------------------------------------------------------------   
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of times each test handler has been called.
+ */
+static int EVENTMANAGER_TEST_HANDLER_CALLS[2];
+
+/* -------------------------------------------------------------------------   
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+static bool EventManager_test_handler_a(Event event_in) {
+    (void) event_in;
+    EVENTMANAGER_TEST_HANDLER_CALLS[0]++;
+    return true;
+}
+
+static bool EventManager_test_handler_b(Event event_in) {
+    (void) event_in;
+    EVENTMANAGER_TEST_HANDLER_CALLS[1]++;
+    return true;
+}
+
 /* -------------------------------------------------------------------------   
  * TESTS
  * ------------------------------------------------------------------------- */
@@ -49,14 +75,10 @@ static void EventManager_test_init(void **state) {
     /* Check init flag is set */
     assert_true(DP.EVENTMANAGER.INITIALISED);
     
-    /* Check that all pointers in the EventManager static are non-null */
-    assert_non_null(EVENTMANAGER.p_raised_events);
-    assert_non_null(EVENTMANAGER.p_num_cycles_events_raised);
-
-    /* Check that the list size is the minimum size */
+    /* Check that the list size is the generated size */
     assert_int_equal(
         DP.EVENTMANAGER.EVENT_LIST_SIZE, 
-        EVENTMANAGER_MIN_LIST_SIZE
+        EVENTMANAGER_LIST_SIZE
     );
     
     /* Check there are no events */
@@ -71,19 +93,27 @@ static void EventManager_test_init(void **state) {
 static void EventManager_test_raise_event(void **state) {
     (void) state;
 
-    /* Raise 64 events, which will require expanding the event list */
+    /* Raise 64 events */
     for (int i = 1; i <= 64; i++) {
         assert_true(EventManager_raise_event((Event)i));
     }
 
     /* Check size and num of events */
     assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 64);
-    assert_int_equal(DP.EVENTMANAGER.EVENT_LIST_SIZE, 128);
+    assert_int_equal(DP.EVENTMANAGER.EVENT_LIST_SIZE, EVENTMANAGER_LIST_SIZE);
 
     /* Check all events are in the list */
-    for (int i = 0; i < 64; i++) {
-        assert_int_equal(EVENTMANAGER.p_raised_events[i], i + 1);
+    for (int i = 1; i <= 64; i++) {
+        assert_true(EventManager_is_event_raised((Event)i));
     }
+
+    /* Check that EVT_NONE can't be raised */
+    assert_false(EventManager_raise_event(EVT_NONE));
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_RAISED_EVT_NONE
+    );
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
 }
 
 /**
@@ -124,6 +154,33 @@ static void EventManager_test_poll_event(void **state) {
 
     /* Check that there are no events */
     assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 0);
+
+    /* Raise the same event twice and check it must be polled twice */
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_poll_event((Event)3));
+    assert_true(EventManager_is_event_raised((Event)3));
+    assert_true(EventManager_poll_event((Event)3));
+    assert_false(EventManager_is_event_raised((Event)3));
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 0);
+
+    /* Raise events from several modules, poll half of them, and check the
+     * other half can still be found */
+    for (int i = 1; i <= 32; i++) {
+        assert_true(EventManager_raise_event((Event)((i << 10) | i)));
+    }
+    for (int i = 1; i <= 32; i += 2) {
+        assert_true(EventManager_poll_event((Event)((i << 10) | i)));
+    }
+    for (int i = 1; i <= 32; i++) {
+        if (i % 2 == 0) {
+            assert_true(EventManager_is_event_raised((Event)((i << 10) | i)));
+        }
+        else {
+            assert_false(EventManager_is_event_raised((Event)((i << 10) | i)));
+        }
+    }
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 16);
 }
 
 /**
@@ -143,8 +200,8 @@ static void EventManager_test_cleanup_events(void **state) {
     assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 64);
 
     /* Check all cycle counters are zero */
-    for (int i = 0; i < 64; i++) {
-        assert_int_equal(EVENTMANAGER.p_num_cycles_events_raised[i], 0);
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; i++) {
+        assert_int_equal(EVENTMANAGER.num_cycles_events_raised[i], 0);
     }
 
     /* Call cleanup */
@@ -153,9 +210,11 @@ static void EventManager_test_cleanup_events(void **state) {
     /* Check there are still 64 events */
     assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 64);
 
-    /* Check all counters are one */
-    for (int i = 0; i < 64; i++) {
-        assert_int_equal(EVENTMANAGER.p_num_cycles_events_raised[i], 1);
+    /* Check all counters of occupied slots are one */
+    for (size_t i = 0; i < EVENTMANAGER_LIST_SIZE; i++) {
+        if (EVENTMANAGER.raised_events[i] != EVT_NONE) {
+            assert_int_equal(EVENTMANAGER.num_cycles_events_raised[i], 1);
+        }
     }
 
     /* Call cleanup */
@@ -165,6 +224,508 @@ static void EventManager_test_cleanup_events(void **state) {
     assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 0);
 }
 
+/**
+ * @brief Test that events raised from an ISR are queued until processed.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_isr_queue(void **state) {
+    (void) state;
+
+    /* Queue an event and check it isn't raised until processed */
+    assert_false(EventManager_is_isr_event_pending());
+    assert_true(
+        EventManager_raise_event_from_isr(EVENTMANAGER_ISR_SOURCE_TIMER, 1)
+    );
+    assert_true(EventManager_is_isr_event_pending());
+    assert_false(EventManager_is_event_raised((Event)1));
+
+    EventManager_process_isr_events();
+    assert_false(EventManager_is_isr_event_pending());
+    assert_true(EventManager_poll_event((Event)1));
+
+    /* Each source has its own queue */
+    assert_true(
+        EventManager_raise_event_from_isr(EVENTMANAGER_ISR_SOURCE_UART, 2)
+    );
+    assert_int_equal(
+        EVENTMANAGER.isr_queues[EVENTMANAGER_ISR_SOURCE_UART].head,
+        1
+    );
+    assert_int_equal(
+        EVENTMANAGER.isr_queues[EVENTMANAGER_ISR_SOURCE_TIMER].head,
+        1
+    );
+    assert_true(EventManager_is_isr_event_pending());
+    EventManager_process_isr_events();
+    assert_true(EventManager_poll_event((Event)2));
+
+    /* An invalid source has no queue */
+    assert_false(
+        EventManager_raise_event_from_isr(EVENTMANAGER_NUM_ISR_SOURCES, 1)
+    );
+    assert_false(EventManager_is_isr_event_pending());
+
+    /* Overfill one queue and check the extra events are dropped and
+     * reported, without affecting the other queue */
+    for (int i = 1; i <= EVENTMANAGER_ISR_QUEUE_SIZE; i++) {
+        assert_true(EventManager_raise_event_from_isr(
+            EVENTMANAGER_ISR_SOURCE_TIMER,
+            (Event)i
+        ));
+    }
+    assert_false(
+        EventManager_raise_event_from_isr(EVENTMANAGER_ISR_SOURCE_TIMER, 0x100)
+    );
+    assert_false(
+        EventManager_raise_event_from_isr(EVENTMANAGER_ISR_SOURCE_TIMER, 0x101)
+    );
+    assert_true(
+        EventManager_raise_event_from_isr(EVENTMANAGER_ISR_SOURCE_UART, 0x102)
+    );
+
+    EventManager_process_isr_events();
+    assert_int_equal(
+        DP.EVENTMANAGER.NUM_RAISED_EVENTS, 
+        EVENTMANAGER_ISR_QUEUE_SIZE + 1
+    );
+    assert_int_equal(DP.EVENTMANAGER.NUM_ISR_EVENTS_DROPPED, 2);
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_ISR_QUEUE_FULL
+    );
+    assert_false(EventManager_is_event_raised((Event)0x100));
+    assert_true(EventManager_is_event_raised((Event)0x102));
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+}
+
+/**
+ * @brief Test that subscribed handlers are only called when their event is
+ * raised.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_subscribe(void **state) {
+    (void) state;
+
+    EVENTMANAGER_TEST_HANDLER_CALLS[0] = 0;
+    EVENTMANAGER_TEST_HANDLER_CALLS[1] = 0;
+
+    /* Subscribe both handlers to event 2, and handler a to event 1 */
+    assert_true(EventManager_subscribe((Event)2, EventManager_test_handler_a));
+    assert_true(EventManager_subscribe((Event)1, EventManager_test_handler_a));
+    assert_true(EventManager_subscribe((Event)2, EventManager_test_handler_b));
+
+    /* Subscribing twice has no effect */
+    assert_true(EventManager_subscribe((Event)2, EventManager_test_handler_b));
+    assert_int_equal(EVENTMANAGER.num_subscriptions, 3);
+
+    /* Invalid subscriptions fail */
+    assert_false(EventManager_subscribe(EVT_NONE, EventManager_test_handler_a));
+    assert_false(EventManager_subscribe((Event)1, NULL));
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+
+    /* Dispatching with no events raised calls nothing */
+    EventManager_dispatch_events();
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[0], 0);
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[1], 0);
+
+    /* Raise event 2 and an unsubscribed event, only event 2 is dispatched */
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_raise_event((Event)3));
+    EventManager_dispatch_events();
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[0], 1);
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[1], 1);
+    assert_false(EventManager_is_event_raised((Event)2));
+    assert_true(EventManager_is_event_raised((Event)3));
+
+    /* Raise event 1 */
+    assert_true(EventManager_raise_event((Event)1));
+    EventManager_dispatch_events();
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[0], 2);
+    assert_int_equal(EVENTMANAGER_TEST_HANDLER_CALLS[1], 1);
+}
+
+/**
+ * @brief Test that coalesced events only take one slot, and that
+ * EventManager_poll_event_count() returns all raises.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_coalescing(void **state) {
+    (void) state;
+
+    /* Enable coalescing out of order, the list is kept sorted */
+    assert_true(EventManager_enable_coalescing((Event)3));
+    assert_true(EventManager_enable_coalescing((Event)1));
+    assert_true(EventManager_enable_coalescing((Event)1));
+    assert_int_equal(EVENTMANAGER.num_coalesced_events, 2);
+    assert_int_equal(EVENTMANAGER.coalesced_events[0], 1);
+    assert_int_equal(EVENTMANAGER.coalesced_events[1], 3);
+    assert_false(EventManager_enable_coalescing(EVT_NONE));
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+
+    /* Repeat raises of a coalesced event use one slot */
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)1));
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 1);
+    assert_int_equal(EventManager_poll_event_count((Event)1), 3);
+    assert_false(EventManager_is_event_raised((Event)1));
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 0);
+
+    /* Polling a coalesced event clears all its raises */
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_poll_event((Event)3));
+    assert_false(EventManager_poll_event((Event)3));
+
+    /* Uncoalesced events are still counted, one slot per raise */
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_raise_event((Event)2));
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 2);
+    assert_int_equal(EventManager_poll_event_count((Event)2), 2);
+    assert_int_equal(EventManager_poll_event_count((Event)2), 0);
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 0);
+
+    /* A repeat raise resets the age, so the entry survives cleanup */
+    assert_true(EventManager_raise_event((Event)1));
+    EventManager_cleanup_events();
+    assert_true(EventManager_raise_event((Event)1));
+    EventManager_cleanup_events();
+    assert_int_equal(EventManager_poll_event_count((Event)1), 2);
+
+    /* The raise count saturates */
+    for (int i = 0; i < 300; ++i) {
+        assert_true(EventManager_raise_event((Event)1));
+    }
+    assert_int_equal(EventManager_poll_event_count((Event)1), UINT8_MAX);
+}
+
+/**
+ * @brief Test polling sets of events.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_poll_set(void **state) {
+    (void) state;
+
+    Event set[4] = {(Event)1, (Event)2, (Event)3, (Event)1};
+    Event too_large[EVENTMANAGER_MAX_POLL_SET_SIZE + 1] = {0};
+
+    /* Nothing raised */
+    assert_int_equal(EventManager_poll_set(set, 4), 0);
+    assert_false(EventManager_poll_any(set, 4));
+
+    /* Raise some of the set and an event outside it, only the set's events
+     * are cleared. Event 1 is in the set twice so both raises are polled. */
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_raise_event((Event)4));
+    assert_int_equal(
+        EventManager_poll_set(set, 4), 
+        (1 << 0) | (1 << 2) | (1 << 3)
+    );
+    assert_int_equal(DP.EVENTMANAGER.NUM_RAISED_EVENTS, 1);
+    assert_true(EventManager_is_event_raised((Event)4));
+
+    /* is_any_event_raised checks the set without clearing it */
+    assert_false(EventManager_is_any_event_raised(set, 3));
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_raise_event((Event)3));
+    assert_true(EventManager_is_any_event_raised(set, 3));
+    assert_true(EventManager_is_event_raised((Event)2));
+
+    /* poll_any clears all matches, not just the first */
+    assert_true(EventManager_poll_any(set, 3));
+    assert_false(EventManager_is_event_raised((Event)2));
+    assert_false(EventManager_is_event_raised((Event)3));
+    assert_false(EventManager_poll_any(set, 3));
+
+    /* Sets larger than the result mask are rejected */
+    assert_int_equal(
+        EventManager_poll_set(too_large, EVENTMANAGER_MAX_POLL_SET_SIZE + 1), 
+        0
+    );
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_POLL_SET_TOO_LARGE
+    );
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+}
+
+/**
+ * @brief Test that raises, polls, and cleanups are recorded in the trace.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_trace(void **state) {
+    (void) state;
+
+    EventManager_TraceEntry *p_entries = EVENTMANAGER.trace.entries;
+
+    assert_int_equal(EVENTMANAGER.trace.num_entries, 0);
+
+    /* Raise, coalesce, poll, and clean up */
+    assert_true(EventManager_enable_coalescing((Event)2));
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_poll_event((Event)2));
+    EventManager_cleanup_events();
+    EventManager_cleanup_events();
+    assert_int_equal(EVENTMANAGER.trace.num_entries, 5);
+
+    assert_int_equal(p_entries[0].type, EVENTMANAGER_TRACE_TYPE_RAISE);
+    assert_int_equal(p_entries[0].event, 1);
+    assert_int_equal(p_entries[0].count, 1);
+    assert_int_equal(p_entries[2].type, EVENTMANAGER_TRACE_TYPE_RAISE);
+    assert_int_equal(p_entries[2].event, 2);
+    assert_int_equal(p_entries[2].count, 2);
+    assert_int_equal(p_entries[3].type, EVENTMANAGER_TRACE_TYPE_POLL);
+    assert_int_equal(p_entries[3].event, 2);
+    assert_int_equal(p_entries[3].count, 2);
+    assert_int_equal(p_entries[4].type, EVENTMANAGER_TRACE_TYPE_CLEANUP);
+    assert_int_equal(p_entries[4].event, 1);
+
+    /* The ring overwrites the oldest entries once full */
+    for (size_t i = 0; i < EVENTMANAGER_TRACE_SIZE; ++i) {
+        assert_true(EventManager_raise_event((Event)3));
+        assert_true(EventManager_poll_event((Event)3));
+    }
+    assert_int_equal(
+        EVENTMANAGER.trace.num_entries, 
+        5 + (2 * EVENTMANAGER_TRACE_SIZE)
+    );
+    assert_int_equal(p_entries[5].event, 3);
+}
+
+/**
+ * @brief Test that event latency is recorded in the DataPool histograms.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_latency(void **state) {
+    (void) state;
+
+    /* Check the log2 buckets */
+    assert_int_equal(EventManager_log2_bucket(0, 4), 0);
+    assert_int_equal(EventManager_log2_bucket(1, 4), 1);
+    assert_int_equal(EventManager_log2_bucket(2, 4), 2);
+    assert_int_equal(EventManager_log2_bucket(3, 4), 2);
+    assert_int_equal(EventManager_log2_bucket(4, 4), 3);
+    assert_int_equal(EventManager_log2_bucket(UINT32_MAX, 4), 3);
+
+    /* An event polled in the cycle it was raised in */
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_poll_event((Event)1));
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[0], 1);
+
+    /* An event polled in the next cycle */
+    assert_true(EventManager_raise_event((Event)1));
+    EventManager_cleanup_events();
+    assert_int_equal(EventManager_poll_event_count((Event)1), 1);
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[1], 1);
+
+    /* Stale events are never polled so aren't counted */
+    assert_true(EventManager_raise_event((Event)1));
+    EventManager_cleanup_events();
+    EventManager_cleanup_events();
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[0], 1);
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[1], 1);
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[2], 0);
+
+    /* Raising a coalesced event again keeps it from going stale, but its
+     * latency is still measured from the first raise */
+    assert_true(EventManager_enable_coalescing((Event)3));
+    assert_true(EventManager_raise_event((Event)3));
+    EventManager_cleanup_events();
+    assert_true(EventManager_raise_event((Event)3));
+    EventManager_cleanup_events();
+    assert_true(EventManager_raise_event((Event)3));
+    EventManager_cleanup_events();
+    assert_int_equal(EventManager_poll_event_count((Event)3), 3);
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[2], 1);
+
+    /* With an event selected only that event is counted */
+    DP.EVENTMANAGER.LATENCY_EVENT = (Event)2;
+    assert_true(EventManager_raise_event((Event)1));
+    assert_true(EventManager_raise_event((Event)2));
+    assert_true(EventManager_poll_event((Event)1));
+    assert_true(EventManager_poll_event((Event)2));
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_CYCLES_HIST[0], 2);
+
+    /* The Rtc isn't initialised, so no times are measured */
+    assert_int_equal(DP.EVENTMANAGER.LATENCY_MAX_US, 0);
+    for (size_t i = 0; i < EVENTMANAGER_LATENCY_US_NUM_BUCKETS; ++i) {
+        assert_int_equal(DP.EVENTMANAGER.LATENCY_US_HIST[i], 0);
+    }
+}
+
+/**
+ * @brief Test that delayed events are raised in the right cycle.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_delayed(void **state) {
+    (void) state;
+    uint32_t delay_ms;
+
+    /* A delay of 0 raises the event straight away */
+    assert_true(EventManager_raise_event_after_cycles((Event)1, 0));
+    assert_false(EventManager_is_delayed_event_pending());
+    assert_true(EventManager_poll_event((Event)1));
+
+    /* Delay events out of order, with two due in the same cycle */
+    assert_true(EventManager_raise_event_after_cycles((Event)3, 3));
+    assert_true(EventManager_raise_event_after_cycles((Event)1, 1));
+    assert_true(EventManager_raise_event_after_cycles((Event)2, 3));
+    assert_true(EventManager_is_delayed_event_pending());
+    assert_int_equal(EVENTMANAGER.cycle_delay_queue.num_entries, 3);
+    assert_int_equal(EVENTMANAGER.cycle_delay_queue.entries[0].event, 1);
+    assert_int_equal(EVENTMANAGER.cycle_delay_queue.entries[1].event, 3);
+    assert_int_equal(EVENTMANAGER.cycle_delay_queue.entries[2].event, 2);
+    assert_false(EventManager_is_event_raised((Event)1));
+
+    /* The first event is available in the next cycle */
+    EventManager_cleanup_events();
+    assert_true(EventManager_poll_event((Event)1));
+    assert_false(EventManager_is_event_raised((Event)2));
+
+    /* The other two are available together two cycles later */
+    EventManager_cleanup_events();
+    assert_false(EventManager_is_event_raised((Event)2));
+    EventManager_cleanup_events();
+    assert_true(EventManager_poll_event((Event)2));
+    assert_true(EventManager_poll_event((Event)3));
+    assert_false(EventManager_is_delayed_event_pending());
+
+    /* Delays are counted correctly when the cycle count wraps */
+    EVENTMANAGER.cycle_count = UINT32_MAX;
+    assert_true(EventManager_raise_event_after_cycles((Event)1, 2));
+    EventManager_cleanup_events();
+    assert_false(EventManager_is_event_raised((Event)1));
+    EventManager_cleanup_events();
+    assert_true(EventManager_poll_event((Event)1));
+
+    /* Clearing all events cancels delayed events */
+    assert_true(EventManager_raise_event_after_cycles((Event)1, 1));
+    assert_true(EventManager_clear_all_events());
+    assert_false(EventManager_is_delayed_event_pending());
+
+    /* Only cycle delays need the main loop to keep cycling, for time delays
+     * it waits for the earliest to be due. The Rtc isn't initialised, so the
+     * current time reads as 0. */
+    assert_false(EventManager_get_next_delay_ms(&delay_ms));
+    assert_true(EventManager_delay_event(
+        &EVENTMANAGER.time_delay_queue,
+        (Event)1,
+        (uint32_t)EVENTMANAGER_RTC_TICKS_PER_SEC
+    ));
+    assert_true(EventManager_delay_event(
+        &EVENTMANAGER.time_delay_queue,
+        (Event)2,
+        1
+    ));
+    assert_true(EventManager_is_delayed_event_pending());
+    assert_false(EventManager_is_cycle_delayed_event_pending());
+    assert_true(EventManager_get_next_delay_ms(&delay_ms));
+    assert_int_equal(delay_ms, 1);
+    assert_true(EventManager_raise_event_after_cycles((Event)3, 1));
+    assert_true(EventManager_is_cycle_delayed_event_pending());
+    assert_true(EventManager_clear_all_events());
+
+    /* An overdue event has no time left */
+    assert_true(EventManager_delay_event(
+        &EVENTMANAGER.time_delay_queue,
+        (Event)1,
+        UINT32_MAX
+    ));
+    assert_true(EventManager_get_next_delay_ms(&delay_ms));
+    assert_int_equal(delay_ms, 0);
+    assert_true(EventManager_clear_all_events());
+
+    /* Time delays need the Rtc, which isn't initialised */
+    assert_true(EventManager_raise_event_after_ms((Event)1, 0));
+    assert_true(EventManager_poll_event((Event)1));
+    assert_false(EventManager_raise_event_after_ms((Event)1, 10));
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_RTC_NOT_INITIALISED
+    );
+
+    /* Invalid delays */
+    assert_false(EventManager_raise_event_after_cycles(EVT_NONE, 1));
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_INVALID_DELAYED_EVENT
+    );
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+    assert_false(
+        EventManager_raise_event_after_ms((Event)1, EVENTMANAGER_MAX_DELAY_MS + 1)
+    );
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_INVALID_DELAYED_EVENT
+    );
+
+    /* Fill the queue */
+    for (size_t i = 0; i < EVENTMANAGER_MAX_DELAYED_EVENTS; ++i) {
+        assert_true(EventManager_raise_event_after_cycles((Event)1, 1));
+    }
+    assert_false(EventManager_raise_event_after_cycles((Event)1, 1));
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_MAX_DELAYED_EVENTS_REACHED
+    );
+    DP.EVENTMANAGER.ERROR.code = ERROR_NONE;
+}
+
+#ifdef DEBUG_MODE
+/**
+ * @brief Test the list of raised events is printed into the given buffer.
+ * 
+ * @param state cmocka state
+ */
+static void EventManager_test_event_list_string(void **state) {
+    (void) state;
+
+    /* Room for 100 events at 8 characters each, plus the brackets */
+    char str[(8 * 100) + 3];
+
+    EventManager_get_event_list_string(str, sizeof(str));
+    assert_string_equal(str, "[]");
+
+    assert_true(EventManager_raise_event((Event)0x1234));
+    EventManager_get_event_list_string(str, sizeof(str));
+    assert_string_equal(str, "[0x1234]");
+
+    /* An exactly sized buffer holds the whole list */
+    EventManager_get_event_list_string(str, 9);
+    assert_string_equal(str, "[0x1234]");
+
+    /* More events than used to fit in a heap block */
+    assert_true(EventManager_clear_all_events());
+    for (Event evt = (Event)1; evt <= 100; evt++) {
+        assert_true(EventManager_raise_event(evt));
+    }
+    EventManager_get_event_list_string(str, sizeof(str));
+    assert_int_equal(strlen(str), 6 + (8 * 99) + 2);
+    assert_int_equal(str[strlen(str) - 1], ']');
+
+    /* A short buffer cuts the list short */
+    EventManager_get_event_list_string(str, 20);
+    assert_true(strlen(str) < 20);
+    assert_string_equal(&str[strlen(str) - 4], "...]");
+    EventManager_get_event_list_string(str, 6);
+    assert_string_equal(str, "[...]");
+    str[0] = 'x';
+    EventManager_get_event_list_string(str, 5);
+    assert_string_equal(str, "");
+}
+#endif
+
 /**
  * @brief Test that error codes work correctly.
  * 
@@ -182,17 +743,33 @@ static void EventManager_test_errors(void **state) {
     assert_true(EventManager_init());
 
     /* Raise more events than the max */
-    for (Event evt = (Event)1; evt < EVENTMANAGER_MAX_LIST_SIZE; evt++) {
+    for (Event evt = (Event)1; evt <= EVENTMANAGER_MAX_RAISED_EVENTS; evt++) {
         assert_true(EventManager_raise_event(evt));
     }
-    assert_false(EventManager_raise_event(EVENTMANAGER_MAX_LIST_SIZE + 1));
+    assert_false(EventManager_raise_event(EVENTMANAGER_MAX_RAISED_EVENTS + 1));
     assert_int_equal(
         DP.EVENTMANAGER.ERROR.code,
         EVENTMANAGER_ERROR_MAX_EVENTS_REACHED
     );
 
-    /* Clear all events */
+    /* Clear all events and check the high water mark is kept */
     assert_true(EventManager_clear_all_events());
+    assert_int_equal(
+        DP.EVENTMANAGER.NUM_RAISED_EVENTS_HIGH_WATER,
+        EVENTMANAGER_MAX_RAISED_EVENTS
+    );
+
+    /* Coalesce more events than the max */
+    for (Event evt = (Event)1; evt <= EVENTMANAGER_MAX_COALESCED_EVENTS; evt++) {
+        assert_true(EventManager_enable_coalescing(evt));
+    }
+    assert_false(
+        EventManager_enable_coalescing(EVENTMANAGER_MAX_COALESCED_EVENTS + 1)
+    );
+    assert_int_equal(
+        DP.EVENTMANAGER.ERROR.code,
+        EVENTMANAGER_ERROR_MAX_COALESCED_EVENTS_REACHED
+    );
 }
 
 /**
@@ -266,6 +843,48 @@ const struct CMUnitTest eventmanager_tests[] = {
         EventManager_test_setup,
         EventManager_test_teardown
     ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_isr_queue,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_subscribe,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_coalescing,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_poll_set,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_trace,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_latency,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_delayed,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    #ifdef DEBUG_MODE
+    cmocka_unit_test_setup_teardown(
+        EventManager_test_event_list_string,
+        EventManager_test_setup,
+        EventManager_test_teardown
+    ),
+    #endif
     cmocka_unit_test_teardown(
         EventManager_test_errors,
         EventManager_test_teardown
@@ -0,0 +1,187 @@
+/**
+ * @ingroup kernel
+ * 
+ * @file Kernel_dp_struct.h
+ * @author agent (agent@local)
+ * @brief Provides DataPool parameters for the Kernel
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021
+ */
+
+#ifndef H_KERNEL_DP_STRUCT_H
+#define H_KERNEL_DP_STRUCT_H
+
+/* -------------------------------------------------------------------------   
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdint.h>
+
+/* Internal includes */
+#include "system/kernel/Kernel_public.h"
+#include "drivers/rtc/Rtc_public.h"
+
+/* -------------------------------------------------------------------------   
+ * STRUCTS
+ * ------------------------------------------------------------------------- */
+
+/* Note: the Kernel's DataPool block is shared with the flags defined directly
+ * in DataPool_struct.h, which use indexes 1 to 3. */
+typedef struct _Kernel_Dp {
+
+    /**
+     * @brief Number of times each module's step function has been profiled,
+     * indexed by the unshifted module ID.
+     * 
+     * @dp 4
+     */
+    uint32_t STEP_COUNT[KERNEL_NUM_MODULE_IDS];
+
+    /**
+     * @brief Shortest execution time of each module's step function in
+     * nanoseconds, indexed by the unshifted module ID. 0 if the step has
+     * never been profiled.
+     * 
+     * @dp 5
+     */
+    uint32_t STEP_MIN_NS[KERNEL_NUM_MODULE_IDS];
+
+    /**
+     * @brief Longest execution time of each module's step function in
+     * nanoseconds, indexed by the unshifted module ID.
+     * 
+     * @dp 6
+     */
+    uint32_t STEP_MAX_NS[KERNEL_NUM_MODULE_IDS];
+
+    /**
+     * @brief Mean execution time of each module's step function in
+     * nanoseconds, indexed by the unshifted module ID.
+     * 
+     * @dp 7
+     */
+    uint32_t STEP_MEAN_NS[KERNEL_NUM_MODULE_IDS];
+
+    /**
+     * @brief Main loop cycle time budget in microseconds, above which a cycle
+     * is counted as an overrun. 0 disables overrun detection.
+     * 
+     * @dp 8
+     */
+    uint32_t CYCLE_BUDGET_US;
+
+    /**
+     * @brief Longest main loop cycle in nanoseconds, excluding time spent
+     * waiting for interrupts.
+     * 
+     * @dp 9
+     */
+    uint32_t CYCLE_MAX_NS;
+
+    /**
+     * @brief Number of main loop cycles which have overrun the budget.
+     * 
+     * @dp 10
+     */
+    uint32_t NUM_CYCLE_OVERRUNS;
+
+    /**
+     * @brief Time of the last overrun, or 0 if it occured before the RTC was
+     * initialised.
+     * 
+     * @dp 11
+     */
+    Rtc_Timestamp LAST_OVERRUN_TIMESTAMP;
+
+    /**
+     * @brief Length of the last overrunning cycle in nanoseconds.
+     * 
+     * @dp 12
+     */
+    uint32_t LAST_OVERRUN_NS;
+
+    /**
+     * @brief Module ID (shifted, i.e. MOD_ID_X) of the module whose step took
+     * longest during the last overrunning cycle. MOD_ID_KERNEL if no module
+     * was stepped during it.
+     * 
+     * @dp 13
+     */
+    uint16_t LAST_OVERRUN_MOD_ID;
+
+    /**
+     * @brief Execution time in nanoseconds of the step of
+     * LAST_OVERRUN_MOD_ID during the last overrunning cycle.
+     * 
+     * @dp 14
+     */
+    uint32_t LAST_OVERRUN_MOD_NS;
+
+    /**
+     * @brief Size of the stack in bytes, set by Kernel_stack_step(). 0 on
+     * linux, where the stack isn't measured.
+     * 
+     * @dp 15
+     */
+    uint32_t STACK_SIZE_BYTES;
+
+    /**
+     * @brief Deepest the stack has been since reset in bytes, including
+     * interrupts, as found by Kernel_stack_step().
+     * 
+     * @dp 16
+     */
+    uint32_t STACK_MAX_USED_BYTES;
+
+    /**
+     * @brief Total size of the heap pools in bytes.
+     * 
+     * @dp 17
+     */
+    uint32_t HEAP_SIZE_BYTES;
+
+    /**
+     * @brief Bytes of heap blocks currently allocated, counting whole blocks
+     * rather than the sizes requested.
+     * 
+     * @dp 18
+     */
+    uint32_t HEAP_USED_BYTES;
+
+    /**
+     * @brief Highest value of HEAP_USED_BYTES since the heap was initialised.
+     * 
+     * @dp 19
+     */
+    uint32_t HEAP_PEAK_BYTES;
+
+    /**
+     * @brief Number of calls to Kernel_malloc() which couldn't be served.
+     * 
+     * @dp 20
+     */
+    uint32_t NUM_HEAP_ALLOC_FAILURES;
+
+    /**
+     * @brief Highest number of blocks allocated at once from each heap size
+     * class, smallest class first.
+     * 
+     * @dp 21
+     */
+    uint16_t HEAP_CLASS_PEAK_BLOCKS[KERNEL_HEAP_NUM_CLASSES];
+
+    /**
+     * @brief Number of calls to Kernel_free() which were rejected, either
+     * because the block was already free or because the pointer wasn't
+     * allocated from the heap.
+     * 
+     * @dp 32
+     */
+    uint32_t NUM_HEAP_INVALID_FREES;
+
+} Kernel_Dp;
+
+#endif /* H_KERNEL_DP_STRUCT_H */
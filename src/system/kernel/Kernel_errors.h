@@ -20,6 +20,9 @@
 /* Standard library includes */
 #include <stdint.h>
 
+/* Internal includes */
+#include "system/kernel/Kernel_module_ids.h"
+
 /* -------------------------------------------------------------------------   
  * TYPES
  * ------------------------------------------------------------------------- */
@@ -96,4 +99,17 @@ typedef struct _Error {
  */
 #define ERROR_NONE ((ErrorCode)0x00)
 
+/**
+ * @brief Debug_init() failed during Kernel_init_critical_modules(), so the
+ * system was rebooted.
+ */
+#define KERNEL_ERROR_DEBUG_INIT_FAILED ((ErrorCode)MOD_ID_KERNEL | 1)
+
+/**
+ * @brief EventManager_init() failed during Kernel_init_critical_modules(), so
+ * the system was rebooted. The cause is DP.EVENTMANAGER.ERROR, if it was
+ * set.
+ */
+#define KERNEL_ERROR_EVENTMANAGER_INIT_FAILED ((ErrorCode)MOD_ID_KERNEL | 2)
+
 #endif /* H_KERNEL_ERRORS_H */
\ No newline at end of file
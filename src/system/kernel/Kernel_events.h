@@ -0,0 +1,38 @@
+/**
+ * @ingroup kernel
+ * 
+ * @file Kernel_events.h
+ * @author agent (agent@local)
+ * @brief Events associated with the Kernel module.
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2021
+ */
+
+#ifndef H_KERNEL_EVENTS_H
+#define H_KERNEL_EVENTS_H
+
+/* -------------------------------------------------------------------------   
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Internal includes */
+#include "system/kernel/Kernel_module_ids.h"
+#include "system/event_manager/EventManager_public.h"
+
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Event indicating that a main loop cycle took longer than the cycle
+ * time budget.
+ * 
+ * Check DP.KERNEL.LAST_OVERRUN_NS for the length of the cycle and
+ * DP.KERNEL.LAST_OVERRUN_MOD_ID for the module whose step took longest during
+ * it.
+ */
+#define EVT_KERNEL_CYCLE_OVERRUN ((Event)(MOD_ID_KERNEL | 1))
+
+#endif /* H_KERNEL_EVENTS_H */
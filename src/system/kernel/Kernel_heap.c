@@ -0,0 +1,342 @@
+/**
+ * @file Kernel_heap.c
+ * @author agent (agent@local)
+ * @brief Fixed block size heap allocator.
+ *
+ * See Kernel_public.h for more information.
+ *
+ * Each size class is a pool of equal blocks, laid out one after the other
+ * from the start of the heap region. Free blocks of a class form a singly
+ * linked list through their first word, so allocating pops the head of a
+ * list and freeing pushes onto it. The class a block belongs to is found from
+ * its address when it is freed, so blocks have no header. A bitmap of the
+ * allocated blocks of each class lets a double free be rejected rather than
+ * linking the block onto the free list twice.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * IMPORTS
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef TARGET_TM4C
+#include <errno.h>
+#endif
+
+/* System includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Alignment of every block, which must be at least the alignment of
+ * any type.
+ */
+#define KERNEL_HEAP_ALIGN (8)
+
+/**
+ * @brief Most blocks a class can have, one for each bit of its entry in
+ * KERNEL_HEAP_USED_BLOCKS.
+ */
+#define KERNEL_HEAP_MAX_CLASS_BLOCKS (64)
+
+#ifdef TARGET_UNIX
+/**
+ * @brief Size of the memory used for the heap on linux, the same as HEAPSIZE
+ * on the TM4C.
+ */
+#define KERNEL_HEAP_LINUX_SIZE_BYTES (0x2000)
+#endif
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Block size of each class in bytes, smallest first. Each must be a
+ * multiple of KERNEL_HEAP_ALIGN, and the last must be
+ * KERNEL_HEAP_MAX_ALLOC_BYTES.
+ */
+static const uint16_t KERNEL_HEAP_BLOCK_SIZES[KERNEL_HEAP_NUM_CLASSES] = {
+    16, 32, 64, 128, 256, KERNEL_HEAP_MAX_ALLOC_BYTES
+};
+
+/**
+ * @brief Number of blocks in each class. These give 6 KB of pools, which
+ * fits in the 8 KB HEAPSIZE set by tm4c123g.cmake. Each must be at most
+ * KERNEL_HEAP_MAX_CLASS_BLOCKS.
+ */
+static const uint16_t KERNEL_HEAP_NUM_BLOCKS[KERNEL_HEAP_NUM_CLASSES] = {
+    64, 32, 16, 8, 4, 2
+};
+
+/**
+ * @brief First block of each class, or NULL if the heap isn't initialised.
+ */
+static uint8_t *KERNEL_HEAP_P_CLASS_START[KERNEL_HEAP_NUM_CLASSES];
+
+/**
+ * @brief First free block of each class, or NULL if the class is used up.
+ */
+static void *KERNEL_HEAP_P_FREE[KERNEL_HEAP_NUM_CLASSES];
+
+/**
+ * @brief Number of blocks of each class currently allocated.
+ */
+static uint16_t KERNEL_HEAP_NUM_USED[KERNEL_HEAP_NUM_CLASSES];
+
+/**
+ * @brief Bitmap of the allocated blocks of each class, bit n being set while
+ * block n of the class is allocated.
+ */
+static uint64_t KERNEL_HEAP_USED_BLOCKS[KERNEL_HEAP_NUM_CLASSES];
+
+#ifdef TARGET_TM4C
+/**
+ * @brief Start of the heap region, defined by tm4c123g.ld.
+ */
+extern uint8_t __heap_start__;
+
+/**
+ * @brief End of the heap region, defined by tm4c123g.ld.
+ */
+extern uint8_t __heap_end__;
+#else
+/**
+ * @brief Memory used for the heap on linux.
+ */
+static uint8_t KERNEL_HEAP_LINUX[KERNEL_HEAP_LINUX_SIZE_BYTES]
+    __attribute__((aligned(KERNEL_HEAP_ALIGN)));
+#endif
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+#ifdef TARGET_TM4C
+/* Declared here as newlib doesn't provide a prototype */
+void *_sbrk(ptrdiff_t increment_in);
+
+/**
+ * @brief Replaces the _sbrk() of libnosys, which newlib's malloc() uses to
+ * grow into the heap region. The region belongs to the Kernel heap, so this
+ * always fails, which makes any malloc() return NULL rather than overwrite
+ * the pools.
+ */
+void *_sbrk(ptrdiff_t increment_in) {
+    (void)increment_in;
+
+    errno = ENOMEM;
+    return (void *)-1;
+}
+#endif
+
+void Kernel_init_heap(void) {
+    uintptr_t start;
+    uintptr_t end;
+    uint32_t total = 0;
+    uint8_t *p_pool;
+    uint8_t *p_block;
+    size_t i;
+    uint16_t j;
+
+    #ifdef TARGET_TM4C
+    start = (uintptr_t)&__heap_start__;
+    end = (uintptr_t)&__heap_end__;
+    #else
+    start = (uintptr_t)KERNEL_HEAP_LINUX;
+    end = start + sizeof(KERNEL_HEAP_LINUX);
+    #endif
+
+    /* Align the start of the pools */
+    start = (start + (KERNEL_HEAP_ALIGN - 1))
+        & ~(uintptr_t)(KERNEL_HEAP_ALIGN - 1);
+
+    for (i = 0; i < KERNEL_HEAP_NUM_CLASSES; ++i) {
+        total += (uint32_t)KERNEL_HEAP_BLOCK_SIZES[i]
+            * (uint32_t)KERNEL_HEAP_NUM_BLOCKS[i];
+        KERNEL_HEAP_P_CLASS_START[i] = NULL;
+        KERNEL_HEAP_P_FREE[i] = NULL;
+        KERNEL_HEAP_NUM_USED[i] = 0;
+        KERNEL_HEAP_USED_BLOCKS[i] = 0;
+        DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS[i] = 0;
+    }
+
+    DP.KERNEL.HEAP_SIZE_BYTES = 0;
+    DP.KERNEL.HEAP_USED_BYTES = 0;
+    DP.KERNEL.HEAP_PEAK_BYTES = 0;
+    DP.KERNEL.NUM_HEAP_ALLOC_FAILURES = 0;
+    DP.KERNEL.NUM_HEAP_INVALID_FREES = 0;
+
+    /* Every block must have a bit in the used bitmap */
+    for (i = 0; i < KERNEL_HEAP_NUM_CLASSES; ++i) {
+        if (KERNEL_HEAP_NUM_BLOCKS[i] > KERNEL_HEAP_MAX_CLASS_BLOCKS) {
+            DEBUG_ERR(
+                "Heap class %lu has more than %d blocks",
+                (unsigned long)i,
+                KERNEL_HEAP_MAX_CLASS_BLOCKS
+            );
+            return;
+        }
+    }
+
+    /* If the pools don't fit every allocation will fail */
+    if (start > end || total > (end - start)) {
+        DEBUG_ERR(
+            "Heap pools need %lu bytes but the heap is only %lu bytes",
+            (unsigned long)total,
+            (unsigned long)(end - start)
+        );
+        return;
+    }
+
+    /* Lay out the pools and link each block onto its free list, last block
+     * first so that blocks are handed out in address order */
+    p_pool = (uint8_t *)start;
+    for (i = 0; i < KERNEL_HEAP_NUM_CLASSES; ++i) {
+        KERNEL_HEAP_P_CLASS_START[i] = p_pool;
+
+        for (j = KERNEL_HEAP_NUM_BLOCKS[i]; j > 0; --j) {
+            p_block = p_pool + ((size_t)(j - 1) * KERNEL_HEAP_BLOCK_SIZES[i]);
+            *(void **)p_block = KERNEL_HEAP_P_FREE[i];
+            KERNEL_HEAP_P_FREE[i] = p_block;
+        }
+
+        p_pool += (size_t)KERNEL_HEAP_BLOCK_SIZES[i] * KERNEL_HEAP_NUM_BLOCKS[i];
+    }
+
+    DP.KERNEL.HEAP_SIZE_BYTES = total;
+}
+
+void *Kernel_malloc(size_t size_in) {
+    void *p_block;
+    size_t i;
+
+    if (size_in == 0) {
+        return NULL;
+    }
+
+    /* Find the smallest class which fits and has a free block */
+    for (i = 0; i < KERNEL_HEAP_NUM_CLASSES; ++i) {
+        if (KERNEL_HEAP_BLOCK_SIZES[i] >= size_in
+            &&
+            KERNEL_HEAP_P_FREE[i] != NULL
+        ) {
+            break;
+        }
+    }
+
+    /*
+     * ---- NUMERICAL PROTECTION ----
+     * The failure count saturates rather than wrapping to 0.
+     */
+    if (i == KERNEL_HEAP_NUM_CLASSES) {
+        if (DP.KERNEL.NUM_HEAP_ALLOC_FAILURES != UINT32_MAX) {
+            DP.KERNEL.NUM_HEAP_ALLOC_FAILURES++;
+        }
+        DEBUG_WRN(
+            "Couldn't allocate %lu bytes from the heap",
+            (unsigned long)size_in
+        );
+        return NULL;
+    }
+
+    p_block = KERNEL_HEAP_P_FREE[i];
+    KERNEL_HEAP_P_FREE[i] = *(void **)p_block;
+    KERNEL_HEAP_USED_BLOCKS[i] |= (uint64_t)1 << (
+        (size_t)((uint8_t *)p_block - KERNEL_HEAP_P_CLASS_START[i])
+        / KERNEL_HEAP_BLOCK_SIZES[i]
+    );
+
+    KERNEL_HEAP_NUM_USED[i]++;
+    if (KERNEL_HEAP_NUM_USED[i] > DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS[i]) {
+        DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS[i] = KERNEL_HEAP_NUM_USED[i];
+    }
+
+    DP.KERNEL.HEAP_USED_BYTES += KERNEL_HEAP_BLOCK_SIZES[i];
+    if (DP.KERNEL.HEAP_USED_BYTES > DP.KERNEL.HEAP_PEAK_BYTES) {
+        DP.KERNEL.HEAP_PEAK_BYTES = DP.KERNEL.HEAP_USED_BYTES;
+    }
+
+    return p_block;
+}
+
+void Kernel_free(void *p_block_in) {
+    uint8_t *p_block = (uint8_t *)p_block_in;
+    uint8_t *p_start;
+    uint64_t block_bit;
+    bool is_double_free = false;
+    size_t i;
+
+    if (p_block == NULL) {
+        return;
+    }
+
+    /* Find the class whose pool the block is in */
+    for (i = 0; i < KERNEL_HEAP_NUM_CLASSES; ++i) {
+        p_start = KERNEL_HEAP_P_CLASS_START[i];
+        if (p_start == NULL
+            ||
+            p_block < p_start
+            ||
+            p_block >= p_start
+                + ((size_t)KERNEL_HEAP_BLOCK_SIZES[i] * KERNEL_HEAP_NUM_BLOCKS[i])
+        ) {
+            continue;
+        }
+
+        /* A pointer into the middle of a block wasn't returned by
+         * Kernel_malloc() */
+        if ((size_t)(p_block - p_start) % KERNEL_HEAP_BLOCK_SIZES[i] != 0) {
+            break;
+        }
+
+        /* Freeing a free block again would link it onto the free list twice,
+         * so that it is handed out to two callers at once */
+        block_bit = (uint64_t)1 << (
+            (size_t)(p_block - p_start) / KERNEL_HEAP_BLOCK_SIZES[i]
+        );
+        if ((KERNEL_HEAP_USED_BLOCKS[i] & block_bit) == 0) {
+            is_double_free = true;
+            break;
+        }
+
+        KERNEL_HEAP_USED_BLOCKS[i] &= ~block_bit;
+        *(void **)p_block = KERNEL_HEAP_P_FREE[i];
+        KERNEL_HEAP_P_FREE[i] = p_block;
+
+        KERNEL_HEAP_NUM_USED[i]--;
+        DP.KERNEL.HEAP_USED_BYTES -= KERNEL_HEAP_BLOCK_SIZES[i];
+        return;
+    }
+
+    if (is_double_free) {
+        DEBUG_ERR("Heap block %p was freed twice", p_block_in);
+    }
+    else {
+        DEBUG_ERR(
+            "Freed pointer %p wasn't allocated from the heap", 
+            p_block_in
+        );
+    }
+
+    /*
+     * ---- NUMERICAL PROTECTION ----
+     * The count saturates rather than wrapping to 0.
+     */
+    if (DP.KERNEL.NUM_HEAP_INVALID_FREES != UINT32_MAX) {
+        DP.KERNEL.NUM_HEAP_INVALID_FREES++;
+    }
+}
@@ -23,6 +23,9 @@
 #include <stdio.h>
 #include <string.h>
 #endif
+#ifdef TARGET_UNIX
+#include <signal.h>
+#endif
 
 /* External includes */
 #ifdef TARGET_TM4C
@@ -36,6 +39,22 @@
 #include "system/kernel/Kernel_public.h"
 #include "system/data_pool/DataPool_public.h"
 #include "system/event_manager/EventManager_public.h"
+#ifdef TARGET_UNIX
+#include "drivers/virtual_time/VirtualTime_public.h"
+#include "drivers/replay/Replay_public.h"
+#endif
+
+/* -------------------------------------------------------------------------   
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+#ifdef TARGET_UNIX
+/**
+ * @brief The signal mask from before Kernel_disable_interrupts() was called,
+ * which is restored by Kernel_enable_interrupts().
+ */
+static sigset_t KERNEL_ENABLED_SIGNAL_MASK;
+#endif
 
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
@@ -46,16 +65,51 @@
 void Kernel_disable_interrupts(void) {
     #ifdef TARGET_TM4C
     IntMasterDisable();
+    #elif TARGET_UNIX
+    sigset_t all_signals;
+
+    /* Block every signal, the handlers of which are the only things that can
+     * interrupt the main loop on linux */
+    sigfillset(&all_signals);
+    sigprocmask(SIG_BLOCK, &all_signals, &KERNEL_ENABLED_SIGNAL_MASK);
     #endif
 }
 
 void Kernel_enable_interrupts(void) {
     #ifdef TARGET_TM4C
     IntMasterEnable();
+    #elif TARGET_UNIX
+    sigprocmask(SIG_SETMASK, &KERNEL_ENABLED_SIGNAL_MASK, NULL);
+    #endif
+}
+
+void Kernel_wait_for_interrupt(void) {
+    #ifdef TARGET_TM4C
+    __asm("WFI");
+    #elif TARGET_UNIX
+    /* During replay the interrupt events are taken from the trace, so there's
+     * nothing to wait for */
+    if (Replay_is_replaying()) {
+        return;
+    }
+
+    /* sigsuspend atomically unblocks the signals and waits, so a signal which
+     * became pending after interrupts were disabled still wakes it straight
+     * away, the same as WFI. It returns once the signal's handler has run,
+     * with the signals blocked again. */
+    #ifdef VIRTUAL_TIME
+    /* In virtual time the next timer fires straight away, a signal can still
+     * end the wait if there isn't one */
+    if (VirtualTime_wait_for_interrupt()) {
+        return;
+    }
+    #endif
+    sigsuspend(&KERNEL_ENABLED_SIGNAL_MASK);
     #endif
 }
 
 void Kernel_init_critical_modules(void) {
+    Error error;
 
     /*
      * A note on rebooting:
@@ -69,30 +123,51 @@ void Kernel_init_critical_modules(void) {
     DataPool_init();
     Board_init();
 
+    /* Start profiling, which needs the system clock to be set by Board */
+    Kernel_init_step_profile();
+
     /* Debug can fail if it can't get a valid initial time on linux. */
     if (!Debug_init()) {
-        Kernel_reboot();
+        error.code = KERNEL_ERROR_DEBUG_INIT_FAILED;
+        error.p_cause = NULL;
+        Kernel_reboot_with_error(&error);
     }
 
-    /* EventManager can fail if there's not enough memory for the event arrays.
-     * This would be a pretty critical problem, but there's _probably_ noting
-     * we can do about it in flight. As this is such a critical system it's
+    /* The heap is needed by anything that allocates, so is initialised before
+     * any other module */
+    Kernel_init_heap();
+
+    /* EventManager's lists are statically allocated so init can't currently
+     * fail, but the check is kept in case that changes. A failure would be a
+     * pretty critical problem, but there's _probably_ noting we can do about
+     * it in flight. As this is such a critical system it's
      * failure would be unrecoverable.
      * 
      * TODO: potentially we shouldn't try to reboot because we'd end up drawing
      * too much power? */
     if (!EventManager_init()) {
-        Kernel_reboot();
+        error.code = KERNEL_ERROR_EVENTMANAGER_INIT_FAILED;
+        error.p_cause = DP.EVENTMANAGER.ERROR.code != ERROR_NONE
+            ? &DP.EVENTMANAGER.ERROR : NULL;
+        Kernel_reboot_with_error(&error);
     }
 
     /* TODO: Init Fdir */
 }
 
 void Kernel_reboot(void) {
+    Kernel_reboot_with_error(NULL);
+}
+
+void Kernel_reboot_with_error(Error *p_error_in) {
     /* This wouldn't work if debug hasn't been init, but if that's the case we
      * just miss this print message, it won't cause additional failures */
     DEBUG_ERR("==== KERNEL REBOOT STARTED ====");
 
+    /* Keep the reason in the crash log for the next boot to report */
+    Kernel_save_reboot_error(p_error_in);
+    Debug_flush();
+
     /* TODO: Write monitoring data (num reboots etc.) to EEPROM */
 
     /*
@@ -111,6 +186,24 @@ void Kernel_reboot(void) {
 
 }
 
+void Kernel_save_reboot_error(Error *p_error_in) {
+    /* Kernel_error_to_bytes() can't give more bytes than its uint8_t length
+     * can count, so this can't overflow */
+    uint8_t error_bytes[UINT8_MAX + 1];
+    uint8_t error_length = 0;
+
+    if (p_error_in != NULL) {
+        Kernel_error_to_bytes(p_error_in, error_bytes, &error_length);
+    }
+    Debug_crash_log_save(
+        DEBUG_CRASH_REASON_REBOOT,
+        0,
+        NULL,
+        p_error_in != NULL ? error_bytes : NULL,
+        error_length
+    );
+}
+
 void Kernel_error_to_bytes(
     Error *p_error_in, 
     uint8_t *p_bytes_out, 
@@ -6,7 +6,9 @@
  * Task ref: [UT_2.9.12]
  * 
  * The kernel provides simple functions related to the general system, for
- * example disabling and enabling interrupts.
+ * example disabling and enabling interrupts, profiling the execution time
+ * of each module's step function, measuring the stack high water mark, and
+ * allocating memory from the heap.
  * 
  * @version 0.1
  * @date 2021-02-10
@@ -23,12 +25,73 @@
 
 /* Standard includes */
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 /* Internal includes */
 #include "system/kernel/Kernel_app_ids.h"
 #include "system/kernel/Kernel_module_ids.h"
 #include "system/kernel/Kernel_errors.h"
 
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The number of possible module IDs, which is the size of the step
+ * profile arrays in DP.KERNEL.
+ */
+#define KERNEL_NUM_MODULE_IDS (1 << (16 - KERNEL_MOD_ID_SHIFT))
+
+/**
+ * @brief Maximum length of the line printed by Kernel_print_step_profile(),
+ * including the null byte. Modules which don't fit are left out.
+ */
+#define KERNEL_STEP_PROFILE_STRING_MAX_LENGTH (256)
+
+/**
+ * @brief Word the stack is painted with at reset, which is overwritten as the
+ * stack is used.
+ *
+ * The value must match the one used by ResetISR() in tm4c_startup_gcc.c.
+ */
+#define KERNEL_STACK_PAINT_WORD (0xC5C5C5C5UL)
+
+/**
+ * @brief Percentage of the stack above which a new high water mark is warned
+ * about.
+ */
+#define KERNEL_STACK_WARN_PERCENT (75)
+
+/**
+ * @brief Number of block size classes in the heap, see Kernel_malloc().
+ */
+#define KERNEL_HEAP_NUM_CLASSES (6)
+
+/**
+ * @brief Largest allocation the heap can make in bytes, which is the block
+ * size of the largest class.
+ */
+#define KERNEL_HEAP_MAX_ALLOC_BYTES (512)
+
+/**
+ * @brief Longest main loop cycle time budget in microseconds.
+ * 
+ * Cycle times saturate at UINT32_MAX ns (~4.3 s), so a cycle could never
+ * exceed a longer budget. The limit is 1 us under the saturated time so that
+ * a saturated cycle still counts as an overrun.
+ */
+#define KERNEL_MAX_CYCLE_BUDGET_US ((UINT32_MAX / 1000UL) - 1UL)
+
+#ifdef TARGET_UNIX
+/**
+ * @brief Length of one step profiler tick on linux in nanoseconds. Counting
+ * in 16 ns ticks makes the 32 bit profiler time wrap every ~69 s, close to
+ * the DWT cycle counter of the TM4C, rather than every ~4.3 s.
+ */
+#define KERNEL_PROFILE_LINUX_TICK_NS (16)
+#endif
+
 /* -------------------------------------------------------------------------   
  * TYPES
  * ------------------------------------------------------------------------- */
@@ -48,7 +111,8 @@ typedef uint8_t Kernel_AppId;
  * @brief Disable interrupts on the system.
  * 
  * This can be used in combination with Kernel_enable_interrupts() to create a
- * critical section, i.e. one in which interrupts will not occur. 
+ * critical section, i.e. one in which interrupts will not occur. On linux
+ * signals act as interrupts, so they are blocked instead.
  * 
  * CAUTION: Using this function without subsequently calling
  * Kernel_enable_interrupts() will result in failure of the system!
@@ -66,6 +130,22 @@ void Kernel_disable_interrupts(void);
  */
 void Kernel_enable_interrupts(void);
 
+/**
+ * @brief Wait until an interrupt occurs.
+ * 
+ * Must be called with interrupts disabled, i.e. between
+ * Kernel_disable_interrupts() and Kernel_enable_interrupts(), so that an
+ * interrupt which occurs between checking for work and waiting isn't missed.
+ * The interrupt is still taken while waiting, and interrupts are disabled
+ * again when this function returns.
+ * 
+ * On the TM4C this executes WFI. On linux it suspends the process until a
+ * signal, such as a timer signal, is handled, so that the host isn't kept
+ * busy while there's nothing to do. In virtual time (see
+ * VirtualTime_public.h) it instead jumps the clock to the next timer.
+ */
+void Kernel_wait_for_interrupt(void);
+
 /**
  * @brief Initialise the critical modules of the system.
  * 
@@ -75,6 +155,171 @@ void Kernel_enable_interrupts(void);
  */
 void Kernel_init_critical_modules(void);
 
+/**
+ * @brief Start the step profiler timer and clear the step profile in
+ * DP.KERNEL.
+ * 
+ * On the TM4C this enables the DWT cycle counter, so it must be called after
+ * Board_init() has set the system clock. Called by
+ * Kernel_init_critical_modules().
+ */
+void Kernel_init_step_profile(void);
+
+/**
+ * @brief Get the time at which a step function starts, to be passed to
+ * Kernel_end_step_profile() once it returns.
+ * 
+ * The time is in the native units of the profiler timer, which is CPU cycles
+ * on the TM4C and KERNEL_PROFILE_LINUX_TICK_NS ticks on linux. It wraps, so
+ * must only be used to time intervals shorter than ~50 seconds.
+ * 
+ * @return uint32_t The current profiler time.
+ */
+uint32_t Kernel_start_step_profile(void);
+
+/**
+ * @brief Get the time elapsed since a profiler time.
+ * 
+ * @param start_in The value returned by Kernel_start_step_profile() at the
+ * start of the interval.
+ * @return uint32_t The elapsed time in nanoseconds, saturating at UINT32_MAX
+ * (~4.3 s).
+ */
+uint32_t Kernel_get_elapsed_ns(uint32_t start_in);
+
+/**
+ * @brief Record the execution time of a module's step function in the step
+ * profile in DP.KERNEL.
+ * 
+ * @param mod_id_in The shifted module ID of the module, i.e. MOD_ID_X.
+ * @param start_in The value returned by Kernel_start_step_profile() before
+ * the step function was called.
+ */
+void Kernel_end_step_profile(uint16_t mod_id_in, uint32_t start_in);
+
+/**
+ * @brief Set the main loop cycle time budget, above which a cycle is counted
+ * as an overrun.
+ * 
+ * Must be called after Kernel_init_step_profile(), which clears the budget.
+ * 
+ * @param budget_us_in The budget in microseconds, or 0 to disable overrun
+ * detection. Budgets over KERNEL_MAX_CYCLE_BUDGET_US are clamped to it.
+ */
+void Kernel_set_cycle_budget(uint32_t budget_us_in);
+
+/**
+ * @brief Start timing a main loop cycle.
+ * 
+ * Should be called at the start of each cycle, after waking from any wait for
+ * interrupt, and followed by Kernel_end_cycle_profile() at the end of it. The
+ * longest step recorded by Kernel_end_step_profile() in between is attributed
+ * as the cause of any overrun.
+ */
+void Kernel_start_cycle_profile(void);
+
+/**
+ * @brief Finish timing a main loop cycle, checking it against the budget.
+ * 
+ * If the cycle took longer than the budget DP.KERNEL.NUM_CYCLE_OVERRUNS is
+ * incremented, the details of the overrun are stored in DP.KERNEL, and
+ * EVT_KERNEL_CYCLE_OVERRUN is raised. This should be called after the events
+ * of the cycle are cleaned up so that the event is seen in the next cycle.
+ * 
+ * On linux the budget isn't checked while recording or replaying inputs, as
+ * overruns depend on the speed of the host and aren't part of the trace.
+ */
+void Kernel_end_cycle_profile(void);
+
+/**
+ * @brief Print the step profile of every module that has been profiled to the
+ * debug output as a single line.
+ * 
+ * The line is of the form:
+ * `PROF 14:1000/3100/3500/9000 22:...`
+ * giving for each unshifted module ID in hex the call count, and the min,
+ * mean, and max execution times in nanoseconds.
+ */
+void Kernel_print_step_profile(void);
+
+/**
+ * @brief Get the number of bytes of a painted stack which have been used.
+ *
+ * The stack grows down from p_top_in, so this finds the lowest word which
+ * isn't KERNEL_STACK_PAINT_WORD. Used stack which happens to hold the paint
+ * word is counted as unused, so the result may be a few bytes short.
+ *
+ * @param p_bottom_in The lowest word of the stack.
+ * @param p_top_in One past the highest word of the stack.
+ * @return uint32_t The number of bytes between the deepest used word and
+ * p_top_in.
+ */
+uint32_t Kernel_get_stack_used(
+    const uint32_t *p_bottom_in,
+    const uint32_t *p_top_in
+);
+
+/**
+ * @brief Scan the stack for its high water mark.
+ *
+ * The stack is painted with KERNEL_STACK_PAINT_WORD by ResetISR(), so the
+ * deepest the stack has ever been, including in interrupts, is the lowest
+ * word which has been overwritten. This is stored in
+ * DP.KERNEL.STACK_MAX_USED_BYTES, along with the size of the stack in
+ * DP.KERNEL.STACK_SIZE_BYTES. A warning is printed when the high water mark
+ * passes KERNEL_STACK_WARN_PERCENT of the stack, and an error if the whole
+ * stack has been used.
+ *
+ * Scanning takes time proportional to the unused stack, so this is stepped
+ * at a low rate. On linux the stack isn't painted and this does nothing.
+ *
+ * @return bool Always true.
+ */
+bool Kernel_stack_step(void);
+
+/**
+ * @brief Initialise the heap, which must be done before any call to
+ * Kernel_malloc().
+ *
+ * Called by Kernel_init_critical_modules(). Any blocks still allocated are
+ * lost, and the heap statistics in DP.KERNEL are reset.
+ */
+void Kernel_init_heap(void);
+
+/**
+ * @brief Allocate a block of memory from the heap, in place of malloc().
+ *
+ * The heap is split into pools of fixed size blocks, one pool for each size
+ * class, so allocation and freeing take a bounded time and the heap can't
+ * fragment. The request is served from the smallest class that fits, or the
+ * next larger class with a free block if that class is used up. On the TM4C
+ * the pools are placed in the heap region of tm4c123g.ld, and newlib's
+ * malloc() always fails so that it can't use the same memory.
+ *
+ * The bytes in use and their peak, the peak number of blocks used in each
+ * class, and the number of failed allocations are kept in DP.KERNEL so that
+ * the pools can be sized to the real use.
+ *
+ * Must not be called from an interrupt.
+ *
+ * @param size_in The number of bytes to allocate, at most
+ * KERNEL_HEAP_MAX_ALLOC_BYTES.
+ * @return void* The block, aligned to 8 bytes, or NULL if size_in is 0 or no
+ * block could be allocated.
+ */
+void *Kernel_malloc(size_t size_in);
+
+/**
+ * @brief Free a block allocated by Kernel_malloc().
+ *
+ * Must not be called from an interrupt. A block which is already free, or a
+ * pointer which wasn't allocated from the heap, is rejected and counted in
+ * DP.KERNEL.NUM_HEAP_INVALID_FREES.
+ *
+ * @param p_block_in The block to free, which may be NULL.
+ */
+void Kernel_free(void *p_block_in);
+
 /**
  * @brief Reboot the MCU.
  * 
@@ -85,6 +330,29 @@ void Kernel_init_critical_modules(void);
  */
 void Kernel_reboot(void);
 
+/**
+ * @brief Reboot the MCU, keeping the error which caused it in the crash log
+ * to be reported after the reboot, see Debug_public.h.
+ * 
+ * DANGER: USE THIS ONLY WHEN YOU KNOW WHAT YOU'RE DOING!!!
+ * 
+ * @param p_error_in The highest level error in the chain which caused the
+ * reboot, or NULL.
+ */
+void Kernel_reboot_with_error(Error *p_error_in);
+
+/**
+ * @brief Keep the error which caused a reboot in the crash log, without
+ * rebooting. Called by Kernel_reboot_with_error().
+ * 
+ * After the reboot Debug_crash_log_recover() puts the error chain, as
+ * serialised by Kernel_error_to_bytes(), in DP.DEBUG_CRASH_ERROR_BYTES.
+ * 
+ * @param p_error_in The highest level error in the chain which caused the
+ * reboot, or NULL.
+ */
+void Kernel_save_reboot_error(Error *p_error_in);
+
 /**
  * @brief Serialises the given error into a series of bytes.
  * 
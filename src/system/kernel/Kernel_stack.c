@@ -0,0 +1,92 @@
+/**
+ * @file Kernel_stack.c
+ * @author agent (agent@local)
+ * @brief Measurement of the stack high water mark.
+ *
+ * See Kernel_public.h for more information.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * IMPORTS
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* System includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+#ifdef TARGET_TM4C
+/**
+ * @brief Lowest word of the stack, defined by tm4c123g.ld.
+ */
+extern uint32_t _stack;
+
+/**
+ * @brief One past the highest word of the stack, defined by tm4c123g.ld.
+ */
+extern uint32_t __StackTop;
+#endif
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+uint32_t Kernel_get_stack_used(
+    const uint32_t *p_bottom_in,
+    const uint32_t *p_top_in
+) {
+    const uint32_t *p_word = p_bottom_in;
+
+    /* The stack grows down, so the paint below the deepest use is intact */
+    while (p_word < p_top_in && *p_word == KERNEL_STACK_PAINT_WORD) {
+        p_word++;
+    }
+
+    return (uint32_t)((uintptr_t)p_top_in - (uintptr_t)p_word);
+}
+
+bool Kernel_stack_step(void) {
+    #ifdef TARGET_TM4C
+    uint32_t size = (uint32_t)((uintptr_t)&__StackTop - (uintptr_t)&_stack);
+    uint32_t used = Kernel_get_stack_used(&_stack, &__StackTop);
+
+    DP.KERNEL.STACK_SIZE_BYTES = size;
+
+    if (used <= DP.KERNEL.STACK_MAX_USED_BYTES) {
+        return true;
+    }
+    DP.KERNEL.STACK_MAX_USED_BYTES = used;
+
+    /* If none of the paint is left the stack has most likely overflowed into
+     * the heap below it.
+     * 
+     * ---- NUMERICAL PROTECTION ----
+     * The stack is a few KB, so size * 100 can't overflow.
+     */
+    if (used >= size) {
+        DEBUG_ERR("Stack overflow, all %lu bytes used", (unsigned long)size);
+    }
+    else if (used * 100 >= size * KERNEL_STACK_WARN_PERCENT) {
+        DEBUG_WRN(
+            "Stack high water mark is %lu of %lu bytes",
+            (unsigned long)used,
+            (unsigned long)size
+        );
+    }
+    #endif
+
+    return true;
+}
@@ -0,0 +1,302 @@
+/**
+ * @file Kernel_step_profile.c
+ * @author agent (agent@local)
+ * @brief Profiling of the execution time of each module's step function and
+ * of each main loop cycle.
+ *
+ * See Kernel_public.h for more information.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * IMPORTS
+ * ------------------------------------------------------------------------- */
+
+/* Standard includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef TARGET_UNIX
+#include <time.h>
+#endif
+
+/* External includes */
+#ifdef TARGET_TM4C
+#include "driverlib/sysctl.h"
+#endif
+
+/* System includes */
+#include "util/debug/Debug_public.h"
+#include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+#include "system/event_manager/EventManager_public.h"
+#include "system/kernel/Kernel_events.h"
+#include "drivers/rtc/Rtc_public.h"
+#ifdef TARGET_UNIX
+#include "drivers/replay/Replay_public.h"
+#endif
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+#ifdef TARGET_TM4C
+/**
+ * @brief Debug Exception and Monitor Control Register of the Cortex-M4, whose
+ * TRCENA bit must be set to use the DWT.
+ */
+#define KERNEL_DEMCR (*((volatile uint32_t *)0xE000EDFCUL))
+
+/**
+ * @brief TRCENA bit of KERNEL_DEMCR.
+ */
+#define KERNEL_DEMCR_TRCENA (1UL << 24)
+
+/**
+ * @brief Control register of the Data Watchpoint and Trace unit.
+ */
+#define KERNEL_DWT_CTRL (*((volatile uint32_t *)0xE0001000UL))
+
+/**
+ * @brief CYCCNTENA bit of KERNEL_DWT_CTRL, which enables the cycle counter.
+ */
+#define KERNEL_DWT_CTRL_CYCCNTENA (1UL << 0)
+
+/**
+ * @brief The DWT cycle counter, which counts CPU clock cycles.
+ */
+#define KERNEL_DWT_CYCCNT (*((volatile uint32_t *)0xE0001004UL))
+#endif
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Total execution time of each module's step function in nanoseconds,
+ * used to calculate the mean. Kept out of the DataPool as it is 64 bits.
+ */
+static uint64_t KERNEL_STEP_TOTAL_NS[KERNEL_NUM_MODULE_IDS];
+
+/**
+ * @brief Profiler time at which the current main loop cycle started.
+ */
+static uint32_t KERNEL_CYCLE_START;
+
+/**
+ * @brief Module ID of the longest step in the current main loop cycle.
+ */
+static uint16_t KERNEL_CYCLE_WORST_MOD_ID;
+
+/**
+ * @brief Execution time of the longest step in the current main loop cycle in
+ * nanoseconds.
+ */
+static uint32_t KERNEL_CYCLE_WORST_MOD_NS;
+
+#ifdef TARGET_TM4C
+/**
+ * @brief The CPU clock frequency in MHz, used to convert cycles to
+ * nanoseconds.
+ */
+static uint32_t KERNEL_CPU_CLOCK_MHZ;
+#endif
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+void Kernel_init_step_profile(void) {
+    #ifdef TARGET_TM4C
+    /* Enable the DWT and its cycle counter */
+    KERNEL_DEMCR |= KERNEL_DEMCR_TRCENA;
+    KERNEL_DWT_CYCCNT = 0;
+    KERNEL_DWT_CTRL |= KERNEL_DWT_CTRL_CYCCNTENA;
+
+    KERNEL_CPU_CLOCK_MHZ = SysCtlClockGet() / 1000000UL;
+    #endif
+
+    /* Clear the profile */
+    memset(KERNEL_STEP_TOTAL_NS, 0, sizeof(KERNEL_STEP_TOTAL_NS));
+    memset(&DP.KERNEL, 0, sizeof(DP.KERNEL));
+    KERNEL_CYCLE_WORST_MOD_ID = MOD_ID_KERNEL;
+    KERNEL_CYCLE_WORST_MOD_NS = 0;
+}
+
+uint32_t Kernel_start_step_profile(void) {
+    #ifdef TARGET_TM4C
+    return KERNEL_DWT_CYCCNT;
+    #else
+    struct timespec ts;
+
+    /* Only the low 32 bits are needed as the time is only used for short
+     * intervals */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(
+        (((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec)
+        / KERNEL_PROFILE_LINUX_TICK_NS
+    );
+    #endif
+}
+
+uint32_t Kernel_get_elapsed_ns(uint32_t start_in) {
+    uint64_t ns;
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The timer wraps, but the unsigned difference is still the elapsed time
+     * as long as the interval was shorter than one wrap. It is converted to
+     * nanoseconds in 64 bits, so longer times saturate rather than wrap. */
+    #ifdef TARGET_TM4C
+    ns = ((uint64_t)(Kernel_start_step_profile() - start_in) * 1000ULL)
+        / KERNEL_CPU_CLOCK_MHZ;
+    #else
+    ns = (uint64_t)(Kernel_start_step_profile() - start_in)
+        * KERNEL_PROFILE_LINUX_TICK_NS;
+    #endif
+    return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+void Kernel_end_step_profile(uint16_t mod_id_in, uint32_t start_in) {
+    size_t idx = (size_t)(mod_id_in >> KERNEL_MOD_ID_SHIFT);
+    uint32_t elapsed_ns = Kernel_get_elapsed_ns(start_in);
+
+    /* Keep track of the longest step in the cycle to blame for overruns */
+    if (elapsed_ns > KERNEL_CYCLE_WORST_MOD_NS) {
+        KERNEL_CYCLE_WORST_MOD_ID = mod_id_in;
+        KERNEL_CYCLE_WORST_MOD_NS = elapsed_ns;
+    }
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The count saturates, after which the profile is no longer updated so
+     * that the mean stays consistent. At one step per cycle this takes years
+     * to reach. */
+    if (DP.KERNEL.STEP_COUNT[idx] == UINT32_MAX) {
+        return;
+    }
+
+    if (DP.KERNEL.STEP_COUNT[idx] == 0
+        ||
+        elapsed_ns < DP.KERNEL.STEP_MIN_NS[idx]
+    ) {
+        DP.KERNEL.STEP_MIN_NS[idx] = elapsed_ns;
+    }
+    if (elapsed_ns > DP.KERNEL.STEP_MAX_NS[idx]) {
+        DP.KERNEL.STEP_MAX_NS[idx] = elapsed_ns;
+    }
+
+    DP.KERNEL.STEP_COUNT[idx]++;
+    KERNEL_STEP_TOTAL_NS[idx] += elapsed_ns;
+    DP.KERNEL.STEP_MEAN_NS[idx] = (uint32_t)(
+        KERNEL_STEP_TOTAL_NS[idx] / DP.KERNEL.STEP_COUNT[idx]
+    );
+}
+
+void Kernel_set_cycle_budget(uint32_t budget_us_in) {
+    /* ---- NUMERICAL PROTECTION ----
+     * Cycle times saturate at ~4.3 s, so a longer budget would never be
+     * exceeded */
+    if (budget_us_in > KERNEL_MAX_CYCLE_BUDGET_US) {
+        DEBUG_WRN(
+            "Cycle budget of %lu us clamped to %lu us",
+            (unsigned long)budget_us_in,
+            (unsigned long)KERNEL_MAX_CYCLE_BUDGET_US
+        );
+        budget_us_in = KERNEL_MAX_CYCLE_BUDGET_US;
+    }
+
+    DP.KERNEL.CYCLE_BUDGET_US = budget_us_in;
+}
+
+void Kernel_start_cycle_profile(void) {
+    KERNEL_CYCLE_WORST_MOD_ID = MOD_ID_KERNEL;
+    KERNEL_CYCLE_WORST_MOD_NS = 0;
+    KERNEL_CYCLE_START = Kernel_start_step_profile();
+}
+
+void Kernel_end_cycle_profile(void) {
+    uint32_t elapsed_ns = Kernel_get_elapsed_ns(KERNEL_CYCLE_START);
+
+    if (elapsed_ns > DP.KERNEL.CYCLE_MAX_NS) {
+        DP.KERNEL.CYCLE_MAX_NS = elapsed_ns;
+    }
+
+    #ifdef TARGET_UNIX
+    /* Whether a cycle overruns depends on the speed of the host, so raising
+     * an event for it, or reading the RTC for its timestamp, would make the
+     * replay diverge from the recording */
+    if (Replay_is_recording() || Replay_is_replaying()) {
+        return;
+    }
+    #endif
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The cycle time saturates at UINT32_MAX ns, so the budget is limited to
+     * KERNEL_MAX_CYCLE_BUDGET_US by Kernel_set_cycle_budget() and a saturated
+     * cycle still overruns it. */
+    if (DP.KERNEL.CYCLE_BUDGET_US == 0
+        ||
+        (elapsed_ns / 1000UL) <= DP.KERNEL.CYCLE_BUDGET_US
+    ) {
+        return;
+    }
+
+    if (DP.KERNEL.NUM_CYCLE_OVERRUNS != UINT32_MAX) {
+        DP.KERNEL.NUM_CYCLE_OVERRUNS++;
+    }
+
+    /* The timestamp is only valid once the RTC is running */
+    DP.KERNEL.LAST_OVERRUN_TIMESTAMP
+        = DP.RTC_INITIALISED ? Rtc_get_timestamp() : 0;
+    DP.KERNEL.LAST_OVERRUN_NS = elapsed_ns;
+    DP.KERNEL.LAST_OVERRUN_MOD_ID = KERNEL_CYCLE_WORST_MOD_ID;
+    DP.KERNEL.LAST_OVERRUN_MOD_NS = KERNEL_CYCLE_WORST_MOD_NS;
+
+    DEBUG_WRN(
+        "Cycle overran budget: %lu ns, longest step 0x%02X took %lu ns",
+        (unsigned long)elapsed_ns,
+        (unsigned int)(KERNEL_CYCLE_WORST_MOD_ID >> KERNEL_MOD_ID_SHIFT),
+        (unsigned long)KERNEL_CYCLE_WORST_MOD_NS
+    );
+
+    /* An error is already flagged in DP.EVENTMANAGER if this fails, and the
+     * overrun is still recorded in the DataPool */
+    (void)EventManager_raise_event(EVT_KERNEL_CYCLE_OVERRUN);
+}
+
+void Kernel_print_step_profile(void) {
+    char str[KERNEL_STEP_PROFILE_STRING_MAX_LENGTH] = "PROF";
+    size_t length = strlen(str);
+    int num_chars;
+
+    for (size_t i = 0; i < KERNEL_NUM_MODULE_IDS; ++i) {
+        if (DP.KERNEL.STEP_COUNT[i] == 0) {
+            continue;
+        }
+
+        num_chars = snprintf(
+            &str[length],
+            sizeof(str) - length,
+            " %02X:%lu/%lu/%lu/%lu",
+            (unsigned int)i,
+            (unsigned long)DP.KERNEL.STEP_COUNT[i],
+            (unsigned long)DP.KERNEL.STEP_MIN_NS[i],
+            (unsigned long)DP.KERNEL.STEP_MEAN_NS[i],
+            (unsigned long)DP.KERNEL.STEP_MAX_NS[i]
+        );
+
+        /* If this module didn't fit remove it and stop */
+        if (num_chars < 0 || (size_t)num_chars >= sizeof(str) - length) {
+            str[length] = '\0';
+            break;
+        }
+        length += (size_t)num_chars;
+    }
+
+    DEBUG_INF("%s", str);
+}
+
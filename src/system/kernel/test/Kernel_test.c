@@ -28,7 +28,11 @@
 #include "drivers/uart/Uart_errors.h"
 #include "components/eps/Eps_errors.h"
 #include "applications/power/Power_errors.h"
+#include "system/event_manager/EventManager_errors.h"
 #include "system/kernel/Kernel_public.h"
+#include "system/data_pool/DataPool_public.h"
+#include "system/event_manager/EventManager_public.h"
+#include "system/kernel/Kernel_events.h"
 
 /* -------------------------------------------------------------------------   
  * TESTS
@@ -106,6 +110,270 @@ static void Kernel_test_error_serialisation(void **state) {
     return 0;
 }
 
+/**
+ * @brief Test the error chain which caused a reboot is recovered from the
+ * crash log after it
+ * 
+ * @param state cmocka state
+ */
+static void Kernel_test_reboot_error(void **state) {
+    (void) state;
+    Error eventmanager_error, kernel_error;
+    uint8_t expected_bytes[4] = {0};
+    uint8_t expected_length = 0;
+
+    /* The chain Kernel_init_critical_modules() would give if EventManager
+     * failed to init */
+    eventmanager_error.code = EVENTMANAGER_ERROR_MAX_EVENTS_REACHED;
+    eventmanager_error.p_cause = NULL;
+    kernel_error.code = KERNEL_ERROR_EVENTMANAGER_INIT_FAILED;
+    kernel_error.p_cause = &eventmanager_error;
+    Kernel_error_to_bytes(&kernel_error, expected_bytes, &expected_length);
+
+    /* Start a new crash log, then save the error as a reboot would */
+    Debug_crash_log_recover();
+    Kernel_save_reboot_error(&kernel_error);
+
+    assert_true(Debug_crash_log_recover());
+    assert_int_equal(DP.DEBUG_CRASH_REASON, DEBUG_CRASH_REASON_REBOOT);
+    assert_int_equal(DP.DEBUG_CRASH_ERROR_LENGTH, 4);
+    assert_int_equal(expected_length, 4);
+    assert_memory_equal(
+        DP.DEBUG_CRASH_ERROR_BYTES,
+        expected_bytes,
+        sizeof(expected_bytes)
+    );
+
+    /* A reboot without an error keeps the reason but no chain */
+    Kernel_save_reboot_error(NULL);
+    assert_true(Debug_crash_log_recover());
+    assert_int_equal(DP.DEBUG_CRASH_REASON, DEBUG_CRASH_REASON_REBOOT);
+    assert_int_equal(DP.DEBUG_CRASH_ERROR_LENGTH, 0);
+}
+
+/**
+ * @brief Test the step profiler records step times against module IDs
+ * 
+ * @param state cmocka state
+ */
+static void Kernel_test_step_profile(void **state) {
+    (void) state;
+    size_t eps_idx = MOD_ID_EPS >> KERNEL_MOD_ID_SHIFT;
+    uint32_t start;
+
+    DataPool_init();
+    Kernel_init_step_profile();
+
+    /* Nothing has been profiled yet */
+    for (size_t i = 0; i < KERNEL_NUM_MODULE_IDS; ++i) {
+        assert_int_equal(DP.KERNEL.STEP_COUNT[i], 0);
+    }
+
+    /* Profile a short step and one that started 1 ms ago */
+    start = Kernel_start_step_profile();
+    Kernel_end_step_profile(MOD_ID_EPS, start);
+    Kernel_end_step_profile(
+        MOD_ID_EPS, 
+        Kernel_start_step_profile() - (1000000 / KERNEL_PROFILE_LINUX_TICK_NS)
+    );
+
+    assert_int_equal(DP.KERNEL.STEP_COUNT[eps_idx], 2);
+    assert_true(DP.KERNEL.STEP_MIN_NS[eps_idx] < 1000000);
+    assert_true(DP.KERNEL.STEP_MAX_NS[eps_idx] >= 1000000);
+    assert_true(DP.KERNEL.STEP_MEAN_NS[eps_idx] >= 500000);
+    assert_true(
+        DP.KERNEL.STEP_MEAN_NS[eps_idx] <= DP.KERNEL.STEP_MAX_NS[eps_idx]
+    );
+
+    /* Other modules are unaffected */
+    assert_int_equal(DP.KERNEL.STEP_COUNT[MOD_ID_POWER >> KERNEL_MOD_ID_SHIFT], 0);
+
+    /* An interval too long for nanoseconds in 32 bits saturates */
+    assert_int_equal(
+        Kernel_get_elapsed_ns(Kernel_start_step_profile() - 0x80000000UL),
+        UINT32_MAX
+    );
+
+    Kernel_print_step_profile();
+
+    /* Init clears the profile */
+    Kernel_init_step_profile();
+    assert_int_equal(DP.KERNEL.STEP_COUNT[eps_idx], 0);
+    assert_int_equal(DP.KERNEL.STEP_MAX_NS[eps_idx], 0);
+}
+
+/**
+ * @brief Test cycles which overrun the budget are recorded against the
+ * longest step
+ * 
+ * @param state cmocka state
+ */
+static void Kernel_test_cycle_overrun(void **state) {
+    (void) state;
+    uint32_t start;
+
+    DataPool_init();
+    assert_true(EventManager_init());
+    Kernel_init_step_profile();
+
+    /* With no budget a slow cycle is timed but isn't an overrun */
+    Kernel_start_cycle_profile();
+    start = Kernel_start_step_profile();
+    while (Kernel_get_elapsed_ns(start) < 10000) {}
+    Kernel_end_cycle_profile();
+
+    assert_true(DP.KERNEL.CYCLE_MAX_NS >= 10000);
+    assert_int_equal(DP.KERNEL.NUM_CYCLE_OVERRUNS, 0);
+    assert_false(EventManager_is_event_raised(EVT_KERNEL_CYCLE_OVERRUN));
+
+    /* Overrun a 1 us budget, with EPS taking the longest step */
+    Kernel_set_cycle_budget(1);
+    Kernel_start_cycle_profile();
+    start = Kernel_start_step_profile();
+    Kernel_end_step_profile(MOD_ID_POWER, start - 100000);
+    Kernel_end_step_profile(MOD_ID_EPS, start - 2000000);
+    while (Kernel_get_elapsed_ns(start) < 10000) {}
+    Kernel_end_cycle_profile();
+
+    assert_int_equal(DP.KERNEL.NUM_CYCLE_OVERRUNS, 1);
+    assert_true(DP.KERNEL.LAST_OVERRUN_NS >= 10000);
+    assert_int_equal(DP.KERNEL.LAST_OVERRUN_MOD_ID, MOD_ID_EPS);
+    assert_true(DP.KERNEL.LAST_OVERRUN_MOD_NS >= 2000000);
+    assert_true(DP.KERNEL.CYCLE_MAX_NS >= DP.KERNEL.LAST_OVERRUN_NS);
+
+    /* The RTC isn't running so there's no timestamp */
+    assert_int_equal(DP.KERNEL.LAST_OVERRUN_TIMESTAMP, 0);
+    assert_true(EventManager_is_event_raised(EVT_KERNEL_CYCLE_OVERRUN));
+
+    /* A cycle within the budget leaves the last overrun alone. A budget
+     * longer than the saturated cycle time is clamped. */
+    Kernel_set_cycle_budget(UINT32_MAX);
+    assert_int_equal(DP.KERNEL.CYCLE_BUDGET_US, KERNEL_MAX_CYCLE_BUDGET_US);
+    Kernel_start_cycle_profile();
+    Kernel_end_step_profile(MOD_ID_POWER, Kernel_start_step_profile());
+    Kernel_end_cycle_profile();
+
+    assert_int_equal(DP.KERNEL.NUM_CYCLE_OVERRUNS, 1);
+    assert_int_equal(DP.KERNEL.LAST_OVERRUN_MOD_ID, MOD_ID_EPS);
+
+    EventManager_destroy();
+}
+
+/**
+ * @brief Test the used stack is found from the deepest overwritten paint
+ * 
+ * @param state cmocka state
+ */
+static void Kernel_test_stack_used(void **state) {
+    (void) state;
+    uint32_t stack[16];
+    size_t i;
+
+    for (i = 0; i < 16; ++i) {
+        stack[i] = KERNEL_STACK_PAINT_WORD;
+    }
+
+    /* Untouched */
+    assert_int_equal(Kernel_get_stack_used(&stack[0], &stack[16]), 0);
+
+    /* Used from the top down, with some paint left between used words */
+    stack[15] = 0;
+    stack[12] = 0;
+    assert_int_equal(Kernel_get_stack_used(&stack[0], &stack[16]), 16);
+
+    /* All used */
+    stack[0] = 0;
+    assert_int_equal(
+        Kernel_get_stack_used(&stack[0], &stack[16]), 
+        sizeof(stack)
+    );
+}
+
+/**
+ * @brief Test heap blocks come from the smallest class which fits, and that
+ * the statistics in DP.KERNEL follow allocations and frees
+ * 
+ * @param state cmocka state
+ */
+static void Kernel_test_heap(void **state) {
+    (void) state;
+    void *p_blocks[2];
+    void *p_small;
+    void *p_fallback;
+
+    DataPool_init();
+    Kernel_init_heap();
+
+    assert_true(DP.KERNEL.HEAP_SIZE_BYTES > 0);
+    assert_int_equal(DP.KERNEL.HEAP_USED_BYTES, 0);
+
+    /* A small request takes a whole 16 byte block */
+    p_small = Kernel_malloc(10);
+    assert_non_null(p_small);
+    assert_int_equal((uintptr_t)p_small % 8, 0);
+    assert_int_equal(DP.KERNEL.HEAP_USED_BYTES, 16);
+    assert_int_equal(DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS[0], 1);
+
+    /* Use up the largest class, after which large requests fail */
+    p_blocks[0] = Kernel_malloc(KERNEL_HEAP_MAX_ALLOC_BYTES);
+    p_blocks[1] = Kernel_malloc(KERNEL_HEAP_MAX_ALLOC_BYTES);
+    assert_non_null(p_blocks[0]);
+    assert_non_null(p_blocks[1]);
+    assert_true(p_blocks[0] != p_blocks[1]);
+    assert_null(Kernel_malloc(KERNEL_HEAP_MAX_ALLOC_BYTES));
+    assert_null(Kernel_malloc(KERNEL_HEAP_MAX_ALLOC_BYTES + 1));
+    assert_int_equal(DP.KERNEL.NUM_HEAP_ALLOC_FAILURES, 2);
+    assert_int_equal(
+        DP.KERNEL.HEAP_USED_BYTES, 
+        16 + (2 * KERNEL_HEAP_MAX_ALLOC_BYTES)
+    );
+
+    /* Freed blocks are reused, and the peak is kept */
+    Kernel_free(p_blocks[1]);
+    assert_int_equal(DP.KERNEL.HEAP_USED_BYTES, 16 + KERNEL_HEAP_MAX_ALLOC_BYTES);
+    assert_int_equal(
+        DP.KERNEL.HEAP_PEAK_BYTES, 
+        16 + (2 * KERNEL_HEAP_MAX_ALLOC_BYTES)
+    );
+    assert_true(Kernel_malloc(300) == p_blocks[1]);
+
+    /* A request from a used up class falls back to a larger one */
+    Kernel_free(p_blocks[0]);
+    while (DP.KERNEL.HEAP_CLASS_PEAK_BLOCKS[4] < 4) {
+        assert_non_null(Kernel_malloc(256));
+    }
+    p_fallback = Kernel_malloc(256);
+    assert_true(p_fallback == p_blocks[0]);
+
+    /* Freeing NULL does nothing, and a pointer which isn't a block is
+     * rejected */
+    Kernel_free(NULL);
+    assert_int_equal(DP.KERNEL.NUM_HEAP_INVALID_FREES, 0);
+    Kernel_free((uint8_t *)p_small + 1);
+    assert_int_equal(DP.KERNEL.NUM_HEAP_INVALID_FREES, 1);
+    Kernel_free(p_small);
+    Kernel_free(p_fallback);
+    assert_int_equal(
+        DP.KERNEL.HEAP_USED_BYTES, 
+        (4 * 256) + KERNEL_HEAP_MAX_ALLOC_BYTES
+    );
+
+    /* A double free is rejected, so the block is only handed out once */
+    Kernel_free(p_small);
+    assert_int_equal(DP.KERNEL.NUM_HEAP_INVALID_FREES, 2);
+    assert_int_equal(
+        DP.KERNEL.HEAP_USED_BYTES, 
+        (4 * 256) + KERNEL_HEAP_MAX_ALLOC_BYTES
+    );
+    assert_true(Kernel_malloc(16) == p_small);
+    assert_true(Kernel_malloc(16) != p_small);
+
+    /* Reinitialising frees everything */
+    Kernel_init_heap();
+    assert_int_equal(DP.KERNEL.HEAP_USED_BYTES, 0);
+    assert_int_equal(DP.KERNEL.NUM_HEAP_ALLOC_FAILURES, 0);
+    assert_int_equal(DP.KERNEL.NUM_HEAP_INVALID_FREES, 0);
+}
 
 /* -------------------------------------------------------------------------   
  * TEST GROUP
@@ -117,5 +385,20 @@ static void Kernel_test_error_serialisation(void **state) {
 const struct CMUnitTest kernel_tests[] = {
     cmocka_unit_test(
         Kernel_test_error_serialisation
+    ),
+    cmocka_unit_test(
+        Kernel_test_reboot_error
+    ),
+    cmocka_unit_test(
+        Kernel_test_step_profile
+    ),
+    cmocka_unit_test(
+        Kernel_test_cycle_overrun
+    ),
+    cmocka_unit_test(
+        Kernel_test_stack_used
+    ),
+    cmocka_unit_test(
+        Kernel_test_heap
     )
 };
\ No newline at end of file
@@ -222,6 +222,19 @@ void MemStoreManager_debug_print_cfg(void) {
         DEBUG_INF("        %d: %s", mode, mode_app_list);
     }
     DEBUG_INF("    ]");
+    DEBUG_INF("    MODULE_STEP_RATE_TABLE: [");
+    for (int i = 0; i < CFG.MODULE_STEP_RATE_TABLE_LENGTH
+        && i < MEMSTOREMANAGER_MAX_NUM_STEP_RATES; i++
+    ) {
+        DEBUG_INF(
+            "        0x%02X: period %u phase %u",
+            CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_MOD_ID],
+            CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_PERIOD],
+            CFG.MODULE_STEP_RATE_TABLE[i][MEMSTOREMANAGER_STEP_RATE_PHASE]
+        );
+    }
+    DEBUG_INF("    ]");
+    DEBUG_INF("    KERNEL_CYCLE_BUDGET_US: %lu", (unsigned long)CFG.KERNEL_CYCLE_BUDGET_US);
 }
 
 void MemStoreManager_debug_print_pers(void) {
@@ -51,6 +51,39 @@
 #include "system/mem_store_manager/MemStoreManager_errors.h"
 #include "system/mem_store_manager/MemStoreManager_events.h"
 
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Maximum number of modules whose step rate can be set in
+ * CFG.MODULE_STEP_RATE_TABLE.
+ */
+#define MEMSTOREMANAGER_MAX_NUM_STEP_RATES (8)
+
+/**
+ * @brief Index of the (unshifted) module ID in an entry of
+ * CFG.MODULE_STEP_RATE_TABLE.
+ */
+#define MEMSTOREMANAGER_STEP_RATE_MOD_ID (0)
+
+/**
+ * @brief Index of the step period, in cycles, in an entry of
+ * CFG.MODULE_STEP_RATE_TABLE.
+ */
+#define MEMSTOREMANAGER_STEP_RATE_PERIOD (1)
+
+/**
+ * @brief Index of the step phase, in cycles, in an entry of
+ * CFG.MODULE_STEP_RATE_TABLE.
+ */
+#define MEMSTOREMANAGER_STEP_RATE_PHASE (2)
+
+/**
+ * @brief Number of fields in an entry of CFG.MODULE_STEP_RATE_TABLE.
+ */
+#define MEMSTOREMANAGER_STEP_RATE_NUM_FIELDS (3)
+
 /* -------------------------------------------------------------------------   
  * STRUCTS
  * ------------------------------------------------------------------------- */
@@ -138,6 +171,45 @@ typedef struct _MemStoreManager_ConfigData {
      */
     Kernel_AppId OPMODE_APPID_TABLE[OPMODEMANAGER_NUM_OPMODES][OPMODEMANAGER_MAX_NUM_APPS_IN_MODE];
 
+    /**
+     * @brief Number of entries used in MODULE_STEP_RATE_TABLE.
+     * 
+     * A separate count is used rather than marking unused entries with a
+     * module ID, as every module ID, including the Kernel's 0, can be stepped.
+     */
+    uint8_t MODULE_STEP_RATE_TABLE_LENGTH;
+
+    /**
+     * @brief Table overriding the rate at which modules are stepped by the
+     * firmware, so that slow modules can be spread across cycles.
+     * 
+     * Each entry is a module ID, period and phase, indexed with the
+     * MEMSTOREMANAGER_STEP_RATE_x defines. The module is stepped on every
+     * cycle where (cycle % period) == phase, as well as whenever it has work
+     * to do if it provides an is_step_required function. A period of 0 turns
+     * off the periodic steps, see ObcFirmware_StepRate. Only the first
+     * MODULE_STEP_RATE_TABLE_LENGTH entries are used, and modules without an
+     * entry keep the period from the firmware's module table.
+     * 
+     * The fields are 16 bits wide to hold the same periods as the module
+     * table, such as the Kernel's stack scan which runs every 1000 cycles.
+     * 
+     * Modules without an is_step_required function only see events raised in
+     * the EVENTMANAGER_STALE_EVENT_CYCLE_THRESHOLD cycles before their step,
+     * so should only be given a longer period if they don't rely on events.
+     */
+    uint16_t MODULE_STEP_RATE_TABLE[MEMSTOREMANAGER_MAX_NUM_STEP_RATES][MEMSTOREMANAGER_STEP_RATE_NUM_FIELDS];
+
+    /**
+     * @brief Main loop cycle time budget in microseconds, or 0 to disable
+     * overrun detection.
+     * 
+     * Any cycle which takes longer than this, excluding time spent waiting for
+     * interrupts, is recorded in DP.KERNEL and raises
+     * EVT_KERNEL_CYCLE_OVERRUN. At most KERNEL_MAX_CYCLE_BUDGET_US (~4.3 s).
+     */
+    uint32_t KERNEL_CYCLE_BUDGET_US;
+
 } MemStoreManager_ConfigData;
 
 /**
@@ -28,6 +28,8 @@
 #include "applications/power/test/Power_test.c"
 #include "drivers/rtc/test/Rtc_test.c"
 #include "components/eps/test/Eps_test.c"
+#include "drivers/virtual_time/test/VirtualTime_test.c"
+#include "drivers/replay/test/Replay_test.c"
 
 /* -------------------------------------------------------------------------   
  * MAIN
@@ -85,6 +87,20 @@ int main(void) {
         eps_tests,
         NULL, NULL
     );
+
+    /* VirtualTime tests */
+    ret |= cmocka_run_group_tests_name(
+        "VirtualTime",
+        virtualtime_tests,
+        NULL, NULL
+    );
+
+    /* Replay tests */
+    ret |= cmocka_run_group_tests_name(
+        "Replay",
+        replay_tests,
+        NULL, NULL
+    );
     
     return ret;
 }
\ No newline at end of file
@@ -377,6 +377,9 @@ void fail_test(void) {
 }
 
 bool cyclic_processing(void) {
+    /* Raise events queued by interrupts */
+    EventManager_process_isr_events();
+
     /* Step Components */
     if (!Eps_step()) {
         DEBUG_ERR("Error stepping Eps");
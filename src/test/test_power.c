@@ -115,6 +115,9 @@ int main(void) {
     /* Enter main exec loop */
     while (run_loop) {
 
+        /* Raise events queued by interrupts */
+        EventManager_process_isr_events();
+
         /* ---- DRIVERS ---- */
         
         /* Removed: pending changes to UART driver */
@@ -271,11 +274,9 @@ int main(void) {
 
         Kernel_disable_interrupts();
         if (DP.EVENTMANAGER.NUM_RAISED_EVENTS == 0 && check_wfi) {
-            /* Wait for interrupts if no events raised on the TM4C */
-            #ifdef TARGET_TM4C
+            /* Wait for interrupts if no events raised */
             DEBUG_INF("No events, waiting for interrupt...");
-            __asm("WFI");
-            #endif
+            Kernel_wait_for_interrupt();
         }
         Kernel_enable_interrupts();
     }
@@ -82,6 +82,9 @@ int main(void) {
 
     /* Main loop */
     while (test_complete == false) {
+        /* Raise the UART events queued by the interrupts */
+        EventManager_process_isr_events();
+
         switch(test_step) {
             /* Step 0 is to send the bytes */
             case 0:
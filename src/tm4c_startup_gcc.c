@@ -308,6 +308,21 @@ ResetISR(void)
           "        strlt   r2, [r0], #4\n"
           "        blt     zero_loop");
 
+    //
+    // Paint the stack up to the current stack pointer, so that its high water
+    // mark can be found by Kernel_stack_step().  The word must match
+    // KERNEL_STACK_PAINT_WORD.
+    //
+    __asm("    ldr     r0, =_stack\n"
+          "    mov     r1, sp\n"
+          "    ldr     r2, =0xC5C5C5C5\n"
+          "    .thumb_func\n"
+          "paint_loop:\n"
+          "        cmp     r0, r1\n"
+          "        it      lt\n"
+          "        strlt   r2, [r0], #4\n"
+          "        blt     paint_loop");
+
     //
     // Enable the floating-point unit.  This must be done here to handle the
     // case where main() uses floating-point and the function prologue saves
@@ -349,10 +364,9 @@ NmiSR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  debug_fault_handler() keeps the stacked registers in the crash
+// log and resets the system, stopping first if a debugger is attached.
 //
-// FIXME: This is a bad idea in flight, we need to reboot with a root cause.
 //*****************************************************************************
 static void
 FaultISR(void)
@@ -377,7 +391,20 @@ FaultISR(void)
  */
 __attribute__((optimize("O0")))
 void debug_fault_handler(Debug_ContextStateFrame *p_frame) {
-    __asm("BKPT");
+    /* Keep the frame in the crash log, which is reported after the reset */
+    Debug_crash_log_save(DEBUG_CRASH_REASON_FAULT, 0, p_frame, NULL, 0);
+
+    /* Stop if a debugger is attached, without one a breakpoint would lock up
+     * the core rather than reset it */
+    if (HWREG(NVIC_DBG_CTRL) & NVIC_DBG_CTRL_C_DEBUGEN) {
+        __asm("BKPT");
+    }
+
+    /* Reset the system */
+    HWREG(NVIC_APINT) = NVIC_APINT_VECTKEY | NVIC_APINT_SYSRESETREQ;
+    while(1)
+    {
+    }
 }
 
 //*****************************************************************************
@@ -0,0 +1,146 @@
+'''
+Compares two runs of a host benchmark which prints its results as JSON lines,
+such as bench_event_manager_suite.
+
+Capture the output of the benchmark on each commit, for instance:
+```
+./bench_event_manager_suite.exe > before.jsonl
+```
+then compare the two runs with:
+```
+python tool_bench_compare.py before.jsonl after.jsonl
+```
+
+Every result line is a JSON object with the keys `bench`, `workload`,
+`metric`, and `value`. Lines which aren't results, such as debug output, are
+ignored. All metrics are lower is better, apart from those listed in
+INFO_METRICS which describe the configuration of the run.
+'''
+
+import argparse
+import json
+from rich.console import Console
+
+# Metrics which describe the configuration rather than the performance, so
+# any change is highlighted but isn't a regression
+INFO_METRICS = {'list_size', 'max_raised_events', 'raised_high_water'}
+
+def read_results(path):
+    '''
+    Read the results in the given file into a dict keyed by
+    (bench, workload, metric), keeping the order they were printed in.
+    '''
+    results = {}
+
+    with open(path, 'r', errors='replace') as results_f:
+        for line in results_f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+
+            try:
+                result = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+            if not {'bench', 'workload', 'metric', 'value'} <= result.keys():
+                continue
+
+            key = (result['bench'], result['workload'], result['metric'])
+            results[key] = float(result['value'])
+
+    return results
+
+def compare_results(old_results, new_results, threshold):
+    '''
+    Print the change of every result, highlighting those that changed by more
+    than threshold percent.
+
+    Returns the number of regressions.
+    '''
+    console = Console(highlight=False)
+    num_regressions = 0
+
+    console.print(
+        f'{"bench":16} {"workload":16} {"metric":24} '
+        f'{"old":>12} {"new":>12} {"change":>9}'
+    )
+
+    for key in list(old_results) + [k for k in new_results if k not in old_results]:
+        (bench, workload, metric) = key
+        old = old_results.get(key)
+        new = new_results.get(key)
+        name = f'{bench:16} {workload:16} {metric:24}'
+
+        if old is None or new is None:
+            console.print(
+                f'{name} {"-" if old is None else f"{old:12.1f}":>12} '
+                f'{"-" if new is None else f"{new:12.1f}":>12} '
+                f'[yellow]{"missing":>9}[/yellow]'
+            )
+            continue
+
+        change = ((new - old) / old * 100.0) if old != 0 else 0.0
+        change_str = f'{change:+8.1f}%'
+
+        if abs(change) <= threshold:
+            style = None
+        elif metric in INFO_METRICS:
+            style = 'yellow'
+        elif change < 0:
+            style = 'green'
+        else:
+            style = 'red'
+            num_regressions += 1
+
+        if style is not None:
+            change_str = f'[{style}]{change_str}[/{style}]'
+
+        console.print(f'{name} {old:12.1f} {new:12.1f} {change_str}')
+
+    console.print(
+        f'\n[bold]{num_regressions}[/bold] results regressed by more than '
+        f'{threshold}%'
+    )
+
+    return num_regressions
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description='Compare two runs of a host benchmark'
+    )
+    parser.add_argument(
+        'old',
+        help='Results of the baseline run',
+        type=str
+    )
+    parser.add_argument(
+        'new',
+        help='Results of the run to compare against the baseline',
+        type=str
+    )
+    parser.add_argument(
+        '--threshold',
+        help='Percentage change below which results are treated as noise',
+        type=float,
+        default=5.0
+    )
+    parser.add_argument(
+        '--fail-on-regression',
+        help='Exit with a non-zero status if any result regressed',
+        action='store_true'
+    )
+
+    return parser.parse_args()
+
+if __name__ == '__main__':
+    args = _parse_args()
+
+    regressions = compare_results(
+        read_results(args.old),
+        read_results(args.new),
+        args.threshold
+    )
+
+    if args.fail_on_regression and regressions > 0:
+        exit(1)
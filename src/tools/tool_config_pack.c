@@ -29,6 +29,7 @@
 #include "util/debug/Debug_public.h"
 #include "util/crypto/Crypto_public.h"
 #include "system/mem_store_manager/MemStoreManager_public.h"
+#include "system/kernel/Kernel_public.h"
 
 /* -------------------------------------------------------------------------   
  * MAIN
@@ -198,6 +199,86 @@ int main(int argc, char **pp_argv) {
         }
     }
 
+    toml_array_t *p_module_step_rate_table = toml_array_in(
+        p_config,
+        "MODULE_STEP_RATE_TABLE"
+    );
+    if (!p_module_step_rate_table) {
+        DEBUG_ERR("Missing TOML parameter: MODULE_STEP_RATE_TABLE");
+        cfg_ok = false;
+    }
+    else if (toml_array_nelem(p_module_step_rate_table)
+        > 
+        MEMSTOREMANAGER_MAX_NUM_STEP_RATES
+    ) {
+        DEBUG_ERR(
+            "MODULE_STEP_RATE_TABLE has more than %d entries",
+            MEMSTOREMANAGER_MAX_NUM_STEP_RATES
+        );
+        cfg_ok = false;
+    }
+    else {
+        /* Unlike the APPID table this may have fewer entries than the
+         * maximum, the rest are left as 0 and aren't used */
+        cfg_data.MODULE_STEP_RATE_TABLE_LENGTH 
+            = (uint8_t)toml_array_nelem(p_module_step_rate_table);
+        for (int i = 0; 
+            i < toml_array_nelem(p_module_step_rate_table); 
+            ++i
+        ) {
+            toml_array_t *p_step_rate_array = toml_array_at(
+                p_module_step_rate_table,
+                i
+            );
+            if (!p_step_rate_array) {
+                DEBUG_ERR("Missing step rate array %d", i);
+                cfg_ok = false;
+                continue;
+            }
+
+            for (int j = 0; j < MEMSTOREMANAGER_STEP_RATE_NUM_FIELDS; ++j) {
+                toml_datum_t field = toml_int_at(p_step_rate_array, j);
+
+                /* Module IDs are only 8 bits, periods and phases 16 */
+                int64_t max = (j == MEMSTOREMANAGER_STEP_RATE_MOD_ID)
+                    ? UINT8_MAX : UINT16_MAX;
+                if (!field.ok || field.u.i < 0 || field.u.i > max) {
+                    DEBUG_ERR("Invalid field %d of step rate %d", j, i);
+                    cfg_ok = false;
+                }
+                else {
+                    cfg_data.MODULE_STEP_RATE_TABLE[i][j] 
+                        = (uint16_t)field.u.i;
+                }
+            }
+        }
+    }
+
+    toml_datum_t kernel_cycle_budget_us = toml_int_in(
+        p_config, 
+        "KERNEL_CYCLE_BUDGET_US"
+    );
+    if (!kernel_cycle_budget_us.ok
+        ||
+        kernel_cycle_budget_us.u.i < 0
+        ||
+        kernel_cycle_budget_us.u.i > UINT32_MAX
+    ) {
+        DEBUG_ERR("Missing or invalid TOML parameter: KERNEL_CYCLE_BUDGET_US");
+        cfg_ok = false;
+    }
+    else if (kernel_cycle_budget_us.u.i > (int64_t)KERNEL_MAX_CYCLE_BUDGET_US) {
+        DEBUG_WRN(
+            "KERNEL_CYCLE_BUDGET_US clamped to the longest cycle time of %lu",
+            (unsigned long)KERNEL_MAX_CYCLE_BUDGET_US
+        );
+        cfg_data.KERNEL_CYCLE_BUDGET_US = KERNEL_MAX_CYCLE_BUDGET_US;
+    }
+    else {
+        cfg_data.KERNEL_CYCLE_BUDGET_US 
+            = (uint32_t)kernel_cycle_budget_us.u.i;
+    }
+
     /* Exit if config loading didn't work */
     if (!cfg_ok) {
         DEBUG_ERR("Missing TOML parameters, cannot pack config");
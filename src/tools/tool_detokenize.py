@@ -0,0 +1,356 @@
+'''
+Decodes the tokenized debug logs of a firmware built with the
+UOS3_TOKENIZED_LOG CMake option back into the text the logs would have
+printed, see `Debug_public.h` for the record format.
+
+The strings of every log are read from the `uos3_log_tokens` section of the
+firmware's ELF, so the ELF must be from the same build as the firmware
+producing the logs. On linux the executable is the ELF:
+```
+./obc_firmware.exe | python3 tool_detokenize.py obc_firmware.exe
+```
+and on the TM4C the logs are read from the debug UART:
+```
+python3 tool_detokenize.py obc_firmware.elf --serial /dev/ttyUSB0
+```
+
+Anything which isn't a valid record, such as text printed outside the Debug
+module, is passed through unchanged. `tool_obcfw_debug.py` uses the
+`Detokenizer` from here when given an ELF.
+'''
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+
+# Name of the section holding the token strings
+TOKEN_SECTION = 'uos3_log_tokens'
+
+# Record framing, must match the DEBUG_TOKENIZED_* defines in Debug_public.h
+RECORD_SYNC = 0xA5
+RECORD_OVERHEAD = 3
+
+# Separator between the parts of a token string
+TOKEN_SEPARATOR = '\x1f'
+
+# Name and colour of each level, as printed by Debug_log_unix(), indexed by
+# Debug_Level
+LEVELS = [
+    ('ERR', '\x1b[31m'),
+    ('WRN', '\x1b[33m'),
+    ('---', ''),
+    ('DBG', '\x1b[36m'),
+    ('TRC', '\x1b[35m'),
+]
+
+# A printf conversion specification
+CONVERSION_PATTERN = re.compile(
+    r'%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d+))?'
+    r'(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[diouxXeEfFgGaAcsp%])'
+)
+
+def read_elf_section(elf_path, name):
+    '''
+    Read the contents of a section from an ELF file.
+
+    Returns the contents and the size of a pointer in bytes.
+    '''
+    data = Path(elf_path).read_bytes()
+
+    if data[0:4] != b'\x7fELF':
+        raise RuntimeError(f'{elf_path} is not an ELF file')
+
+    is_64 = data[4] == 2
+    endian = '<' if data[5] == 1 else '>'
+
+    # Section header table location, entry size, count and name table index
+    if is_64:
+        shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(
+            endian + 'HHH', data, 0x3A
+        )
+        header_format = endian + 'IIQQQQIIQQ'
+    else:
+        shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(
+            endian + 'HHH', data, 0x2E
+        )
+        header_format = endian + 'IIIIIIIIII'
+
+    # Each header as (name offset, offset in file, size)
+    headers = []
+    for i in range(shnum):
+        fields = struct.unpack_from(header_format, data, shoff + i * shentsize)
+        headers.append((fields[0], fields[4], fields[5]))
+
+    _, names_offset, _ = headers[shstrndx]
+
+    for name_offset, offset, size in headers:
+        start = names_offset + name_offset
+        section_name = data[start:data.index(b'\0', start)].decode('ascii')
+        if section_name == name:
+            return data[offset:offset + size], 8 if is_64 else 4
+
+    raise RuntimeError(
+        f'{elf_path} has no {name} section, was it built with '
+        'UOS3_TOKENIZED_LOG?'
+    )
+
+def read_varint(payload, pos):
+    '''
+    Read an unsigned varint from the payload.
+
+    Returns the value and the position after it.
+    '''
+    value = 0
+    shift = 0
+
+    while True:
+        byte = payload[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte & 0x80 == 0:
+            return value, pos
+
+def read_zigzag(payload, pos):
+    '''
+    Read a zigzag encoded signed varint from the payload.
+
+    Returns the value and the position after it.
+    '''
+    value, pos = read_varint(payload, pos)
+    return (value >> 1) ^ -(value & 1), pos
+
+class Detokenizer:
+    '''
+    Turns a stream of bytes containing tokenized records into lines of text.
+    '''
+
+    def __init__(self, elf_path):
+        section, self.pointer_size = read_elf_section(elf_path, TOKEN_SECTION)
+
+        # Split the section into the strings of each log, keyed by offset
+        self.tokens = {}
+        offset = 0
+        for string in section.split(b'\0'):
+            if len(string) > 0:
+                self.tokens[offset] = string.decode('utf-8', errors='replace')
+            offset += len(string) + 1
+
+        self.buffer = bytearray()
+        self.text = bytearray()
+
+        # Time of the last record, which is 0 until a full time is received
+        self.timestamp = 0
+
+    def feed(self, data):
+        '''
+        Add bytes to the stream.
+
+        Returns the list of lines completed by the bytes.
+        '''
+        lines = []
+        self.buffer += data
+
+        while len(self.buffer) > 0:
+            if self.buffer[0] != RECORD_SYNC:
+                self.add_text(self.buffer[0], lines)
+                del self.buffer[0]
+                continue
+
+            # Wait for the rest of the record
+            if len(self.buffer) < 2:
+                break
+            length = self.buffer[1] + RECORD_OVERHEAD
+            if len(self.buffer) < length:
+                break
+
+            payload = bytes(self.buffer[2:length - 1])
+            line = None
+            if sum(payload) & 0xFF == self.buffer[length - 1]:
+                try:
+                    line = self.decode(payload)
+                except (IndexError, KeyError, ValueError, struct.error):
+                    pass
+
+            # Not a record, so the sync byte was part of some text
+            if line is None:
+                self.add_text(self.buffer[0], lines)
+                del self.buffer[0]
+                continue
+
+            self.flush_text(lines)
+            lines.append(line)
+            del self.buffer[0:length]
+
+        return lines
+
+    def add_text(self, byte, lines):
+        '''
+        Add a byte of text which isn't part of a record.
+        '''
+        if byte == ord('\n'):
+            self.flush_text(lines)
+        elif byte != ord('\r'):
+            self.text.append(byte)
+
+    def flush_text(self, lines):
+        '''
+        End the current line of text.
+        '''
+        if len(self.text) > 0:
+            lines.append(self.text.decode('ascii', errors='replace'))
+            self.text = bytearray()
+
+    def decode(self, payload):
+        '''
+        Decode the payload of a record into a line of text, formatted the same
+        as Debug_log_unix().
+        '''
+        token, pos = read_varint(payload, 0)
+        timestamp, pos = read_varint(payload, pos)
+
+        level, file, line, fmt = self.tokens[token].split(TOKEN_SEPARATOR, 3)
+        level_name, level_colour = LEVELS[int(level)]
+
+        # Remove the file path up to src/
+        if 'src/' in file:
+            file = file[file.index('src/') + 4:]
+
+        message, pos = self.format(fmt, payload, pos)
+        if pos != len(payload):
+            raise ValueError('Record has more arguments than its format')
+
+        # The lowest bit is set for the full time rather than the time since
+        # the last record
+        if timestamp & 1:
+            self.timestamp = timestamp >> 1
+        else:
+            self.timestamp += timestamp >> 1
+
+        return (
+            f'[{self.timestamp:>10} {level_colour}{level_name}\x1b[0m] '
+            f'{file}:{line} {message}'
+        )
+
+    def format(self, fmt, payload, pos):
+        '''
+        Format the arguments in the payload using the printf format string.
+
+        Returns the text and the position after the arguments.
+        '''
+        parts = []
+        last = 0
+
+        for match in CONVERSION_PATTERN.finditer(fmt):
+            parts.append(fmt[last:match.start()])
+            last = match.end()
+
+            conversion = match.group('conversion')
+            if conversion == '%':
+                parts.append('%')
+                continue
+
+            spec = '%' + match.group('flags')
+            for part, prefix in (('width', ''), ('precision', '.')):
+                value = match.group(part)
+                if value == '*':
+                    value, pos = read_zigzag(payload, pos)
+                if value is not None:
+                    spec += f'{prefix}{value}'
+
+            if conversion == 's':
+                length = payload[pos]
+                value = payload[pos + 1:pos + 1 + length].decode(
+                    'utf-8', errors='replace'
+                )
+                pos += 1 + length
+            elif conversion in 'eEfFgGaA':
+                value, = struct.unpack_from('<d', payload, pos)
+                pos += 8
+                if conversion in 'aA':
+                    conversion = 'e'
+            else:
+                value, pos = read_zigzag(payload, pos)
+
+                if conversion in 'ouxXp':
+                    value &= (1 << (8 * self.arg_size(match))) - 1
+                if conversion == 'p':
+                    spec += '#'
+                    conversion = 'x'
+                elif conversion == 'c':
+                    value = chr(value & 0xFF)
+
+            parts.append((spec + conversion) % value)
+
+        parts.append(fmt[last:])
+        return ''.join(parts), pos
+
+    def arg_size(self, match):
+        '''
+        Get the size in bytes of an unsigned integer argument on the target.
+        '''
+        length = match.group('length')
+
+        if match.group('conversion') == 'p' or length in ('l', 'z', 't'):
+            return self.pointer_size
+        if length in ('ll', 'j'):
+            return 8
+        if length == 'h':
+            return 2
+        if length == 'hh':
+            return 1
+        return 4
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description='Decode tokenized debug logs into text'
+    )
+    parser.add_argument(
+        'elf',
+        type=Path,
+        help='The ELF of the firmware producing the logs'
+    )
+    parser.add_argument(
+        'input',
+        nargs='?',
+        type=Path,
+        help='File of logs to decode, or stdin if not given'
+    )
+    parser.add_argument(
+        '--serial',
+        help='Serial port to read the logs from instead'
+    )
+    parser.add_argument(
+        '--baud',
+        type=int,
+        default=115200,
+        help='Baud rate of the serial port'
+    )
+
+    return parser.parse_args()
+
+if __name__ == '__main__':
+    args = _parse_args()
+
+    detokenizer = Detokenizer(args.elf)
+
+    if args.serial is not None:
+        import serial
+        port = serial.Serial(args.serial, args.baud)
+        read = lambda: port.read(max(1, port.in_waiting))
+    elif args.input is not None:
+        stream = open(args.input, 'rb')
+        read = lambda: stream.read(4096)
+    else:
+        read = lambda: sys.stdin.buffer.read1(4096)
+
+    try:
+        for data in iter(read, b''):
+            for line in detokenizer.feed(data):
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
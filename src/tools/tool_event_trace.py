@@ -0,0 +1,184 @@
+'''
+Uses tool_const_lookup to decode an EventManager trace into human readable
+format.
+
+The trace can be given either as captured debug output containing the lines
+printed by `EventManager_dump_trace()`, or as a raw binary dump of
+`EVENTMANAGER.trace` read out with a debugger, for instance with gdb:
+```
+dump binary value trace.bin EVENTMANAGER.trace
+```
+
+The layout of a trace entry must match `EventManager_TraceEntry` in
+`EventManager_public.h`.
+'''
+
+import argparse
+import re
+import struct
+from pathlib import Path
+from rich.console import Console
+from tool_const_lookup import const_lookup
+
+# Format of a single EventManager_TraceEntry: timestamp, event, type, count
+ENTRY_FORMAT = '<IHBB'
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+# Format of the num_entries member following the entries in EventManager_Trace
+NUM_ENTRIES_FORMAT = '<I'
+
+# Number of RTC ticks per second, see Rtc_Timestamp
+RTC_TICKS_PER_SEC = 32768
+
+# Names of the EventManager_TraceType values
+TRACE_TYPES = {
+    0: 'NONE',
+    1: 'RAISE',
+    2: 'POLL',
+    3: 'CLEANUP'
+}
+
+# Patterns matching the lines printed by EventManager_dump_trace()
+BEGIN_PATTERN = re.compile(r'EVTTRACE BEGIN (\d+) (\d+)')
+ENTRY_PATTERN = re.compile(r'EVTTRACE ((?:[0-9A-F]{2} ?)+)$')
+END_PATTERN = re.compile(r'EVTTRACE END')
+
+# Regex pattern that splits of ANSI escape sequences
+ANSI_ESCAPE_PATTERN = re.compile(r'(\x9B|\x1B\[)[0-?]*[ -\/]*[@-~]')
+
+def read_log_trace(path):
+    '''
+    Read the entries of the last trace dump in the given debug output file.
+
+    Returns the total number of entries ever recorded and the list of entries,
+    oldest first.
+    '''
+    num_entries = 0
+    entries = []
+    in_dump = False
+
+    with open(path, 'r', errors='replace') as log_f:
+        for line in log_f:
+            line = ANSI_ESCAPE_PATTERN.sub('', line).rstrip()
+
+            match = BEGIN_PATTERN.search(line)
+            if match is not None:
+                num_entries = int(match.group(1))
+                entries = []
+                in_dump = True
+                continue
+
+            if not in_dump:
+                continue
+
+            if END_PATTERN.search(line) is not None:
+                in_dump = False
+                continue
+
+            match = ENTRY_PATTERN.search(line)
+            if match is not None:
+                entry_bytes = bytes.fromhex(match.group(1))
+                entries.append(struct.unpack(ENTRY_FORMAT, entry_bytes))
+
+    return num_entries, entries
+
+def read_binary_trace(path):
+    '''
+    Read the entries of a raw binary dump of EVENTMANAGER.trace.
+
+    Returns the total number of entries ever recorded and the list of entries,
+    oldest first.
+    '''
+    data = Path(path).read_bytes()
+
+    # The dump is the array of entries followed by the entry counter
+    ring_size = (len(data) - struct.calcsize(NUM_ENTRIES_FORMAT)) // ENTRY_SIZE
+    (num_entries,) = struct.unpack_from(
+        NUM_ENTRIES_FORMAT,
+        data,
+        ring_size * ENTRY_SIZE
+    )
+    ring = [
+        struct.unpack_from(ENTRY_FORMAT, data, i * ENTRY_SIZE)
+        for i in range(ring_size)
+    ]
+
+    # Unwrap the ring so the oldest entry comes first
+    if num_entries <= ring_size:
+        return num_entries, ring[:num_entries]
+
+    first = num_entries % ring_size
+    return num_entries, ring[first:] + ring[:first]
+
+def event_symbol(event, cache):
+    '''
+    Get the symbol of the given event from the constants database.
+    '''
+    if event not in cache:
+        consts = const_lookup(f'0x{event:04X}', const_type='events')
+
+        if len(consts) == 0:
+            cache[event] = '[red]Unknown[/red]'
+        else:
+            cache[event] = ' / '.join(c['symbol'] for c in consts)
+
+    return cache[event]
+
+def print_trace(num_entries, entries):
+    '''
+    Print a human-readable version of the given trace entries.
+    '''
+    console = Console(highlight=False)
+    symbols = {}
+
+    console.print(
+        f'[bold]Event trace[/bold]: {len(entries)} of {num_entries} entries'
+    )
+    if num_entries > len(entries):
+        console.print(
+            f'    [yellow]{num_entries - len(entries)} older entries were '
+            'overwritten[/yellow]'
+        )
+
+    # Timestamps only hold the low 32 bits of the RTC, so unwrap them relative
+    # to the first entry
+    elapsed = 0
+    prev_timestamp = None
+
+    for (timestamp, event, trace_type, count) in entries:
+        if prev_timestamp is not None:
+            elapsed += (timestamp - prev_timestamp) & 0xFFFFFFFF
+        prev_timestamp = timestamp
+
+        console.print(
+            f'    {elapsed / RTC_TICKS_PER_SEC:12.6f} s  '
+            f'{TRACE_TYPES.get(trace_type, "UNKNOWN"):8} '
+            f'0x{event:04X} x{count:<3} '
+            f'[bold][cyan]{event_symbol(event, symbols)}[/cyan][/bold]'
+        )
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description='Decode an EventManager trace into human readable format'
+    )
+    parser.add_argument(
+        'trace',
+        help='Debug output containing an EVTTRACE dump, or with --binary a '
+            'raw dump of EVENTMANAGER.trace',
+        type=str
+    )
+    parser.add_argument(
+        '--binary',
+        help='Interpret the trace file as a raw binary dump',
+        action='store_true'
+    )
+
+    return parser.parse_args()
+
+if __name__ == '__main__':
+    args = _parse_args()
+
+    if args.binary:
+        print_trace(*read_binary_trace(args.trace))
+    else:
+        print_trace(*read_log_trace(args.trace))
@@ -1,5 +1,8 @@
 '''
 A tool to aid debugging of the obc-firmware
+
+If the firmware was built with the UOS3_TOKENIZED_LOG CMake option pass its ELF
+with `--elf` so that the logs can be decoded, see tool_detokenize.py.
 '''
 
 import argparse
@@ -15,6 +18,7 @@ import json
 import dataclasses
 from dataclasses import dataclass, field
 import npyscreen
+from tool_detokenize import Detokenizer
 
 # Whether or not we're running on a POSIX system (linux, mac etc.)
 ON_POSIX = 'posix' in sys.builtin_module_names
@@ -48,7 +52,7 @@ class ObcFwInstance:
     def __init__(self):
         self.log_lines = []
 
-    def init(self, root_path, exec_path = None):
+    def init(self, root_path, exec_path = None, elf_path = None):
         # If given an exec path need to open the process and connect a new
         # thread which will pull log messages out of stdout.
         if exec_path is not None:
@@ -58,9 +62,16 @@ class ObcFwInstance:
                 close_fds=ON_POSIX
             )
             self.queue = Queue()
+
+            # Tokenized logs are decoded into lines as they're read
+            if elf_path is not None:
+                detokenizer = Detokenizer(elf_path)
+            else:
+                detokenizer = None
+
             self.thread = Thread(
                 target=ObcFwInstance.enqueue_output, 
-                args=(self.process.stdout, self.queue)
+                args=(self.process.stdout, self.queue, detokenizer)
             )
             self.thread.daemon = True
             self.thread.start()
@@ -97,9 +108,14 @@ class ObcFwInstance:
             self.log_lines.append(LogLine.parse(line_ascii))
 
     @staticmethod
-    def enqueue_output(out, queue):
-        for line in iter(out.readline, b''):
-            queue.put(line)
+    def enqueue_output(out, queue, detokenizer=None):
+        if detokenizer is None:
+            for line in iter(out.readline, b''):
+                queue.put(line)
+        else:
+            for data in iter(lambda: out.read1(4096), b''):
+                for line in detokenizer.feed(data):
+                    queue.put(line.encode('ascii', errors='replace'))
         out.close()
     
     def set_filter(self, filter_cmd):
@@ -220,9 +236,10 @@ class LogLine:
 # ----------------------------------------------------------------------------
 
 class DebugApp(npyscreen.NPSApp):
-    def __init__(self, root_path, exec_path=None):
+    def __init__(self, root_path, exec_path=None, elf_path=None):
         self.root_path = root_path
         self.exec_path = exec_path
+        self.elf_path = elf_path
 
     def main(self):
         df = DebugForm()
@@ -233,7 +250,11 @@ class DebugApp(npyscreen.NPSApp):
             df.wStatus1.value = ' OBC-FIRMWARE DEBUG: serial '
 
         df.wStatus2.value = ''
-        df.value.init(self.root_path, exec_path=self.exec_path)
+        df.value.init(
+            self.root_path,
+            exec_path=self.exec_path,
+            elf_path=self.elf_path
+        )
         df.keypress_timeout = 1
 
         df.edit()
@@ -289,10 +310,15 @@ if __name__ == '__main__':
         'executable', metavar='E', type=str, nargs='?',
         help='executable to run, or none to connect to serial'
     )
+    parser.add_argument(
+        '--elf', type=Path,
+        help='ELF of a tokenized log build, usually the executable itself'
+    )
     args = parser.parse_args()
 
     da = DebugApp(
         root_path,
-        exec_path=args.executable
+        exec_path=args.executable,
+        elf_path=args.elf
     )
     da.run()
\ No newline at end of file
@@ -0,0 +1,254 @@
+'''
+Reports the stack usage of a firmware executable per module, from the `.su`
+files written by GCC's `-fstack-usage` and, if the compiler supports it, the
+`.ci` call graphs written by `-fcallgraph-info=su`.
+
+Configure a build with the UOS3_STACK_USAGE CMake option, then run the
+`stack_usage_report` target, which calls:
+```
+python3 tool_stack_usage.py <build_dir> --target obc_firmware
+```
+
+For each module (CMake library) linked into the target this prints the
+number of functions, the sum of their frames, and the largest frame. It then
+prints the deepest call chain from `--root`, which is the worst case stack
+use of the main loop excluding interrupts. The chain is a lower bound if it
+reaches functions whose frames are unknown, such as the standard library,
+calls through function pointers, or recursion, all of which are listed so
+that margin can be left for them when sizing STACKSIZE in tm4c123g.cmake.
+'''
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+# Line of a .su file: "file:line:col:function<TAB>bytes<TAB>qualifiers"
+SU_PATTERN = re.compile(r'^(.*):(\d+):(\d+):(.+)\t(\d+)\t(\S+)$')
+
+# Node and edge of a .ci file, which is in VCG format
+CI_NODE_PATTERN = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+CI_EDGE_PATTERN = re.compile(
+    r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"'
+)
+
+# Frame size within the label of a .ci node
+CI_BYTES_PATTERN = re.compile(r'\\n(\d+) bytes \((\w+)')
+
+# Title GCC gives calls through function pointers in .ci files
+CI_INDIRECT_CALL = '__indirect_call'
+
+# Library archive in a link.txt, i.e. "../system/kernel/libKernel.a"
+LINK_LIB_PATTERN = re.compile(r'(\S*lib(\w+)\.a)\b')
+
+def find_object_dirs(build_dir, target):
+    '''
+    Find the object directories of the target and every library linked into
+    it, from the target's link.txt.
+
+    Returns a dict of module name to object directory.
+    '''
+    matches = list(build_dir.glob(f'**/CMakeFiles/{target}.dir/link.txt'))
+    if len(matches) == 0:
+        raise RuntimeError(f'No link.txt for target {target} in {build_dir}')
+
+    link_txt = matches[0]
+    target_dir = link_txt.parent
+    exe_dir = target_dir.parent.parent
+    dirs = {target: target_dir}
+
+    for match in LINK_LIB_PATTERN.finditer(link_txt.read_text()):
+        lib_path = (exe_dir / match.group(1)).resolve()
+        name = match.group(2)
+        dirs[name] = lib_path.parent / 'CMakeFiles' / f'{name}.dir'
+
+    return dirs
+
+def read_su_files(obj_dir):
+    '''
+    Read all .su files in the given object directory.
+
+    Returns a list of (function, bytes, qualifiers, location).
+    '''
+    frames = []
+
+    for su_path in sorted(obj_dir.glob('**/*.su')):
+        for line in su_path.read_text().splitlines():
+            match = SU_PATTERN.match(line)
+            if match is None:
+                continue
+
+            location = f'{Path(match.group(1)).name}:{match.group(2)}'
+            frames.append((
+                match.group(4),
+                int(match.group(5)),
+                match.group(6),
+                location
+            ))
+
+    return frames
+
+def read_ci_files(obj_dirs):
+    '''
+    Read the call graph from all .ci files in the given object directories.
+
+    Returns a dict of node title to frame size in bytes (None if unknown) and
+    a dict of node title to the set of titles it calls.
+    '''
+    frames = {}
+    calls = {}
+
+    for obj_dir in obj_dirs:
+        for ci_path in sorted(obj_dir.glob('**/*.ci')):
+            text = ci_path.read_text()
+
+            for match in CI_NODE_PATTERN.finditer(text):
+                title, label = match.group(1), match.group(2)
+                bytes_match = CI_BYTES_PATTERN.search(label)
+
+                # Functions defined in another file appear without a size,
+                # don't let them hide the definition
+                if bytes_match is not None:
+                    frames[title] = int(bytes_match.group(1))
+                else:
+                    frames.setdefault(title, None)
+
+            for match in CI_EDGE_PATTERN.finditer(text):
+                calls.setdefault(match.group(1), set()).add(match.group(2))
+
+    return frames, calls
+
+def deepest_chain(root, frames, calls):
+    '''
+    Find the call chain from root which uses the most stack.
+
+    Returns the chain as a list of titles, its total size in bytes, and the
+    set of titles reached whose usage is unknown. Recursive calls are counted
+    once and reported as unknown.
+    '''
+    memo = {}
+    unknown = set()
+
+    def visit(title, path):
+        if title in path:
+            unknown.add(f'{title} (recursive)')
+            return ([], 0)
+
+        if title in memo:
+            return memo[title]
+
+        size = frames.get(title)
+        if size is None:
+            unknown.add(title)
+            size = 0
+
+        best_chain, best_size = [], 0
+        path.add(title)
+        for callee in sorted(calls.get(title, ())):
+            chain, chain_size = visit(callee, path)
+            if chain_size > best_size or len(best_chain) == 0:
+                best_chain, best_size = chain, chain_size
+        path.remove(title)
+
+        memo[title] = ([title] + best_chain, size + best_size)
+        return memo[title]
+
+    chain, total = visit(root, set())
+    return chain, total, unknown
+
+def print_module_report(obj_dirs):
+    '''
+    Print the stack usage of each module, largest frame first.
+    '''
+    rows = []
+
+    for name, obj_dir in obj_dirs.items():
+        frames = read_su_files(obj_dir)
+        if len(frames) == 0:
+            continue
+
+        largest = max(frames, key=lambda frame: frame[1])
+        unbounded = [f for f in frames if 'dynamic' in f[2]]
+        rows.append((name, len(frames), sum(f[1] for f in frames), largest,
+            unbounded))
+
+    if len(rows) == 0:
+        print('No .su files found, was the build configured with '
+            'UOS3_STACK_USAGE?')
+        return False
+
+    rows.sort(key=lambda row: row[3][1], reverse=True)
+
+    print(f'{"Module":<20} {"Funcs":>5} {"Sum":>7} {"Max":>6}  Largest frame')
+    for name, num_funcs, total, largest, unbounded in rows:
+        print(
+            f'{name:<20} {num_funcs:>5} {total:>7} {largest[1]:>6}  '
+            f'{largest[0]} ({largest[3]})'
+        )
+        for func, size, qualifiers, location in unbounded:
+            print(f'{"":<20} {"":>5} {"":>7} {size:>6}  {func} ({location}) '
+                f'is {qualifiers}')
+
+    return True
+
+def print_chain_report(obj_dirs, root):
+    '''
+    Print the deepest call chain from root.
+    '''
+    frames, calls = read_ci_files(obj_dirs.values())
+    if len(frames) == 0:
+        print('\nNo .ci files found, the compiler doesn\'t support '
+            '-fcallgraph-info so the worst case depth isn\'t known')
+        return
+
+    if root not in frames:
+        print(f'\nRoot function {root} not found in the call graph')
+        return
+
+    chain, total, unknown = deepest_chain(root, frames, calls)
+
+    print(f'\nDeepest call chain from {root}: {total} bytes')
+    for title in chain:
+        size = frames.get(title)
+        size = '?' if size is None else size
+        print(f'    {size:>6}  {title}')
+
+    if len(unknown) > 0:
+        print('\nLower bound only, the usage of these is unknown:')
+        for title in sorted(unknown):
+            if title == CI_INDIRECT_CALL:
+                title = 'calls through function pointers'
+            print(f'    {title}')
+
+def _parse_args():
+    parser = argparse.ArgumentParser(
+        description='Report the stack usage of a firmware executable per '
+            'module'
+    )
+    parser.add_argument(
+        'build_dir',
+        type=Path,
+        help='The CMake build directory'
+    )
+    parser.add_argument(
+        '--target',
+        default='obc_firmware',
+        help='The executable target to report on'
+    )
+    parser.add_argument(
+        '--root',
+        default='main',
+        help='The function to find the deepest call chain from'
+    )
+
+    return parser.parse_args()
+
+if __name__ == '__main__':
+    args = _parse_args()
+
+    obj_dirs = find_object_dirs(args.build_dir, args.target)
+
+    if not print_module_report(obj_dirs):
+        sys.exit(1)
+
+    print_chain_report(obj_dirs, args.root)
@@ -0,0 +1,372 @@
+/**
+ * @ingroup debug
+ *
+ * @file Debug_crash_log.c
+ * @author agent (agent@local)
+ * @brief Crash log kept over resets.
+ *
+ * See Debug_public.h for more information.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ */
+
+/* -------------------------------------------------------------------------
+ * INCLUDES
+ * ------------------------------------------------------------------------- */
+
+/* Standard library includes */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* External includes */
+#ifdef TARGET_TM4C
+#include "driverlib/interrupt.h"
+#endif
+
+/* Internal includes */
+#include "util/debug/Debug_public.h"
+#include "util/crypto/Crypto_public.h"
+#include "system/data_pool/DataPool_public.h"
+
+/* -------------------------------------------------------------------------
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Value of Debug_CrashLog.magic, which differs between text and
+ * tokenized builds so that records aren't replayed in the wrong form.
+ */
+#ifdef DEBUG_TOKENIZED
+#define DEBUG_CRASH_LOG_MAGIC (0xC4A5106BU)
+#else
+#define DEBUG_CRASH_LOG_MAGIC (0xC4A5106AU)
+#endif
+
+/**
+ * @brief Line ending of replayed text logs.
+ */
+#ifdef TARGET_TM4C
+#define DEBUG_CRASH_LOG_NEWLINE "\r\n"
+#else
+#define DEBUG_CRASH_LOG_NEWLINE "\n"
+#endif
+
+/* -------------------------------------------------------------------------
+ * GLOBALS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief The crash log. On the TM4C this is in the .noinit section, which
+ * ResetISR() doesn't clear. On linux it only lasts as long as the process,
+ * so there is never a log to recover at startup.
+ */
+#ifdef TARGET_TM4C
+static Debug_CrashLog DEBUG_CRASH_LOG __attribute__((section(".noinit")));
+#else
+static Debug_CrashLog DEBUG_CRASH_LOG;
+#endif
+
+/**
+ * @brief Sequence number of the next log, which is cleared by a reset.
+ */
+static uint16_t DEBUG_CRASH_LOG_NEXT_SEQ;
+
+/**
+ * @brief Whether the log from before the reset has been recovered, so that
+ * new logs can be kept.
+ */
+static bool DEBUG_CRASH_LOG_STARTED;
+
+/* -------------------------------------------------------------------------
+ * FUNCTION PROTOTYPES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Calculate the CRC of a record, which is taken with its crc field set
+ * to 0.
+ *
+ * @param p_record_in The record.
+ * @return uint16_t The CRC.
+ */
+uint16_t Debug_crash_log_record_crc(const Debug_CrashLogRecord *p_record_in);
+
+/**
+ * @brief Calculate the CRC of the crash information.
+ *
+ * @param p_info_in The information.
+ * @return uint32_t The CRC.
+ */
+uint32_t Debug_crash_log_info_crc(const Debug_CrashInfo *p_info_in);
+
+/**
+ * @brief Send the valid records of the crash log to the debug output, oldest
+ * first.
+ *
+ * @return uint32_t The number of records sent.
+ */
+uint32_t Debug_crash_log_replay(void);
+
+/* -------------------------------------------------------------------------
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+uint16_t Debug_crash_log_record_crc(const Debug_CrashLogRecord *p_record_in) {
+    Debug_CrashLogRecord record = *p_record_in;
+    Crypto_Crc16 crc = 0;
+
+    record.crc = 0;
+    Crypto_get_crc16((uint8_t *)&record, sizeof(record), &crc);
+
+    return crc;
+}
+
+uint32_t Debug_crash_log_info_crc(const Debug_CrashInfo *p_info_in) {
+    Crypto_Crc32 crc = 0;
+
+    Crypto_get_crc32(
+        (uint8_t *)p_info_in,
+        offsetof(Debug_CrashInfo, crc),
+        &crc
+    );
+
+    return crc;
+}
+
+void Debug_crash_log_add(
+    uint32_t time_ms_in,
+    const uint8_t *p_bytes_in,
+    size_t length_in
+) {
+    Debug_CrashLogRecord *p_record;
+
+    if (!DEBUG_CRASH_LOG_STARTED || length_in > DEBUG_CRASH_LOG_RECORD_LENGTH) {
+        return;
+    }
+
+    /* Only one log may be kept at once */
+    #ifdef TARGET_TM4C
+    bool int_disabled = IntMasterDisable();
+    #endif
+
+    p_record = &DEBUG_CRASH_LOG.records[
+        DEBUG_CRASH_LOG_NEXT_SEQ % DEBUG_CRASH_LOG_NUM_RECORDS
+    ];
+
+    p_record->time_ms = time_ms_in;
+    p_record->seq = DEBUG_CRASH_LOG_NEXT_SEQ;
+    p_record->length = (uint8_t)length_in;
+    memcpy(p_record->bytes, p_bytes_in, length_in);
+    memset(
+        &p_record->bytes[length_in],
+        0,
+        DEBUG_CRASH_LOG_RECORD_LENGTH - length_in
+    );
+    p_record->crc = Debug_crash_log_record_crc(p_record);
+
+    /*
+     * ---- NUMERICAL PROTECTION ----
+     * The sequence number wraps, which keeps the slots in order as the
+     * number of records divides 65536.
+     */
+    DEBUG_CRASH_LOG_NEXT_SEQ++;
+
+    #ifdef TARGET_TM4C
+    if (!int_disabled) {
+        IntMasterEnable();
+    }
+    #endif
+}
+
+void Debug_crash_log_save(
+    Debug_CrashReason reason_in,
+    int32_t code_in,
+    const Debug_ContextStateFrame *p_frame_in,
+    const uint8_t *p_error_bytes_in,
+    uint8_t error_length_in
+) {
+    Debug_CrashInfo *p_info = &DEBUG_CRASH_LOG.info;
+
+    memset(p_info, 0, sizeof(*p_info));
+
+    p_info->reason = (uint32_t)reason_in;
+    p_info->code = code_in;
+
+    if (p_frame_in != NULL) {
+        memcpy(p_info->frame, p_frame_in, sizeof(p_info->frame));
+    }
+
+    if (p_error_bytes_in != NULL) {
+        if (error_length_in > DEBUG_CRASH_LOG_MAX_ERROR_BYTES) {
+            error_length_in = DEBUG_CRASH_LOG_MAX_ERROR_BYTES;
+        }
+        memcpy(p_info->error_bytes, p_error_bytes_in, error_length_in);
+        p_info->error_length = error_length_in;
+    }
+
+    p_info->crc = Debug_crash_log_info_crc(p_info);
+
+    /* Logs since the last boot may not have been kept if the log wasn't
+     * started, but the reason is still worth keeping */
+    DEBUG_CRASH_LOG.magic = DEBUG_CRASH_LOG_MAGIC;
+}
+
+uint32_t Debug_crash_log_replay(void) {
+    Debug_CrashLogRecord *p_record;
+    Debug_CrashLogRecord *p_newest = NULL;
+    uint16_t seq;
+    uint32_t num_sent = 0;
+    #ifndef DEBUG_TOKENIZED
+    char line[DEBUG_CRASH_LOG_RECORD_LENGTH + 32];
+    int line_length;
+    #endif
+
+    /* Find the newest valid record, the ones before it are in the slots
+     * before its own */
+    for (size_t i = 0; i < DEBUG_CRASH_LOG_NUM_RECORDS; ++i) {
+        p_record = &DEBUG_CRASH_LOG.records[i];
+
+        if (p_record->crc != Debug_crash_log_record_crc(p_record)
+            ||
+            p_record->seq % DEBUG_CRASH_LOG_NUM_RECORDS != i
+            ||
+            p_record->length > DEBUG_CRASH_LOG_RECORD_LENGTH
+        ) {
+            continue;
+        }
+
+        if (p_newest == NULL
+            ||
+            (int16_t)(uint16_t)(p_record->seq - p_newest->seq) > 0
+        ) {
+            p_newest = p_record;
+        }
+    }
+
+    if (p_newest == NULL) {
+        return 0;
+    }
+
+    for (size_t i = DEBUG_CRASH_LOG_NUM_RECORDS; i > 0; --i) {
+        seq = (uint16_t)(p_newest->seq - (i - 1));
+        p_record = &DEBUG_CRASH_LOG.records[
+            seq % DEBUG_CRASH_LOG_NUM_RECORDS
+        ];
+
+        if (p_record->seq != seq
+            ||
+            p_record->crc != Debug_crash_log_record_crc(p_record)
+        ) {
+            continue;
+        }
+
+        /* Tokenized records are sent as they were, and can be decoded as
+         * they were stored with the full time */
+        #ifdef DEBUG_TOKENIZED
+        Debug_write(p_record->bytes, p_record->length);
+        #else
+        line_length = snprintf(
+            line,
+            sizeof(line),
+            "[%10lu crash] %.*s" DEBUG_CRASH_LOG_NEWLINE,
+            (unsigned long)p_record->time_ms,
+            (int)p_record->length,
+            (const char *)p_record->bytes
+        );
+        if (line_length > 0) {
+            Debug_write((const uint8_t *)line, strlen(line));
+        }
+        #endif
+
+        num_sent++;
+    }
+
+    return num_sent;
+}
+
+bool Debug_crash_log_recover(void) {
+    Debug_CrashInfo *p_info = &DEBUG_CRASH_LOG.info;
+    bool recovered = false;
+    uint32_t num_records;
+    char error_str[(3 * DEBUG_CRASH_LOG_MAX_ERROR_BYTES) + 1] = {0};
+
+    /* Don't keep the logs made while recovering */
+    DEBUG_CRASH_LOG_STARTED = false;
+
+    DP.DEBUG_CRASH_REASON = DEBUG_CRASH_REASON_NONE;
+    DP.DEBUG_CRASH_CODE = 0;
+    DP.DEBUG_CRASH_ERROR_LENGTH = 0;
+    memset(DP.DEBUG_CRASH_FRAME, 0, sizeof(DP.DEBUG_CRASH_FRAME));
+    memset(
+        DP.DEBUG_CRASH_ERROR_BYTES,
+        0,
+        sizeof(DP.DEBUG_CRASH_ERROR_BYTES)
+    );
+
+    /* After a power on the RAM is random, so nothing in it is trusted */
+    if (DEBUG_CRASH_LOG.magic == DEBUG_CRASH_LOG_MAGIC) {
+        num_records = Debug_crash_log_replay();
+        if (num_records > 0) {
+            DEBUG_WRN(
+                "Recovered %lu logs from before the reset",
+                (unsigned long)num_records
+            );
+        }
+
+        if (p_info->crc == Debug_crash_log_info_crc(p_info)
+            &&
+            p_info->reason != DEBUG_CRASH_REASON_NONE
+            &&
+            p_info->error_length <= DEBUG_CRASH_LOG_MAX_ERROR_BYTES
+        ) {
+            DP.DEBUG_CRASH_REASON = (uint8_t)p_info->reason;
+            DP.DEBUG_CRASH_CODE = p_info->code;
+            memcpy(
+                DP.DEBUG_CRASH_FRAME,
+                p_info->frame,
+                sizeof(DP.DEBUG_CRASH_FRAME)
+            );
+            DP.DEBUG_CRASH_ERROR_LENGTH = (uint8_t)p_info->error_length;
+            memcpy(
+                DP.DEBUG_CRASH_ERROR_BYTES,
+                p_info->error_bytes,
+                p_info->error_length
+            );
+            recovered = true;
+
+            Debug_hex_string(
+                DP.DEBUG_CRASH_ERROR_BYTES,
+                error_str,
+                DP.DEBUG_CRASH_ERROR_LENGTH
+            );
+            DEBUG_ERR(
+                "Reset by crash reason %u, code %ld, errors [%s]",
+                (unsigned int)DP.DEBUG_CRASH_REASON,
+                (long)DP.DEBUG_CRASH_CODE,
+                error_str
+            );
+
+            if (DP.DEBUG_CRASH_REASON == DEBUG_CRASH_REASON_FAULT) {
+                DEBUG_ERR(
+                    "Fault at pc 0x%08lX, lr 0x%08lX, xpsr 0x%08lX",
+                    (unsigned long)DP.DEBUG_CRASH_FRAME[6],
+                    (unsigned long)DP.DEBUG_CRASH_FRAME[5],
+                    (unsigned long)DP.DEBUG_CRASH_FRAME[7]
+                );
+            }
+        }
+    }
+
+    /* Start a new log, with no reason until the next crash */
+    memset(&DEBUG_CRASH_LOG, 0, sizeof(DEBUG_CRASH_LOG));
+    DEBUG_CRASH_LOG.magic = DEBUG_CRASH_LOG_MAGIC;
+    DEBUG_CRASH_LOG_NEXT_SEQ = 0;
+    DEBUG_CRASH_LOG_STARTED = true;
+
+    return recovered;
+}
@@ -29,16 +29,57 @@
 /* External includes */
 #ifdef TARGET_TM4C
 #include "inc/hw_memmap.h"
+#include "inc/hw_nvic.h"
+#include "inc/hw_types.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
 #endif
 
 /* Internal includes */
 #include "system/data_pool/DataPool_public.h"
 #include "drivers/rtc/Rtc_public.h"
 #include "util/debug/Debug_public.h"
+#ifdef TARGET_UNIX
+#include "drivers/virtual_time/VirtualTime_public.h"
+#endif
+
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Most bytes a tokenized argument other than a string can take, which
+ * is a 64 bit varint.
+ */
+#define DEBUG_TOKENIZED_MAX_ARG_LENGTH (10)
+
+/**
+ * @brief Highest Debug_Level sent from modules which aren't in
+ * DP.DEBUG_VERBOSE_MODULES or DP.DEBUG_QUIET_MODULES, set by the
+ * UOS3_LOG_RUNTIME_LEVEL CMake option.
+ */
+#ifndef DEBUG_RUNTIME_LEVEL
+#define DEBUG_RUNTIME_LEVEL (DEBUG_LEVEL_TRACE)
+#endif
+
+/**
+ * @brief Mask to wrap an index into the debug TX ring.
+ */
+#define DEBUG_TX_RING_MASK (DEBUG_TX_RING_SIZE - 1)
+
+#ifdef TARGET_TM4C
+/**
+ * @brief The UART used for debug output.
+ */
+#ifdef TARGET_TM4C_LAUNCHPAD
+#define DEBUG_UART_BASE (UART1_BASE)
+#elif TARGET_TM4C_TOBC
+#define DEBUG_UART_BASE (UART6_BASE)
+#endif
+#endif
 
 /* -------------------------------------------------------------------------   
  * GLOBALS
@@ -48,6 +89,46 @@
 static struct timespec DEBUG_INIT_TIME;
 #endif
 
+/**
+ * @brief Debug TX ring, holding bytes waiting to be sent.
+ */
+static uint8_t DEBUG_TX_RING[DEBUG_TX_RING_SIZE];
+
+/**
+ * @brief Index in DEBUG_TX_RING of the next byte to be appended, only written
+ * by Debug_tx_push().
+ */
+static volatile uint16_t DEBUG_TX_HEAD;
+
+/**
+ * @brief Index in DEBUG_TX_RING of the next byte to be sent, only written by
+ * Debug_tx_pop().
+ */
+static volatile uint16_t DEBUG_TX_TAIL;
+
+/**
+ * @brief Call sites tracked by the rate limiter.
+ */
+static Debug_RateLimitSite DEBUG_RATE_LIMIT_SITES[DEBUG_RATE_LIMIT_NUM_SITES];
+
+/**
+ * @brief Number of calls to the rate limiter, which orders the sites by when
+ * they last logged.
+ */
+static uint32_t DEBUG_RATE_LIMIT_USE_COUNT;
+
+#ifdef DEBUG_TOKENIZED
+/**
+ * @brief Time of the last tokenized record in ms.
+ */
+static uint32_t DEBUG_TOKENIZED_LAST_TIMESTAMP;
+
+/**
+ * @brief Number of tokenized records since the last one with the full time.
+ */
+static uint32_t DEBUG_TOKENIZED_NUM_DELTAS = DEBUG_TOKENIZED_ABSOLUTE_PERIOD;
+#endif
+
 /* -------------------------------------------------------------------------   
  * CONSTANTS
  * ------------------------------------------------------------------------- */
@@ -66,15 +147,95 @@ static const char *Debug_level_colours[] = {
    "\x1b[31m", "\x1b[33m", "", "\x1b[36m", "\x1b[35m",
 };
 
+#ifdef DEBUG_TOKENIZED
+/**
+ * @brief Token string of the summary sent before a log from a call site
+ * which has had logs suppressed by the rate limiter.
+ */
+static const char DEBUG_RATE_LIMIT_TOKEN[]
+    __attribute__((section("uos3_log_tokens"), used, aligned(1)))
+    =
+    "1\x1f" __FILE__ "\x1f" _DEBUG_STR(__LINE__) "\x1f"
+    "Suppressed %u repeats of the next log";
+#endif
+
+/* -------------------------------------------------------------------------   
+ * FUNCTION PROTOTYPES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Write an unsigned varint, 7 bits per byte with the top bit set on
+ * all but the last byte.
+ * 
+ * @param p_out Buffer to write to, which must have 10 bytes free.
+ * @param value_in The value to write.
+ * @return size_t The number of bytes written.
+ */
+size_t Debug_encode_varint(uint8_t *p_out, uint64_t value_in);
+
+/**
+ * @brief Get the time logs are stamped with in ms, which is the time since
+ * Debug_init() on unix, or the RTC time on the TM4C, or 0 if the RTC isn't
+ * initialised.
+ * 
+ * @return uint32_t The time in ms.
+ */
+uint32_t Debug_get_time_ms(void);
+
+#ifdef DEBUG_TOKENIZED
+/**
+ * @brief Encode a tokenized record and send it to the debug output.
+ * 
+ * @param token_in The token of the log.
+ * @param timestamp_in The time of the log in ms.
+ * @param arg_types_in The number and type of the arguments.
+ * @param p_args_in The arguments.
+ */
+void Debug_send_tokenized(
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    uint32_t arg_types_in,
+    va_list *p_args_in
+);
+
+/**
+ * @brief Variadic form of Debug_send_tokenized().
+ */
+void Debug_send_tokenized_args(
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    uint32_t arg_types_in,
+    ...
+);
+#endif
+
+#ifdef TARGET_TM4C
+/**
+ * @brief Move bytes from the debug TX ring into the UART TX FIFO until one is
+ * full or the other empty, leaving the TX interrupt enabled only if there are
+ * bytes left.
+ */
+void Debug_tx_fill(void);
+
+/**
+ * @brief Debug UART interrupt handler, which refills the TX FIFO.
+ */
+void Debug_tx_int_handler(void);
+#endif
+
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
 
 bool Debug_init(void) {
 
+    /* Forget all rate limited call sites */
+    memset(DEBUG_RATE_LIMIT_SITES, 0, sizeof(DEBUG_RATE_LIMIT_SITES));
+    DEBUG_RATE_LIMIT_USE_COUNT = 0;
+
     /* If on UNIX set the init time */
     #ifdef TARGET_UNIX
-    if (clock_gettime(CLOCK_MONOTONIC_RAW, &DEBUG_INIT_TIME) != 0) {
+    if (VirtualTime_clock_gettime(CLOCK_MONOTONIC_RAW, &DEBUG_INIT_TIME) != 0) {
         return false;
     }
     #endif
@@ -139,6 +300,12 @@ bool Debug_init(void) {
         (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE)
     );
 
+    /* Interrupt when the TX FIFO drops to 2/8 full, which is 4 bytes, so that
+     * it can be refilled from the ring before it runs dry */
+    UARTFIFOLevelSet(DEBUG_UART_BASE, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
+    UARTTxIntModeSet(DEBUG_UART_BASE, UART_TXINT_MODE_FIFO);
+    UARTIntRegister(DEBUG_UART_BASE, Debug_tx_int_handler);
+
     /* Turn the LED on to show the device is ready */
     #ifdef TARGET_TM4C_LAUNCHPAD
     GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_2, GPIO_PIN_2);
@@ -147,65 +314,118 @@ bool Debug_init(void) {
     #endif
     #endif
 
+    /* Report the crash log from before the reset, now there's somewhere to
+     * send it */
+    Debug_crash_log_recover();
+
+    /* Recovered tokenized records leave the decoder at a time from before the
+     * reset, so the next record has the full time */
+    #ifdef DEBUG_TOKENIZED
+    DEBUG_TOKENIZED_NUM_DELTAS = DEBUG_TOKENIZED_ABSOLUTE_PERIOD;
+    #endif
+
     return true;
 }
 
 #ifdef TARGET_UNIX
 void Debug_log_unix(
+    uint8_t module,
     uint8_t level, 
     const char *p_file, 
     uint32_t line, 
     const char *p_fmt, 
     ...
 ) {
-    va_list args;
-    va_start(args, p_fmt);
+    uint32_t time_ms;
+    uint32_t num_suppressed;
+
+    if (!Debug_is_enabled(module, level)) {
+        return;
+    }
 
     /* Calculate time since init */
-    struct timespec now;
-    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
-    int64_t delta_ms = 
-        (now.tv_sec - DEBUG_INIT_TIME.tv_sec) * 1000
-        + (now.tv_nsec - DEBUG_INIT_TIME.tv_nsec) / 1000000;
+    time_ms = Debug_get_time_ms();
+
+    if (!Debug_rate_limit((uintptr_t)p_fmt, time_ms, &num_suppressed)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, p_fmt);
 
     /* Remove the file path up to src/ */
     char *p_file_stripped = strstr(p_file, "src");
 
-    /* Print the prefix */
+    if (num_suppressed > 0) {
+        printf(
+            "[%10lu %s%s\x1b[0m] %s:%d "
+            "Suppressed %lu repeats of the next log\n",
+            (unsigned long)time_ms,
+            Debug_level_colours[DEBUG_LEVEL_WARNING],
+            Debug_level_names[DEBUG_LEVEL_WARNING],
+            p_file_stripped + 4,
+            line,
+            (unsigned long)num_suppressed
+        );
+    }
+
+    /* Put the file, line and message into a string, which is also kept in
+     * the crash log */
+    char str[512] = {0};
+    size_t length;
+
+    snprintf(str, sizeof(str), "%s:%d ", p_file_stripped + 4, line);
+    length = strlen(str);
+    vsnprintf(&str[0] + length, sizeof(str) - length, p_fmt, args);
+    va_end(args);
+
     printf(
-        "[%10lu %s%s\x1b[0m] %s:%d ",
-        delta_ms,
+        "[%10lu %s%s\x1b[0m] %s\n",
+        (unsigned long)time_ms,
         Debug_level_colours[level], 
         Debug_level_names[level],
-        p_file_stripped + 4,
-        line
+        str
     );
 
-    /* Print the message */
-    vprintf(p_fmt, args);
-
-    /* Print newline */
-    printf("\n");
+    length = strlen(str);
+    Debug_crash_log_add(
+        time_ms,
+        (const uint8_t *)str,
+        length < DEBUG_CRASH_LOG_RECORD_LENGTH
+            ? length : DEBUG_CRASH_LOG_RECORD_LENGTH
+    );
 }
 #endif
 
 #ifdef TARGET_TM4C
 void Debug_log_tm4c(
+    uint8_t module,
     uint8_t level, 
     const char *p_file, 
     uint32_t line, 
     const char *p_fmt, 
     ...
 ) {
+    uint32_t time_ms;
+    uint32_t num_suppressed;
+
+    if (!Debug_is_enabled(module, level)) {
+        return;
+    }
+
+    time_ms = Debug_get_time_ms();
+
+    if (!Debug_rate_limit((uintptr_t)p_fmt, time_ms, &num_suppressed)) {
+        return;
+    }
 
     va_list args;
     va_start(args, p_fmt);
-    Rtc_Timestamp timestamp;
 
     /* String to print into */
     char str[512] = {0};
-
-    /* TODO: Get the time from the RTC */
+    char *p_text;
+    size_t text_length;
 
     /* Remove the file path up to src/ */
     char *p_file_stripped = strstr(p_file, "src");
@@ -213,56 +433,549 @@ void Debug_log_tm4c(
     /* Put the the prefix into the string. If the RTC isn't init yet put dashes
      * out, if it is put the ms value out instead */
     if (!DP.RTC_INITIALISED) {
-        sprintf(
-            str,
-            "[---------- %s%s\x1b[0m] %s:%ld ",
-            Debug_level_colours[level], 
-            Debug_level_names[level],
-            p_file_stripped + 4,
-            line
-        );
+        sprintf(str, "[----------");
     }
     else {
-        timestamp = Rtc_get_timestamp();
+        sprintf(str, "[%10lu", (unsigned long)time_ms);
+    }
 
+    if (num_suppressed > 0) {
         sprintf(
-            str,
-            "[%10llu %s%s\x1b[0m] %s:%ld ",
-            Rtc_timestamp_to_ms(&timestamp),
-            Debug_level_colours[level], 
-            Debug_level_names[level],
+            &str[0] + strlen(str),
+            " %s%s\x1b[0m] %s:%ld "
+            "Suppressed %lu repeats of the next log\r\n",
+            Debug_level_colours[DEBUG_LEVEL_WARNING],
+            Debug_level_names[DEBUG_LEVEL_WARNING],
             p_file_stripped + 4,
-            line
+            line,
+            (unsigned long)num_suppressed
         );
+        Debug_tx_push((const uint8_t *)str, strlen(str));
+
+        /* Keep the time, which is the first 11 characters, for the log
+         * itself */
+        str[11] = '\0';
     }
 
+    sprintf(
+        &str[0] + strlen(str),
+        " %s%s\x1b[0m] ",
+        Debug_level_colours[level], 
+        Debug_level_names[level]
+    );
+
+    /* The file, line and message are kept in the crash log */
+    p_text = &str[0] + strlen(str);
+    sprintf(p_text, "%s:%ld ", p_file_stripped + 4, line);
+
     /* Add the message */
     vsprintf(&str[0] + strlen(str), p_fmt, args);
+    va_end(args);
+
+    text_length = strlen(p_text);
+    Debug_crash_log_add(
+        time_ms,
+        (const uint8_t *)p_text,
+        text_length < DEBUG_CRASH_LOG_RECORD_LENGTH
+            ? text_length : DEBUG_CRASH_LOG_RECORD_LENGTH
+    );
 
     /* Add the carriage return/newline */
     sprintf(&str[0] + strlen(str), "\r\n");
 
-    /* Iterate over the string and print the characters to the UART */
-    for (size_t i = 0; i < strlen(str); ++i) {
-        UARTCharPut(
-            #ifdef TARGET_TM4C_LAUNCHPAD
-            UART1_BASE, 
-            #elif TARGET_TM4C_TOBC
-            UART6_BASE,
-            #endif
-            str[i]
+    /* Queue the string to be sent by the TX interrupt */
+    Debug_tx_push((const uint8_t *)str, strlen(str));
+}
+#endif
+
+#ifdef DEBUG_TOKENIZED
+void Debug_log_tokenized(
+    uint8_t module,
+    uint8_t level,
+    uint32_t token,
+    uint32_t arg_types,
+    ...
+) {
+    va_list args;
+    uint32_t timestamp;
+    uint32_t num_suppressed;
+
+    if (!Debug_is_enabled(module, level)) {
+        return;
+    }
+
+    timestamp = Debug_get_time_ms();
+
+    /* Tokens start at 0, which isn't a valid site */
+    if (!Debug_rate_limit((uintptr_t)token + 1, timestamp, &num_suppressed)) {
+        return;
+    }
+
+    if (num_suppressed > 0) {
+        Debug_send_tokenized_args(
+            (uint32_t)((uintptr_t)DEBUG_RATE_LIMIT_TOKEN
+                - (uintptr_t)__start_uos3_log_tokens),
+            timestamp,
+            1U | (DEBUG_ARG_INT32 << 4),
+            num_suppressed
+        );
+    }
+
+    va_start(args, arg_types);
+    Debug_send_tokenized(token, timestamp, arg_types, &args);
+    va_end(args);
+}
+
+void Debug_send_tokenized_args(
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    uint32_t arg_types_in,
+    ...
+) {
+    va_list args;
+
+    va_start(args, arg_types_in);
+    Debug_send_tokenized(token_in, timestamp_in, arg_types_in, &args);
+    va_end(args);
+}
+
+void Debug_send_tokenized(
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    uint32_t arg_types_in,
+    va_list *p_args_in
+) {
+    uint8_t record[DEBUG_TOKENIZED_MAX_RECORD_LENGTH];
+    uint32_t timestamp = timestamp_in;
+    bool delta;
+    size_t length;
+    va_list crash_args;
+
+    va_copy(crash_args, *p_args_in);
+
+    /* Send the time since the last record unless it's time for the full time,
+     * or time has gone backwards */
+    delta = DEBUG_TOKENIZED_NUM_DELTAS < DEBUG_TOKENIZED_ABSOLUTE_PERIOD
+        && timestamp >= DEBUG_TOKENIZED_LAST_TIMESTAMP;
+
+    length = Debug_encode_tokenized(
+        record,
+        token_in,
+        delta ? timestamp - DEBUG_TOKENIZED_LAST_TIMESTAMP : timestamp,
+        delta,
+        arg_types_in,
+        p_args_in
+    );
+
+    DEBUG_TOKENIZED_LAST_TIMESTAMP = timestamp;
+    DEBUG_TOKENIZED_NUM_DELTAS = delta ? DEBUG_TOKENIZED_NUM_DELTAS + 1 : 0;
+
+    Debug_write(record, length);
+
+    /* The crash log may not keep the record before this one, so it keeps
+     * records with the full time */
+    if (delta) {
+        length = Debug_encode_tokenized(
+            record,
+            token_in,
+            timestamp,
+            false,
+            arg_types_in,
+            &crash_args
         );
     }
+    va_end(crash_args);
+
+    Debug_crash_log_add(timestamp, record, length);
+}
+#endif
+
+bool Debug_is_enabled(uint8_t module_in, uint8_t level_in) {
+    uint32_t word;
+    uint32_t bit;
+
+    /* Errors are always sent */
+    if (level_in == DEBUG_LEVEL_ERROR) {
+        return true;
+    }
+
+    /*
+     * ---- NUMERICAL PROTECTION ----
+     * Unknown modules are treated as other modules rather than indexing past
+     * the end of the masks.
+     */
+    if (module_in >= DEBUG_NUM_MODULES) {
+        module_in = DEBUG_MODULE_OTHER;
+    }
+
+    word = (uint32_t)module_in / 32;
+    bit = (uint32_t)1 << (module_in % 32);
+
+    if ((DP.DEBUG_VERBOSE_MODULES[word] & bit) != 0) {
+        return true;
+    }
+    if ((DP.DEBUG_QUIET_MODULES[word] & bit) != 0) {
+        return false;
+    }
+
+    return level_in <= DEBUG_RUNTIME_LEVEL;
+}
+
+uint32_t Debug_get_time_ms(void) {
+    #ifdef TARGET_UNIX
+    struct timespec now;
+    VirtualTime_clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return (uint32_t)(
+        (now.tv_sec - DEBUG_INIT_TIME.tv_sec) * 1000
+        + (now.tv_nsec - DEBUG_INIT_TIME.tv_nsec) / 1000000
+    );
+    #endif
+    #ifdef TARGET_TM4C
+    Rtc_Timestamp timestamp;
+    if (!DP.RTC_INITIALISED) {
+        return 0;
+    }
+    timestamp = Rtc_get_timestamp();
+    return (uint32_t)Rtc_timestamp_to_ms(&timestamp);
+    #endif
+}
+
+bool Debug_rate_limit(
+    uintptr_t site_in,
+    uint32_t time_ms_in,
+    uint32_t *p_num_suppressed_out
+) {
+    Debug_RateLimitSite *p_site = NULL;
+    Debug_RateLimitSite *p_oldest = &DEBUG_RATE_LIMIT_SITES[0];
+    bool send = true;
+
+    /* Logs may come from interrupts, so only one may update the table at
+     * once */
+    #ifdef TARGET_TM4C
+    bool int_disabled = IntMasterDisable();
+    #endif
+
+    *p_num_suppressed_out = 0;
+
+    /* ---- NUMERICAL PROTECTION ----
+     * The count wraps, but the unsigned differences below still order the
+     * sites as long as the table is used fewer than 2^32 times between logs
+     * from a site. */
+    DEBUG_RATE_LIMIT_USE_COUNT++;
+
+    /* Find the site, or the one which has gone longest without a log */
+    for (size_t i = 0; i < DEBUG_RATE_LIMIT_NUM_SITES; ++i) {
+        if (DEBUG_RATE_LIMIT_SITES[i].site == site_in) {
+            p_site = &DEBUG_RATE_LIMIT_SITES[i];
+            break;
+        }
+
+        if (DEBUG_RATE_LIMIT_SITES[i].site == 0) {
+            p_oldest = &DEBUG_RATE_LIMIT_SITES[i];
+        }
+        else if (p_oldest->site != 0
+            &&
+            (uint32_t)(DEBUG_RATE_LIMIT_USE_COUNT
+                - DEBUG_RATE_LIMIT_SITES[i].last_use)
+            > (uint32_t)(DEBUG_RATE_LIMIT_USE_COUNT - p_oldest->last_use)
+        ) {
+            p_oldest = &DEBUG_RATE_LIMIT_SITES[i];
+        }
+    }
+
+    if (p_site == NULL) {
+        p_site = p_oldest;
+        p_site->site = site_in;
+        p_site->period_start_ms = time_ms_in;
+        p_site->num_sent = 0;
+        p_site->num_suppressed = 0;
+    }
+
+    p_site->last_use = DEBUG_RATE_LIMIT_USE_COUNT;
+
+    if ((uint32_t)(time_ms_in - p_site->period_start_ms)
+        >= DEBUG_RATE_LIMIT_PERIOD_MS
+    ) {
+        /* Start a new period. If logs were suppressed in the last one the
+         * site is still repeating, so only this log and the summary are sent
+         * in this period too. */
+        p_site->period_start_ms = time_ms_in;
+        *p_num_suppressed_out = p_site->num_suppressed;
+        p_site->num_sent = p_site->num_suppressed > 0
+            ? DEBUG_RATE_LIMIT_BURST : 1;
+        p_site->num_suppressed = 0;
+    }
+    else if (p_site->num_sent < DEBUG_RATE_LIMIT_BURST) {
+        p_site->num_sent++;
+    }
+    else {
+        /*
+         * ---- NUMERICAL PROTECTION ----
+         * The suppressed counts saturate rather than wrapping to 0.
+         */
+        if (p_site->num_suppressed != UINT32_MAX) {
+            p_site->num_suppressed++;
+        }
+        if (DP.DEBUG_NUM_SUPPRESSED_LOGS != UINT32_MAX) {
+            DP.DEBUG_NUM_SUPPRESSED_LOGS++;
+        }
+        send = false;
+    }
+
+    #ifdef TARGET_TM4C
+    if (!int_disabled) {
+        IntMasterEnable();
+    }
+    #endif
+
+    return send;
+}
+
+size_t Debug_encode_varint(uint8_t *p_out, uint64_t value_in) {
+    size_t length = 0;
+
+    while (value_in >= 0x80) {
+        p_out[length++] = (uint8_t)(value_in | 0x80);
+        value_in >>= 7;
+    }
+    p_out[length++] = (uint8_t)value_in;
+
+    return length;
+}
+
+size_t Debug_encode_tokenized(
+    uint8_t *p_record_out,
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    bool delta_in,
+    uint32_t arg_types_in,
+    va_list *p_args_in
+) {
+    uint8_t *p_payload = &p_record_out[2];
+    uint32_t num_args = arg_types_in & 0xFU;
+    size_t length = 0;
+    size_t available;
+    uint32_t type;
+    int64_t value;
+    double real;
+    uint64_t real_bits;
+    const char *p_string;
+    size_t string_length;
+    uint8_t checksum = 0;
+
+    length += Debug_encode_varint(&p_payload[length], token_in);
+    length += Debug_encode_varint(
+        &p_payload[length],
+        ((uint64_t)timestamp_in << 1) | (delta_in ? 0U : 1U)
+    );
+
+    if (num_args > DEBUG_TOKENIZED_MAX_ARGS) {
+        num_args = DEBUG_TOKENIZED_MAX_ARGS;
+    }
+
+    for (uint32_t i = 0; i < num_args; ++i) {
+        type = (arg_types_in >> (4 + (2 * i))) & 0x3U;
+
+        if (type == DEBUG_ARG_INT32 || type == DEBUG_ARG_INT64) {
+            if (type == DEBUG_ARG_INT32) {
+                value = va_arg(*p_args_in, int);
+            }
+            else {
+                value = va_arg(*p_args_in, int64_t);
+            }
+
+            /* Zigzag encode so that small negative values stay short */
+            length += Debug_encode_varint(
+                &p_payload[length],
+                ((uint64_t)value << 1) ^ (uint64_t)(value >> 63)
+            );
+        }
+        else if (type == DEBUG_ARG_DOUBLE) {
+            real = va_arg(*p_args_in, double);
+            memcpy(&real_bits, &real, sizeof(real_bits));
+            for (size_t j = 0; j < sizeof(real_bits); ++j) {
+                p_payload[length++] = (uint8_t)(real_bits >> (8 * j));
+            }
+        }
+        else {
+            p_string = va_arg(*p_args_in, const char *);
+
+            /* Leave room for the length byte and every later argument */
+            available = DEBUG_TOKENIZED_MAX_PAYLOAD_LENGTH - length - 1
+                - (DEBUG_TOKENIZED_MAX_ARG_LENGTH * (num_args - i - 1));
+            if (available > UINT8_MAX) {
+                available = UINT8_MAX;
+            }
+
+            string_length = 0;
+            while (p_string != NULL
+                &&
+                string_length < available
+                &&
+                p_string[string_length] != '\0'
+            ) {
+                string_length++;
+            }
+
+            p_payload[length++] = (uint8_t)string_length;
+            if (string_length > 0) {
+                memcpy(&p_payload[length], p_string, string_length);
+                length += string_length;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+        checksum = (uint8_t)(checksum + p_payload[i]);
+    }
+
+    p_record_out[0] = DEBUG_TOKENIZED_SYNC;
+    p_record_out[1] = (uint8_t)length;
+    p_payload[length] = checksum;
+
+    return length + 3;
+}
+
+void Debug_write(const uint8_t *p_bytes_in, size_t length_in) {
+    #ifdef TARGET_UNIX
+    fwrite(p_bytes_in, 1, length_in, stdout);
+    #endif
+    #ifdef TARGET_TM4C
+    Debug_tx_push(p_bytes_in, length_in);
+    #endif
+}
+
+bool Debug_tx_push(const uint8_t *p_bytes_in, size_t length_in) {
+    uint16_t head;
+    uint16_t used;
+    bool pushed = false;
+
+    /* Only one log may be appended at once, and the TX interrupt mustn't start
+     * in between filling the FIFO and enabling the interrupt */
+    #ifdef TARGET_TM4C
+    bool int_disabled = IntMasterDisable();
+    #endif
+
+    head = DEBUG_TX_HEAD;
+    used = (uint16_t)((head - DEBUG_TX_TAIL) & DEBUG_TX_RING_MASK);
+
+    /*
+     * ---- NUMERICAL PROTECTION ----
+     * The dropped count saturates rather than wrapping to 0.
+     */
+    if (length_in > (size_t)(DEBUG_TX_RING_MASK - used)) {
+        if (DP.DEBUG_NUM_DROPPED_LOGS != UINT32_MAX) {
+            DP.DEBUG_NUM_DROPPED_LOGS++;
+        }
+    }
+    else {
+        for (size_t i = 0; i < length_in; ++i) {
+            DEBUG_TX_RING[head] = p_bytes_in[i];
+            head = (uint16_t)((head + 1) & DEBUG_TX_RING_MASK);
+        }
+        DEBUG_TX_HEAD = head;
+
+        used = (uint16_t)(used + length_in);
+        if (used > DP.DEBUG_TX_PEAK_BYTES) {
+            DP.DEBUG_TX_PEAK_BYTES = used;
+        }
+
+        pushed = true;
+    }
+
+    #ifdef TARGET_TM4C
+    Debug_tx_fill();
+    if (!int_disabled) {
+        IntMasterEnable();
+    }
+    #endif
+
+    return pushed;
+}
+
+bool Debug_tx_pop(uint8_t *p_byte_out) {
+    uint16_t tail = DEBUG_TX_TAIL;
+
+    if (tail == DEBUG_TX_HEAD) {
+        return false;
+    }
+
+    *p_byte_out = DEBUG_TX_RING[tail];
+    DEBUG_TX_TAIL = (uint16_t)((tail + 1) & DEBUG_TX_RING_MASK);
+
+    return true;
+}
+
+#ifdef TARGET_TM4C
+void Debug_tx_fill(void) {
+    uint8_t byte;
+
+    /* Check for space first so no byte is taken that can't be sent */
+    while (UARTSpaceAvail(DEBUG_UART_BASE) && Debug_tx_pop(&byte)) {
+        UARTCharPutNonBlocking(DEBUG_UART_BASE, byte);
+    }
+
+    /* The interrupt only fires when the FIFO level drops, so it's only needed
+     * while there's more to send */
+    if (DEBUG_TX_TAIL == DEBUG_TX_HEAD) {
+        UARTIntDisable(DEBUG_UART_BASE, UART_INT_TX);
+    }
+    else {
+        UARTIntEnable(DEBUG_UART_BASE, UART_INT_TX);
+    }
+}
+
+void Debug_tx_int_handler(void) {
+    UARTIntClear(DEBUG_UART_BASE, UARTIntStatus(DEBUG_UART_BASE, true));
+    Debug_tx_fill();
 }
 #endif
 
+void Debug_flush(void) {
+    #ifdef TARGET_UNIX
+    fflush(stdout);
+    #endif
+    #ifdef TARGET_TM4C
+    uint8_t byte;
+    bool int_disabled = IntMasterDisable();
+
+    UARTIntDisable(DEBUG_UART_BASE, UART_INT_TX);
+    while (Debug_tx_pop(&byte)) {
+        UARTCharPut(DEBUG_UART_BASE, byte);
+    }
+
+    if (!int_disabled) {
+        IntMasterEnable();
+    }
+    #endif
+}
+
 void Debug_exit(int error_code) {
+    Debug_crash_log_save(
+        DEBUG_CRASH_REASON_EXIT,
+        (int32_t)error_code,
+        NULL,
+        NULL,
+        0
+    );
+    Debug_flush();
+
     #ifdef TARGET_UNIX
     exit(error_code);
     #endif
     #ifdef TARGET_TM4C
     (void) error_code;
-    __asm("BKPT");
+
+    /* Stop if a debugger is attached. Without one a breakpoint escalates to a
+     * hard fault, whose handler would replace the exit reason and code in the
+     * crash log, so reset instead in the same way as the handler does. */
+    if (HWREG(NVIC_DBG_CTRL) & NVIC_DBG_CTRL_C_DEBUGEN) {
+        __asm("BKPT");
+    }
+
+    HWREG(NVIC_APINT) = NVIC_APINT_VECTKEY | NVIC_APINT_SYSRESETREQ;
+    while (1) {
+    }
     #endif
 }
 
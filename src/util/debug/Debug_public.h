@@ -7,6 +7,68 @@
  * 
  * Task ref: [UT_2.12.1]
  * 
+ * Each module only has logs up to its own level compiled in, which is set by
+ * the UOS3_LOG_LEVEL and UOS3_LOG_LEVEL_<MODULE> CMake options, see
+ * debug_log_levels.cmake. Of those logs, only the ones up to
+ * DEBUG_RUNTIME_LEVEL (set by UOS3_LOG_RUNTIME_LEVEL) are sent, unless the
+ * module's bit is set in DP.DEBUG_VERBOSE_MODULES, which sends all of them,
+ * or in DP.DEBUG_QUIET_MODULES, which sends only errors. These masks can be
+ * changed in a running system to look at one module more closely without
+ * rebuilding.
+ * 
+ * On the TM4C logs are appended to a ring buffer which is drained into the
+ * debug UART by its TX interrupt, so that logging never waits for the UART.
+ * If the ring doesn't have space for a whole log the log is dropped and
+ * counted in DP.DEBUG_NUM_DROPPED_LOGS.
+ * 
+ * Logs which repeat quickly, such as an error from a step function while a
+ * fault persists, are rate limited per call site. The first
+ * DEBUG_RATE_LIMIT_BURST logs from a site in each DEBUG_RATE_LIMIT_PERIOD_MS
+ * are sent and the rest are counted, and once the period is over the next log
+ * from the site is sent after a summary of how many were suppressed. Only the
+ * DEBUG_RATE_LIMIT_NUM_SITES most recent sites are tracked, so a site which
+ * hasn't logged for a while may be forgotten along with its count.
+ * 
+ * The last DEBUG_CRASH_LOG_NUM_RECORDS logs, and the reason for the last
+ * reset, are kept in a crash log in RAM which isn't cleared by a reset (the
+ * .noinit section on the TM4C). A hard fault stores its stacked register
+ * frame, Kernel_reboot_with_error() the error chain, and Debug_exit() its
+ * exit code. Each record and the reset information have their own CRC, so
+ * that only what was fully written is trusted, and the whole log is ignored
+ * after a power on when the RAM holds random values. Debug_init() recovers
+ * the log from before the reset into the DP.DEBUG_CRASH_* parameters and
+ * sends it to the debug output, then starts a new log. Nothing is written to
+ * EEPROM when a crash is stored, so storing it can't fail in the ways a
+ * crashed system might.
+ * 
+ * If DEBUG_TOKENIZED is defined (by the UOS3_TOKENIZED_LOG CMake option) logs
+ * aren't formatted into text on the target. Instead the level, file, line and
+ * format string of each log are placed in the uos3_log_tokens section at
+ * build time, and a log sends a record of the offset of its string in that
+ * section (the token), the time, and the raw arguments. Records are turned
+ * back into text on the host by src/tools/tool_detokenize.py, using the
+ * section read from the ELF. On the TM4C the section isn't loaded, so the
+ * strings don't take any flash either.
+ * 
+ * A record is framed as:
+ *  - DEBUG_TOKENIZED_SYNC,
+ *  - the length of the payload,
+ *  - the payload, which is the token, the timestamp and each argument,
+ *  - and the 8 bit sum of the payload.
+ * 
+ * The timestamp is the time in ms shifted left by one with the lowest bit
+ * set, or the time since the previous record shifted left by one, which
+ * usually fits in a single byte. The full time is sent every
+ * DEBUG_TOKENIZED_ABSOLUTE_PERIOD records so the decoder can recover from
+ * lost records.
+ * 
+ * The token and timestamp are varints, other integers in the payload are
+ * zigzag encoded varints, doubles are 8 bytes
+ * little endian, and strings are a length byte followed by the characters,
+ * truncated to fit in the record. The format string of every log must be a
+ * string literal and a log can have at most DEBUG_TOKENIZED_MAX_ARGS
+ * arguments.
+ * 
  * @version 0.1
  * @date 2020-11-01
  * 
@@ -27,6 +89,131 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdarg.h>
+
+/* -------------------------------------------------------------------------   
+ * DEFINES
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Number of module numbers, which are module IDs shifted down by
+ * KERNEL_MOD_ID_SHIFT.
+ */
+#define DEBUG_NUM_MODULES (64)
+
+/**
+ * @brief Number of words in the DP.DEBUG_*_MODULES masks, which have one bit
+ * per module number.
+ */
+#define DEBUG_MODULE_MASK_WORDS (DEBUG_NUM_MODULES / 32)
+
+/**
+ * @brief Module number used for files which aren't part of a module, which
+ * isn't assigned to any module.
+ */
+#define DEBUG_MODULE_OTHER (0x3F)
+
+/**
+ * @brief Module number of the file being compiled, set for each module by
+ * debug_log_levels.cmake.
+ */
+#ifndef DEBUG_MODULE
+#define DEBUG_MODULE (DEBUG_MODULE_OTHER)
+#endif
+
+/**
+ * @brief Highest Debug_Level of log compiled into the file being compiled,
+ * set for each module by debug_log_levels.cmake.
+ */
+#ifndef DEBUG_MODULE_LEVEL
+#define DEBUG_MODULE_LEVEL (4)
+#endif
+
+/**
+ * @brief Size of the debug TX ring in bytes, which must be a power of 2. One
+ * byte is always left empty, so at most DEBUG_TX_RING_SIZE - 1 bytes can be
+ * waiting to be sent.
+ */
+#define DEBUG_TX_RING_SIZE (1024)
+
+/**
+ * @brief Number of call sites tracked by the rate limiter.
+ */
+#define DEBUG_RATE_LIMIT_NUM_SITES (16)
+
+/**
+ * @brief Number of logs sent from a call site in each rate limit period
+ * before the rest are suppressed.
+ */
+#define DEBUG_RATE_LIMIT_BURST (3)
+
+/**
+ * @brief Length of each rate limit period in ms.
+ */
+#define DEBUG_RATE_LIMIT_PERIOD_MS (5000)
+
+/**
+ * @brief Number of logs kept in the crash log.
+ */
+#define DEBUG_CRASH_LOG_NUM_RECORDS (8)
+
+/**
+ * @brief Most bytes of a log kept in the crash log, which is the text after
+ * the level, or the whole record of a tokenized log. Longer text is
+ * truncated, and longer tokenized records aren't kept.
+ */
+#define DEBUG_CRASH_LOG_RECORD_LENGTH (55)
+
+/**
+ * @brief Most bytes of the error chain kept in the crash log.
+ */
+#define DEBUG_CRASH_LOG_MAX_ERROR_BYTES (16)
+
+/**
+ * @brief Number of words in a Debug_ContextStateFrame.
+ */
+#define DEBUG_CONTEXT_STATE_FRAME_WORDS (8)
+
+/**
+ * @brief First byte of every tokenized record.
+ */
+#define DEBUG_TOKENIZED_SYNC (0xA5)
+
+/**
+ * @brief Maximum length of the payload of a tokenized record.
+ */
+#define DEBUG_TOKENIZED_MAX_PAYLOAD_LENGTH (255)
+
+/**
+ * @brief Maximum length of a tokenized record, which is the payload plus the
+ * sync, length and checksum bytes.
+ */
+#define DEBUG_TOKENIZED_MAX_RECORD_LENGTH \
+    (DEBUG_TOKENIZED_MAX_PAYLOAD_LENGTH + 3)
+
+/**
+ * @brief Number of tokenized records between each one with the full time
+ * rather than the time since the last record.
+ */
+#define DEBUG_TOKENIZED_ABSOLUTE_PERIOD (64)
+
+/**
+ * @brief Maximum number of arguments of a tokenized log.
+ */
+#define DEBUG_TOKENIZED_MAX_ARGS (8)
+
+/**
+ * @brief Types of the arguments of a tokenized log, as found by
+ * _DEBUG_ARG_TYPE().
+ * 
+ * The argument types word passed to Debug_encode_tokenized() holds the number
+ * of arguments in the lowest 4 bits, then the type of each argument in 2 bits,
+ * first argument first.
+ */
+#define DEBUG_ARG_INT32 (0U)
+#define DEBUG_ARG_INT64 (1U)
+#define DEBUG_ARG_DOUBLE (2U)
+#define DEBUG_ARG_STRING (3U)
 
 /* -------------------------------------------------------------------------   
  * STRUCTS
@@ -50,6 +237,128 @@ typedef struct __attribute__((packed)) _Debug_ContextStateFrame {
   uint32_t xpsr;
 } Debug_ContextStateFrame;
 
+/**
+ * @brief A log kept in the crash log.
+ */
+typedef struct _Debug_CrashLogRecord {
+    /**
+     * @brief Time of the log in ms.
+     */
+    uint32_t time_ms;
+
+    /**
+     * @brief Sequence number of the log, which decides the slot it is in.
+     */
+    uint16_t seq;
+
+    /**
+     * @brief CRC16 of the record with this field set to 0.
+     */
+    uint16_t crc;
+
+    /**
+     * @brief Number of bytes used in bytes.
+     */
+    uint8_t length;
+
+    /**
+     * @brief Text or tokenized record of the log.
+     */
+    uint8_t bytes[DEBUG_CRASH_LOG_RECORD_LENGTH];
+} Debug_CrashLogRecord;
+
+/**
+ * @brief Information about the reason for a reset, stored just before it.
+ */
+typedef struct _Debug_CrashInfo {
+    /**
+     * @brief The Debug_CrashReason.
+     */
+    uint32_t reason;
+
+    /**
+     * @brief Exit code given to Debug_exit().
+     */
+    int32_t code;
+
+    /**
+     * @brief Stacked register frame of a hard fault, as a
+     * Debug_ContextStateFrame.
+     */
+    uint32_t frame[DEBUG_CONTEXT_STATE_FRAME_WORDS];
+
+    /**
+     * @brief Number of bytes used in error_bytes.
+     */
+    uint32_t error_length;
+
+    /**
+     * @brief Error chain from Kernel_error_to_bytes(), truncated to fit.
+     */
+    uint8_t error_bytes[DEBUG_CRASH_LOG_MAX_ERROR_BYTES];
+
+    /**
+     * @brief CRC32 of all the fields above.
+     */
+    uint32_t crc;
+} Debug_CrashInfo;
+
+/**
+ * @brief The crash log, which is kept over resets.
+ */
+typedef struct _Debug_CrashLog {
+    /**
+     * @brief DEBUG_CRASH_LOG_MAGIC if the log was started by this firmware
+     * and the RAM has been kept since.
+     */
+    uint32_t magic;
+
+    /**
+     * @brief Reason for the reset, if the CRC is valid.
+     */
+    Debug_CrashInfo info;
+
+    /**
+     * @brief The last logs, each in slot seq % DEBUG_CRASH_LOG_NUM_RECORDS.
+     */
+    Debug_CrashLogRecord records[DEBUG_CRASH_LOG_NUM_RECORDS];
+} Debug_CrashLog;
+
+/**
+ * @brief State of a call site tracked by the rate limiter.
+ */
+typedef struct _Debug_RateLimitSite {
+    /**
+     * @brief Identifies the call site, which is the address of the format
+     * string, or the token of a tokenized log. 0 if the entry is unused.
+     */
+    uintptr_t site;
+
+    /**
+     * @brief Time the current period started in ms.
+     */
+    uint32_t period_start_ms;
+
+    /**
+     * @brief Value of the rate limiter's use count at the last log from the
+     * site, used to choose which site to forget when the table is full.
+     * 
+     * A count is used rather than the time so that sites which logged in the
+     * same ms are still told apart.
+     */
+    uint32_t last_use;
+
+    /**
+     * @brief Number of logs sent from the site in the current period.
+     */
+    uint16_t num_sent;
+
+    /**
+     * @brief Number of logs suppressed since the last one sent.
+     */
+    uint32_t num_suppressed;
+} Debug_RateLimitSite;
+
 
 /* -------------------------------------------------------------------------   
  * ENUMS
@@ -66,6 +375,16 @@ typedef enum _Debug_Level {
     DEBUG_LEVEL_TRACE = 4
 } Debug_Level;
 
+/**
+ * @brief Reason stored in the crash log before a reset.
+ */
+typedef enum _Debug_CrashReason {
+    DEBUG_CRASH_REASON_NONE = 0,
+    DEBUG_CRASH_REASON_FAULT = 1,
+    DEBUG_CRASH_REASON_REBOOT = 2,
+    DEBUG_CRASH_REASON_EXIT = 3
+} Debug_CrashReason;
+
 /* -------------------------------------------------------------------------   
  * FUNCTIONS
  * ------------------------------------------------------------------------- */
@@ -85,6 +404,7 @@ bool Debug_init(void);
  * NOTE: Use the provided debug macros (DEBUG_INF for example) rather than this
  * function. 
  * 
+ * @param module The module number of the log
  * @param level The level to log the information at
  * @param p_file The file the log occurs on
  * @param line The line numbe of the log
@@ -92,6 +412,7 @@ bool Debug_init(void);
  * @param ... The variadic formats for p_fmt.
  */
 void Debug_log_unix(
+    uint8_t module,
     uint8_t level, 
     const char *p_file, 
     uint32_t line, 
@@ -111,6 +432,7 @@ void Debug_log_unix(
  * NOTE: Use the provided debug macros (DEBUG_INF for example) rather than this
  * function. 
  * 
+ * @param module The module number of the log
  * @param level The level to log the information at
  * @param p_file The file the log occurs on
  * @param line The line numbe of the log
@@ -118,6 +440,7 @@ void Debug_log_unix(
  * @param ... The variadic formats for p_fmt.
  */
 void Debug_log_tm4c(
+    uint8_t module,
     uint8_t level, 
     const char *p_file, 
     uint32_t line, 
@@ -126,11 +449,181 @@ void Debug_log_tm4c(
 );
 #endif
 
+#ifdef DEBUG_TOKENIZED
+/**
+ * @brief Log a tokenized record to the debug output, which is stdout on unix
+ * and the debug UART on the TM4C.
+ * 
+ * NOTE: Use the provided debug macros (DEBUG_INF for example) rather than this
+ * function.
+ * 
+ * @param module The module number of the log
+ * @param level The level to log the information at
+ * @param token The offset of the log's string in the uos3_log_tokens section
+ * @param arg_types The number and type of the arguments
+ * @param ... The arguments of the log's format string.
+ */
+void Debug_log_tokenized(
+    uint8_t module,
+    uint8_t level,
+    uint32_t token,
+    uint32_t arg_types,
+    ...
+);
+
+/**
+ * @brief Start of the section of tokenized log strings, defined by the
+ * linker.
+ */
+extern const char __start_uos3_log_tokens[];
+#endif
+
+/**
+ * @brief Check whether logs of a level from a module should be sent.
+ * 
+ * @param module_in The module number.
+ * @param level_in The Debug_Level of the log.
+ * @return bool True if the log should be sent.
+ */
+bool Debug_is_enabled(uint8_t module_in, uint8_t level_in);
+
+/**
+ * @brief Check whether a log from a call site is within the rate limit, and
+ * record it.
+ * 
+ * @param site_in Identifies the call site, must not be 0.
+ * @param time_ms_in The current time in ms.
+ * @param p_num_suppressed_out The number of logs suppressed from the site
+ * since the last one sent, which should be reported along with this log if
+ * it is sent.
+ * @return bool True if the log should be sent, false if suppressed.
+ */
+bool Debug_rate_limit(
+    uintptr_t site_in,
+    uint32_t time_ms_in,
+    uint32_t *p_num_suppressed_out
+);
+
+/**
+ * @brief Encode a tokenized record.
+ * 
+ * Strings are truncated so that the record always fits.
+ * 
+ * @param p_record_out Buffer of at least DEBUG_TOKENIZED_MAX_RECORD_LENGTH
+ * bytes to write the record to.
+ * @param token_in The token of the log.
+ * @param timestamp_in The time of the log in ms, or the time since the last
+ * log if delta_in is set.
+ * @param delta_in Whether timestamp_in is the time since the last log.
+ * @param arg_types_in The number and type of the arguments.
+ * @param p_args_in The arguments.
+ * @return size_t The length of the record in bytes.
+ */
+size_t Debug_encode_tokenized(
+    uint8_t *p_record_out,
+    uint32_t token_in,
+    uint32_t timestamp_in,
+    bool delta_in,
+    uint32_t arg_types_in,
+    va_list *p_args_in
+);
+
+/**
+ * @brief Write bytes to the debug output, which is stdout on unix and the
+ * debug TX ring on the TM4C, without any level or rate limit.
+ * 
+ * @param p_bytes_in The bytes to write.
+ * @param length_in The number of bytes.
+ */
+void Debug_write(const uint8_t *p_bytes_in, size_t length_in);
+
+/**
+ * @brief Keep a log in the crash log, replacing the oldest one.
+ * 
+ * Does nothing until the crash log from before the reset has been recovered
+ * by Debug_crash_log_recover(). May be called from interrupts.
+ * 
+ * @param time_ms_in Time of the log in ms.
+ * @param p_bytes_in The text or tokenized record of the log.
+ * @param length_in The number of bytes, which if more than
+ * DEBUG_CRASH_LOG_RECORD_LENGTH means the log isn't kept.
+ */
+void Debug_crash_log_add(
+    uint32_t time_ms_in,
+    const uint8_t *p_bytes_in,
+    size_t length_in
+);
+
+/**
+ * @brief Store the reason for a reset which is about to happen in the crash
+ * log.
+ * 
+ * Safe to call from the hard fault handler, as it only writes to RAM.
+ * 
+ * @param reason_in The Debug_CrashReason.
+ * @param code_in The exit code, or 0.
+ * @param p_frame_in The stacked register frame of a fault, or NULL.
+ * @param p_error_bytes_in The error chain from Kernel_error_to_bytes(), or
+ * NULL.
+ * @param error_length_in The number of bytes in the error chain.
+ */
+void Debug_crash_log_save(
+    Debug_CrashReason reason_in,
+    int32_t code_in,
+    const Debug_ContextStateFrame *p_frame_in,
+    const uint8_t *p_error_bytes_in,
+    uint8_t error_length_in
+);
+
+/**
+ * @brief Recover the crash log from before the last reset, then start a new
+ * one.
+ * 
+ * The reason for the reset is put in the DP.DEBUG_CRASH_* parameters, and
+ * it and the recovered logs are sent to the debug output. Called by
+ * Debug_init().
+ * 
+ * @return bool True if a reason for the reset was recovered.
+ */
+bool Debug_crash_log_recover(void);
+
+/**
+ * @brief Append the bytes of a log to the debug TX ring.
+ * 
+ * If there isn't space for all of the bytes none are appended, and
+ * DP.DEBUG_NUM_DROPPED_LOGS is incremented. May be called from interrupts.
+ * 
+ * @param p_bytes_in The bytes to append.
+ * @param length_in The number of bytes.
+ * @return bool True if appended, false if dropped.
+ */
+bool Debug_tx_push(const uint8_t *p_bytes_in, size_t length_in);
+
+/**
+ * @brief Take the oldest byte from the debug TX ring.
+ * 
+ * Only one caller may take bytes at once, which on the TM4C is the debug UART
+ * TX interrupt or Debug_flush().
+ * 
+ * @param p_byte_out The byte.
+ * @return bool True if a byte was taken, false if the ring is empty.
+ */
+bool Debug_tx_pop(uint8_t *p_byte_out);
+
+/**
+ * @brief Write out all pending logs, waiting for them to be sent.
+ * 
+ * Used before stopping, for instance in Debug_exit() or a fault handler, when
+ * the TX interrupt won't get to run.
+ */
+void Debug_flush(void);
+
 /**
  * @brief Exit execution.
  * 
- * Under Unix this will call `exit()`, however under the TM4C this will put a 
- * breakpoint.
+ * The exit code is stored in the crash log first. Under Unix this will call
+ * `exit()`, however under the TM4C this will put a breakpoint if a debugger
+ * is attached, and otherwise reset the system.
  * 
  * @param error_code The code to exit with.
  */
@@ -152,9 +645,99 @@ void Debug_hex_string(uint8_t *p_bytes_in, char *p_str_out, size_t length_in);
  * MACROS
  * ------------------------------------------------------------------------- */
 
-#ifdef DEBUG_MODE
+#ifdef DEBUG_TOKENIZED
+/**
+ * @brief Convert the value of a macro into a string literal.
+ */
+#define _DEBUG_STR(x) _DEBUG_STR_(x)
+#define _DEBUG_STR_(x) #x
+
+/**
+ * @brief Get the first argument, which is the format string.
+ */
+#define _DEBUG_FIRST(...) _DEBUG_FIRST_(__VA_ARGS__, _)
+#define _DEBUG_FIRST_(first, ...) first
+
+/**
+ * @brief Count the arguments, including the format string.
+ */
+#define _DEBUG_NUM_ARGS(...) _DEBUG_NUM_ARGS_(\
+    __VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, _)
+#define _DEBUG_NUM_ARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, n, ...) n
+
+#define _DEBUG_CAT(a, b) _DEBUG_CAT_(a, b)
+#define _DEBUG_CAT_(a, b) a##b
+
+/**
+ * @brief Get the DEBUG_ARG_* type of an argument at compile time, without
+ * evaluating it.
+ */
+#define _DEBUG_ARG_TYPE(arg) (__extension__ _Generic((arg),\
+    char *: DEBUG_ARG_STRING,\
+    const char *: DEBUG_ARG_STRING,\
+    float: DEBUG_ARG_DOUBLE,\
+    double: DEBUG_ARG_DOUBLE,\
+    default: (sizeof(arg) > 4 ? DEBUG_ARG_INT64 : DEBUG_ARG_INT32)\
+))
+
+/**
+ * @brief Replace the format string with the argument types word, keeping the
+ * arguments.
+ */
+#define _DEBUG_ARGS(...) _DEBUG_CAT(\
+    _DEBUG_ARGS_, _DEBUG_NUM_ARGS(__VA_ARGS__))(__VA_ARGS__)
+#define _DEBUG_T(arg, i) (_DEBUG_ARG_TYPE(arg) << (4 + (2 * (i))))
+#define _DEBUG_ARGS_1(f) 0U
+#define _DEBUG_ARGS_2(f, a) 1U | _DEBUG_T(a, 0), a
+#define _DEBUG_ARGS_3(f, a, b) 2U | _DEBUG_T(a, 0) | _DEBUG_T(b, 1), a, b
+#define _DEBUG_ARGS_4(f, a, b, c) 3U | _DEBUG_T(a, 0) | _DEBUG_T(b, 1)\
+    | _DEBUG_T(c, 2), a, b, c
+#define _DEBUG_ARGS_5(f, a, b, c, d) 4U | _DEBUG_T(a, 0) | _DEBUG_T(b, 1)\
+    | _DEBUG_T(c, 2) | _DEBUG_T(d, 3), a, b, c, d
+#define _DEBUG_ARGS_6(f, a, b, c, d, e) 5U | _DEBUG_T(a, 0) | _DEBUG_T(b, 1)\
+    | _DEBUG_T(c, 2) | _DEBUG_T(d, 3) | _DEBUG_T(e, 4), a, b, c, d, e
+#define _DEBUG_ARGS_7(f, a, b, c, d, e, g) 6U | _DEBUG_T(a, 0)\
+    | _DEBUG_T(b, 1) | _DEBUG_T(c, 2) | _DEBUG_T(d, 3) | _DEBUG_T(e, 4)\
+    | _DEBUG_T(g, 5), a, b, c, d, e, g
+#define _DEBUG_ARGS_8(f, a, b, c, d, e, g, h) 7U | _DEBUG_T(a, 0)\
+    | _DEBUG_T(b, 1) | _DEBUG_T(c, 2) | _DEBUG_T(d, 3) | _DEBUG_T(e, 4)\
+    | _DEBUG_T(g, 5) | _DEBUG_T(h, 6), a, b, c, d, e, g, h
+#define _DEBUG_ARGS_9(f, a, b, c, d, e, g, h, k) 8U | _DEBUG_T(a, 0)\
+    | _DEBUG_T(b, 1) | _DEBUG_T(c, 2) | _DEBUG_T(d, 3) | _DEBUG_T(e, 4)\
+    | _DEBUG_T(g, 5) | _DEBUG_T(h, 6) | _DEBUG_T(k, 7), a, b, c, d, e, g, h, k
+#endif
+
+#if defined(DEBUG_MODE) && defined(DEBUG_TOKENIZED)
+/**
+ * @brief Level of each Debug_Level in token strings, kept to one character as
+ * the strings decide the size of the tokens.
+ */
+#define _DEBUG_TOKEN_LEVEL_DEBUG_LEVEL_ERROR "0"
+#define _DEBUG_TOKEN_LEVEL_DEBUG_LEVEL_WARNING "1"
+#define _DEBUG_TOKEN_LEVEL_DEBUG_LEVEL_INFO "2"
+#define _DEBUG_TOKEN_LEVEL_DEBUG_LEVEL_DEBUG "3"
+#define _DEBUG_TOKEN_LEVEL_DEBUG_LEVEL_TRACE "4"
+
+/* The string is "level\x1ffile\x1fline\x1fformat", and its offset in the
+ * section is the token */
+#define _DEBUG_LOG(level, file, line, ...) do {\
+    static const char DEBUG_TOKEN[]\
+        __attribute__((section("uos3_log_tokens"), used, aligned(1)))\
+        =\
+        _DEBUG_CAT(_DEBUG_TOKEN_LEVEL_, level) "\x1f" file "\x1f"\
+        _DEBUG_STR(line) "\x1f"\
+        _DEBUG_FIRST(__VA_ARGS__);\
+    Debug_log_tokenized(\
+        DEBUG_MODULE,\
+        level,\
+        (uint32_t)((uintptr_t)DEBUG_TOKEN\
+            - (uintptr_t)__start_uos3_log_tokens),\
+        _DEBUG_ARGS(__VA_ARGS__));\
+} while (0)
+#elif defined(DEBUG_MODE)
 #ifdef TARGET_TM4C
 #define _DEBUG_LOG(level, file, line, ...) Debug_log_tm4c(\
+    DEBUG_MODULE,\
     level,\
     file,\
     line,\
@@ -162,6 +745,7 @@ void Debug_hex_string(uint8_t *p_bytes_in, char *p_str_out, size_t length_in);
 #endif
 #ifdef TARGET_UNIX
 #define _DEBUG_LOG(level, file, line, ...) Debug_log_unix(\
+    DEBUG_MODULE,\
     level,\
     file,\
     line,\
@@ -174,53 +758,73 @@ void Debug_hex_string(uint8_t *p_bytes_in, char *p_str_out, size_t length_in);
 /**
  * @brief Print an error message to the Debug system.
  */
+#if DEBUG_MODULE_LEVEL >= 0
 #define DEBUG_ERR(...) _DEBUG_LOG(\
     DEBUG_LEVEL_ERROR,\
     __FILE__,\
     __LINE__,\
     __VA_ARGS__\
 )
+#else
+#define DEBUG_ERR(...)
+#endif
 
 /**
  * @brief Print an info message to the Debug system.
  */
+#if DEBUG_MODULE_LEVEL >= 1
 #define DEBUG_WRN(...) _DEBUG_LOG(\
     DEBUG_LEVEL_WARNING,\
     __FILE__,\
     __LINE__,\
     __VA_ARGS__\
 )
+#else
+#define DEBUG_WRN(...)
+#endif
 
 /**
  * @brief Print an info message to the Debug system.
  */
+#if DEBUG_MODULE_LEVEL >= 2
 #define DEBUG_INF(...) _DEBUG_LOG(\
     DEBUG_LEVEL_INFO,\
     __FILE__,\
     __LINE__,\
     __VA_ARGS__\
 )
+#else
+#define DEBUG_INF(...)
+#endif
 
 /**
  * @brief Print a debug message to the Debug system.
  */
+#if DEBUG_MODULE_LEVEL >= 3
 #define DEBUG_DBG(...) _DEBUG_LOG(\
     DEBUG_LEVEL_DEBUG,\
     __FILE__,\
     __LINE__,\
     __VA_ARGS__\
 )
+#else
+#define DEBUG_DBG(...)
+#endif
 
 
 /**
  * @brief Print a trace message to the Debug system.
  */
+#if DEBUG_MODULE_LEVEL >= 4
 #define DEBUG_TRC(...) _DEBUG_LOG(\
     DEBUG_LEVEL_TRACE,\
     __FILE__,\
     __LINE__,\
     __VA_ARGS__\
 )
+#else
+#define DEBUG_TRC(...)
+#endif
 
 
 #endif /* H_DEBUG_PUBLIC_H */
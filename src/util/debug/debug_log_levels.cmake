@@ -0,0 +1,81 @@
+# Compile time log levels for each module, see Debug_public.h.
+#
+# Every target whose name matches a module in Kernel_module_ids.h (ignoring
+# case, so I2c matches MOD_ID_I2C) is compiled with DEBUG_MODULE set to its
+# module number and DEBUG_MODULE_LEVEL set to the highest level of log to
+# compile in. Other targets use DEBUG_MODULE_OTHER. The level of every module
+# is UOS3_LOG_LEVEL unless UOS3_LOG_LEVEL_<MODULE> is set, for instance:
+# ```
+# cmake -DUOS3_LOG_LEVEL=INFO -DUOS3_LOG_LEVEL_I2C=TRACE ..
+# ```
+# Levels are NONE, ERROR, WARNING, INFO, DEBUG or TRACE.
+
+set(UOS3_LOG_LEVEL "TRACE" CACHE STRING
+    "Highest level of debug log compiled into each module")
+set(UOS3_LOG_RUNTIME_LEVEL "TRACE" CACHE STRING
+    "Highest level of debug log sent unless changed in the DataPool")
+
+# Names of the levels, in the order of Debug_Level after NONE
+set(UOS3_LOG_LEVEL_NAMES NONE ERROR WARNING INFO DEBUG TRACE)
+
+# Convert a level name into the value of its Debug_Level, or -1 for NONE
+function(uos3_log_level_value name out)
+    string(TOUPPER "${name}" name_upper)
+    list(FIND UOS3_LOG_LEVEL_NAMES "${name_upper}" index)
+    if(index EQUAL -1)
+        message(FATAL_ERROR "Unknown log level ${name}, must be one of "
+            "${UOS3_LOG_LEVEL_NAMES}")
+    endif()
+    math(EXPR value "${index} - 1")
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+# Set the module and level definitions on every target in dir and its
+# subdirectories, which must be called once all targets have been added
+function(uos3_set_log_levels dir)
+    # Read the module numbers, i.e. "#define MOD_ID_I2C ((uint16_t)(0x14<<"
+    file(STRINGS "${PROJECT_SOURCE_DIR}/src/system/kernel/Kernel_module_ids.h"
+        module_lines REGEX "^#define MOD_ID_[A-Z0-9_]+ "
+    )
+
+    get_property(targets DIRECTORY ${dir} PROPERTY BUILDSYSTEM_TARGETS)
+    foreach(target ${targets})
+        get_target_property(type ${target} TYPE)
+        if(NOT type MATCHES "^(STATIC_LIBRARY|OBJECT_LIBRARY|EXECUTABLE)$")
+            continue()
+        endif()
+
+        string(TOUPPER ${target} target_upper)
+
+        set(module "DEBUG_MODULE_OTHER")
+        foreach(line ${module_lines})
+            if(line MATCHES "^#define MOD_ID_${target_upper} \\(\\(uint16_t\\)\\((0x[0-9A-Fa-f]+)<<")
+                set(module ${CMAKE_MATCH_1})
+            endif()
+        endforeach()
+
+        if(DEFINED UOS3_LOG_LEVEL_${target_upper})
+            uos3_log_level_value(${UOS3_LOG_LEVEL_${target_upper}} level)
+        else()
+            uos3_log_level_value(${UOS3_LOG_LEVEL} level)
+        endif()
+
+        target_compile_definitions(${target} PRIVATE
+            DEBUG_MODULE=${module}
+            DEBUG_MODULE_LEVEL=${level}
+        )
+
+        # Only the Debug module uses the runtime level
+        if(target STREQUAL "Debug")
+            uos3_log_level_value(${UOS3_LOG_RUNTIME_LEVEL} level)
+            target_compile_definitions(Debug PRIVATE
+                DEBUG_RUNTIME_LEVEL=${level}
+            )
+        endif()
+    endforeach()
+
+    get_property(subdirs DIRECTORY ${dir} PROPERTY SUBDIRECTORIES)
+    foreach(subdir ${subdirs})
+        uos3_set_log_levels(${subdir})
+    endforeach()
+endfunction()
@@ -21,12 +21,43 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 /* External library includes */
 #include <cmocka.h>
 
 /* Internal includes */
 #include "util/debug/Debug_public.h"
+#include "system/data_pool/DataPool_public.h"
+
+/* -------------------------------------------------------------------------   
+ * FUNCTIONS
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Encode a tokenized record with token 5 at 3 ms from the given
+ * arguments.
+ */
+static size_t Debug_test_encode(
+    uint8_t *p_record_out,
+    uint32_t arg_types_in,
+    ...
+) {
+    va_list args;
+    size_t length;
+
+    va_start(args, arg_types_in);
+    length = Debug_encode_tokenized(
+        p_record_out, 5, 3, false, arg_types_in, &args
+    );
+    va_end(args);
+
+    return length;
+}
 
 /* -------------------------------------------------------------------------   
  * TESTS
@@ -47,6 +78,337 @@ static void Debug_test_all_log(void **state) {
     DEBUG_ERR("This is an error message");
 }
 
+/**
+ * @brief Test the encoding of tokenized records
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_encode_tokenized(void **state) {
+    (void) state;
+    uint8_t record[DEBUG_TOKENIZED_MAX_RECORD_LENGTH];
+    char long_string[300];
+    const uint8_t expected[] = {
+        DEBUG_TOKENIZED_SYNC, 8,
+        0x05, 0x07, 0x01, 0xD8, 0x04, 0x02, 'a', 'b',
+        0xAE
+    };
+
+    /* Token, full timestamp, -1 and 300 zigzag encoded, then the string */
+    assert_int_equal(
+        Debug_test_encode(
+            record,
+            3U | (DEBUG_ARG_INT32 << 4) | (DEBUG_ARG_INT32 << 6)
+                | (DEBUG_ARG_STRING << 8),
+            -1,
+            300,
+            "ab"
+        ),
+        sizeof(expected)
+    );
+    assert_memory_equal(record, expected, sizeof(expected));
+
+    /* Strings are truncated to fit in the record */
+    memset(long_string, 'x', sizeof(long_string) - 1);
+    long_string[sizeof(long_string) - 1] = '\0';
+    assert_int_equal(
+        Debug_test_encode(
+            record,
+            1U | (DEBUG_ARG_STRING << 4),
+            long_string
+        ),
+        DEBUG_TOKENIZED_MAX_RECORD_LENGTH
+    );
+    assert_int_equal(record[1], DEBUG_TOKENIZED_MAX_PAYLOAD_LENGTH);
+    assert_int_equal(record[4], DEBUG_TOKENIZED_MAX_PAYLOAD_LENGTH - 3);
+}
+
+/**
+ * @brief Test the debug TX ring keeps bytes in order and drops whole logs
+ * which don't fit
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_tx_ring(void **state) {
+    (void) state;
+    uint8_t bytes[DEBUG_TX_RING_SIZE];
+    uint8_t byte;
+    uint32_t num_dropped;
+    size_t num_popped;
+
+    /* Start with an empty ring */
+    while (Debug_tx_pop(&byte)) {
+    }
+
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        bytes[i] = (uint8_t)i;
+    }
+
+    /* Bytes come out in order, including across the end of the ring */
+    for (size_t n = 0; n < 3; ++n) {
+        assert_true(Debug_tx_push(bytes, 500));
+        for (size_t i = 0; i < 500; ++i) {
+            assert_true(Debug_tx_pop(&byte));
+            assert_int_equal(byte, bytes[i]);
+        }
+        assert_false(Debug_tx_pop(&byte));
+    }
+
+    /* A log which doesn't fit is dropped whole and counted */
+    num_dropped = DP.DEBUG_NUM_DROPPED_LOGS;
+    assert_true(Debug_tx_push(bytes, DEBUG_TX_RING_SIZE - 2));
+    assert_false(Debug_tx_push(bytes, 2));
+    assert_int_equal(DP.DEBUG_NUM_DROPPED_LOGS, num_dropped + 1);
+
+    /* But a smaller one still fits */
+    assert_true(Debug_tx_push(&bytes[7], 1));
+    assert_int_equal(DP.DEBUG_TX_PEAK_BYTES, DEBUG_TX_RING_SIZE - 1);
+
+    num_popped = 0;
+    while (Debug_tx_pop(&byte)) {
+        num_popped++;
+    }
+    assert_int_equal(num_popped, DEBUG_TX_RING_SIZE - 1);
+    assert_int_equal(byte, 7);
+}
+
+/**
+ * @brief Test the runtime masks enable and disable logs from one module
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_is_enabled(void **state) {
+    (void) state;
+    const uint8_t module = 0x14;
+    const uint32_t bit = (uint32_t)1 << (module % 32);
+
+    memset(DP.DEBUG_VERBOSE_MODULES, 0, sizeof(DP.DEBUG_VERBOSE_MODULES));
+    memset(DP.DEBUG_QUIET_MODULES, 0, sizeof(DP.DEBUG_QUIET_MODULES));
+
+    /* Quiet modules only send errors, other modules are unaffected */
+    DP.DEBUG_QUIET_MODULES[module / 32] = bit;
+    assert_true(Debug_is_enabled(module, DEBUG_LEVEL_ERROR));
+    assert_false(Debug_is_enabled(module, DEBUG_LEVEL_WARNING));
+    assert_int_equal(
+        Debug_is_enabled(module + 1, DEBUG_LEVEL_TRACE),
+        Debug_is_enabled(DEBUG_MODULE_OTHER, DEBUG_LEVEL_TRACE)
+    );
+
+    /* Verbose takes priority and sends everything */
+    DP.DEBUG_VERBOSE_MODULES[module / 32] = bit;
+    assert_true(Debug_is_enabled(module, DEBUG_LEVEL_TRACE));
+
+    /* Unknown module numbers are treated as other modules */
+    DP.DEBUG_QUIET_MODULES[DEBUG_MODULE_OTHER / 32] =
+        (uint32_t)1 << (DEBUG_MODULE_OTHER % 32);
+    assert_false(Debug_is_enabled(200, DEBUG_LEVEL_WARNING));
+
+    memset(DP.DEBUG_VERBOSE_MODULES, 0, sizeof(DP.DEBUG_VERBOSE_MODULES));
+    memset(DP.DEBUG_QUIET_MODULES, 0, sizeof(DP.DEBUG_QUIET_MODULES));
+}
+
+/**
+ * @brief Test the rate limiter sends the first logs from a call site, then
+ * summaries of the suppressed ones
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_rate_limit(void **state) {
+    (void) state;
+    const uintptr_t site = 0x1000;
+    uint32_t num_suppressed;
+    uint32_t num_suppressed_dp = DP.DEBUG_NUM_SUPPRESSED_LOGS;
+    uint32_t time_ms;
+
+    /* The first logs in a period are sent, the rest are counted */
+    for (size_t i = 0; i < DEBUG_RATE_LIMIT_BURST; ++i) {
+        assert_true(Debug_rate_limit(site, 10, &num_suppressed));
+        assert_int_equal(num_suppressed, 0);
+    }
+    assert_false(Debug_rate_limit(site, 20, &num_suppressed));
+    assert_false(Debug_rate_limit(site, 30, &num_suppressed));
+    assert_int_equal(DP.DEBUG_NUM_SUPPRESSED_LOGS, num_suppressed_dp + 2);
+
+    /* Other sites aren't affected */
+    assert_true(Debug_rate_limit(site + 1, 30, &num_suppressed));
+    assert_int_equal(num_suppressed, 0);
+
+    /* While the site keeps repeating one log and a summary are sent each
+     * period */
+    time_ms = 10 + DEBUG_RATE_LIMIT_PERIOD_MS;
+    assert_true(Debug_rate_limit(site, time_ms, &num_suppressed));
+    assert_int_equal(num_suppressed, 2);
+    assert_false(Debug_rate_limit(site, time_ms + 1, &num_suppressed));
+
+    time_ms += DEBUG_RATE_LIMIT_PERIOD_MS;
+    assert_true(Debug_rate_limit(site, time_ms, &num_suppressed));
+    assert_int_equal(num_suppressed, 1);
+
+    /* Once it has been quiet for a period it gets its full burst back */
+    time_ms += DEBUG_RATE_LIMIT_PERIOD_MS;
+    for (size_t i = 0; i < DEBUG_RATE_LIMIT_BURST; ++i) {
+        assert_true(Debug_rate_limit(site, time_ms, &num_suppressed));
+        assert_int_equal(num_suppressed, 0);
+    }
+    assert_false(Debug_rate_limit(site, time_ms, &num_suppressed));
+
+    /* When the table is full the site which logged longest ago is forgotten,
+     * which is the site with the suppressed log */
+    for (uintptr_t i = 0; i < DEBUG_RATE_LIMIT_NUM_SITES; ++i) {
+        assert_true(
+            Debug_rate_limit(site + 2 + i, time_ms + 1, &num_suppressed)
+        );
+    }
+    assert_true(Debug_rate_limit(site, time_ms + 2, &num_suppressed));
+    assert_int_equal(num_suppressed, 0);
+}
+
+/**
+ * @brief Test the least recently used site is forgotten when more sites than
+ * the table holds log in the same ms
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_rate_limit_same_time(void **state) {
+    (void) state;
+    const uintptr_t site = 0x1000;
+    const uint32_t time_ms = 10;
+    uint32_t num_suppressed;
+
+    /* Fill the table */
+    for (uintptr_t i = 0; i < DEBUG_RATE_LIMIT_NUM_SITES; ++i) {
+        assert_true(Debug_rate_limit(site + i, time_ms, &num_suppressed));
+    }
+
+    /* Two more sites repeating in the same ms each take the place of one of
+     * the first sites, rather than both taking the same place and forgetting
+     * each other */
+    for (size_t i = 0; i < DEBUG_RATE_LIMIT_BURST; ++i) {
+        assert_true(Debug_rate_limit(
+            site + DEBUG_RATE_LIMIT_NUM_SITES, time_ms, &num_suppressed
+        ));
+        assert_true(Debug_rate_limit(
+            site + DEBUG_RATE_LIMIT_NUM_SITES + 1, time_ms, &num_suppressed
+        ));
+    }
+    assert_false(Debug_rate_limit(
+        site + DEBUG_RATE_LIMIT_NUM_SITES, time_ms, &num_suppressed
+    ));
+    assert_false(Debug_rate_limit(
+        site + DEBUG_RATE_LIMIT_NUM_SITES + 1, time_ms, &num_suppressed
+    ));
+
+    /* The two sites forgotten were the first to log, the rest are still
+     * tracked */
+    for (uintptr_t i = 2; i < DEBUG_RATE_LIMIT_NUM_SITES; ++i) {
+        for (size_t j = 1; j < DEBUG_RATE_LIMIT_BURST; ++j) {
+            assert_true(Debug_rate_limit(site + i, time_ms, &num_suppressed));
+        }
+        assert_false(Debug_rate_limit(site + i, time_ms, &num_suppressed));
+    }
+}
+
+/**
+ * @brief Test the crash log keeps the reason for a reset
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_crash_log(void **state) {
+    (void) state;
+    const uint8_t error_bytes[] = {0x01, 0x20, 0x02, 0x30};
+    const uint8_t long_error_bytes[2 * DEBUG_CRASH_LOG_MAX_ERROR_BYTES] = {0};
+    Debug_ContextStateFrame frame = {0};
+
+    /* Recovering starts a new log, which has no reason yet */
+    Debug_crash_log_recover();
+    assert_false(Debug_crash_log_recover());
+    assert_int_equal(DP.DEBUG_CRASH_REASON, DEBUG_CRASH_REASON_NONE);
+
+    /* Logs made before the reset are kept without affecting the reason */
+    for (size_t i = 0; i < 2 * DEBUG_CRASH_LOG_NUM_RECORDS; ++i) {
+        DEBUG_INF("Crash log test %u", (unsigned int)i);
+    }
+
+    frame.lr = 0x1234;
+    frame.return_address = 0x5678;
+    Debug_crash_log_save(
+        DEBUG_CRASH_REASON_FAULT,
+        3,
+        &frame,
+        error_bytes,
+        sizeof(error_bytes)
+    );
+
+    assert_true(Debug_crash_log_recover());
+    assert_int_equal(DP.DEBUG_CRASH_REASON, DEBUG_CRASH_REASON_FAULT);
+    assert_int_equal(DP.DEBUG_CRASH_CODE, 3);
+    assert_int_equal(DP.DEBUG_CRASH_FRAME[5], 0x1234);
+    assert_int_equal(DP.DEBUG_CRASH_FRAME[6], 0x5678);
+    assert_int_equal(DP.DEBUG_CRASH_ERROR_LENGTH, sizeof(error_bytes));
+    assert_memory_equal(
+        DP.DEBUG_CRASH_ERROR_BYTES,
+        error_bytes,
+        sizeof(error_bytes)
+    );
+
+    /* Long error chains are truncated */
+    Debug_crash_log_save(
+        DEBUG_CRASH_REASON_REBOOT,
+        0,
+        NULL,
+        long_error_bytes,
+        sizeof(long_error_bytes)
+    );
+    assert_true(Debug_crash_log_recover());
+    assert_int_equal(
+        DP.DEBUG_CRASH_ERROR_LENGTH,
+        DEBUG_CRASH_LOG_MAX_ERROR_BYTES
+    );
+
+    /* The reason is only reported once */
+    assert_false(Debug_crash_log_recover());
+    assert_int_equal(DP.DEBUG_CRASH_REASON, DEBUG_CRASH_REASON_NONE);
+}
+
+/**
+ * @brief Exit handler for Debug_test_exit(), which checks the reason and code
+ * stored by Debug_exit() are still in the crash log when the process ends.
+ */
+static void Debug_test_exit_handler(void) {
+    bool is_ok = Debug_crash_log_recover()
+        &&
+        DP.DEBUG_CRASH_REASON == DEBUG_CRASH_REASON_EXIT
+        &&
+        DP.DEBUG_CRASH_CODE == 5;
+
+    _exit(is_ok ? 0 : 1);
+}
+
+/**
+ * @brief Test Debug_exit() keeps its reason and code in the crash log
+ * 
+ * @param state cmocka state.
+ */
+static void Debug_test_exit(void **state) {
+    (void) state;
+    pid_t pid;
+    int status;
+
+    /* Exit from a child process so that the test can carry on. Pending
+     * output is flushed first so the child doesn't write it out again. */
+    fflush(stdout);
+    pid = fork();
+    assert_true(pid >= 0);
+    if (pid == 0) {
+        atexit(Debug_test_exit_handler);
+        Debug_crash_log_recover();
+        Debug_exit(5);
+    }
+
+    assert_int_equal(waitpid(pid, &status, 0), pid);
+    assert_true(WIFEXITED(status));
+    assert_int_equal(WEXITSTATUS(status), 0);
+}
+
 /**
  * @brief Setup function for Debug tests, which inits the Debug module.
  * 
@@ -73,6 +435,31 @@ const struct CMUnitTest debug_tests[] = {
     cmocka_unit_test_setup(
         Debug_test_all_log,
         Debug_test_setup
+    ),
+    cmocka_unit_test(
+        Debug_test_encode_tokenized
+    ),
+    cmocka_unit_test(
+        Debug_test_tx_ring
+    ),
+    cmocka_unit_test(
+        Debug_test_is_enabled
+    ),
+    cmocka_unit_test_setup(
+        Debug_test_rate_limit,
+        Debug_test_setup
+    ),
+    cmocka_unit_test_setup(
+        Debug_test_rate_limit_same_time,
+        Debug_test_setup
+    ),
+    cmocka_unit_test_setup(
+        Debug_test_crash_log,
+        Debug_test_setup
+    ),
+    cmocka_unit_test_setup(
+        Debug_test_exit,
+        Debug_test_setup
     )
 };
 